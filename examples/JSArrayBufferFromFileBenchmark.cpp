@@ -0,0 +1,136 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/HAL.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+  using namespace HAL;
+
+  const std::uint64_t megabyte = 1024 * 1024;
+  const std::uint64_t gigabyte = 1024 * megabyte;
+
+  // The distance between the bytes that are written to the file and
+  // then read back from JavaScript.
+  const std::uint64_t marker_stride = 64 * megabyte;
+
+  std::uint8_t MarkerAt(std::uint64_t offset) {
+    return static_cast<std::uint8_t>(offset / marker_stride % 251 + 1);
+  }
+
+  // Return the peak resident set size of the process in megabytes, or
+  // 0 where it isn't available.
+  double PeakResidentMegabytes() {
+#ifdef _WIN32
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    // Bytes on macOS and iOS.
+    return static_cast<double>(usage.ru_maxrss) / megabyte;
+#else
+    // Kilobytes on Linux.
+    return static_cast<double>(usage.ru_maxrss) / 1024;
+#endif
+#endif
+  }
+
+  double MillisecondsSince(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+} // namespace {
+
+// Map a multi-GB sparse file into ArrayBuffers and read one byte every
+// 64 MB from JavaScript. The time to map and the peak resident set
+// size should stay small no matter how large the file is, since only
+// the touched pages are read.
+//
+// usage: JSArrayBufferFromFileBenchmark [file GB] [window GB] [path]
+//
+// The file is mapped in windows of window GB each, since older
+// JavaScriptCore releases limit the size of an ArrayBuffer.
+int main(int argc, char* argv[]) {
+  const std::uint64_t file_size   = (argc > 1 ? std::stoull(argv[1]) : 6) * gigabyte;
+  const std::uint64_t window_size = (argc > 2 ? std::stoull(argv[2]) : 1) * gigabyte;
+  const std::string   path        =  argc > 3 ? argv[3] : "JSArrayBufferFromFileBenchmark.bin";
+
+  // Seeking past the end makes a sparse file on file systems that
+  // support them, so the file takes almost no disk space.
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (std::uint64_t offset = 0; offset < file_size; offset += marker_stride) {
+      file.seekp(static_cast<std::streamoff>(offset));
+      file.put(static_cast<char>(MarkerAt(offset)));
+    }
+    file.seekp(static_cast<std::streamoff>(file_size - 1));
+    file.put(0);
+    if (!file) {
+      std::cerr << "Couldn't create " << path << std::endl;
+      return 1;
+    }
+  }
+
+  JSContextGroup js_context_group;
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject read_markers = static_cast<JSObject>(js_context.JSEvaluateScript(
+    "(function(buffer, stride) {"
+    "  var bytes = new Uint8Array(buffer), sum = 0;"
+    "  for (var i = 0; i < bytes.length; i += stride) sum += bytes[i];"
+    "  return sum;"
+    "})"));
+
+  const double resident_before = PeakResidentMegabytes();
+  double map_milliseconds  = 0;
+  double read_milliseconds = 0;
+  std::uint64_t expected_sum = 0;
+  std::uint64_t sum          = 0;
+
+  for (std::uint64_t offset = 0; offset < file_size; offset += window_size) {
+    const std::uint64_t length = std::min(window_size, file_size - offset);
+
+    auto start = std::chrono::steady_clock::now();
+    JSArrayBuffer window = js_context.CreateArrayBufferFromFile(path, offset, static_cast<std::size_t>(length));
+    map_milliseconds += MillisecondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    sum += static_cast<std::uint32_t>(read_markers.Call(js_context.get_global_object(), window, static_cast<double>(marker_stride)));
+    read_milliseconds += MillisecondsSince(start);
+
+    for (std::uint64_t marker = offset; marker < offset + length; marker += marker_stride) {
+      expected_sum += MarkerAt(marker);
+    }
+  }
+
+  std::remove(path.c_str());
+
+  std::cout << "Mapped " << file_size / gigabyte << " GB in windows of " << window_size / gigabyte << " GB" << std::endl;
+  std::cout << "CreateArrayBufferFromFile: " << map_milliseconds  << " ms in total" << std::endl;
+  std::cout << "Read one byte every 64 MB: " << read_milliseconds << " ms in total" << std::endl;
+  std::cout << "Peak resident set size: " << resident_before << " MB before, " << PeakResidentMegabytes() << " MB after" << std::endl;
+
+  if (sum != expected_sum) {
+    std::cerr << "Read the wrong bytes: sum " << sum << ", expected " << expected_sum << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "Widget.hpp"
+#include "OtherWidget.hpp"
+#include "ListWidget.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+  
+  using namespace HAL;
+  
+  // Evaluate a script that performs iteration_count operations and
+  // report how many operations per second were achieved.
+  void Benchmark(const JSContext& js_context, const std::string& name, const std::string& body, std::uint32_t iteration_count) {
+    std::ostringstream os;
+    os << "for (var i = 0; i < " << iteration_count << "; ++i) { " << body << " }";
+    const std::string script = os.str();
+    
+    const auto start = std::chrono::steady_clock::now();
+    js_context.JSEvaluateScript(script);
+    const auto stop  = std::chrono::steady_clock::now();
+    
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cout << name << ": " << iteration_count << " iterations in " << seconds << " s ("
+              << static_cast<std::uint64_t>(iteration_count / seconds) << " per second)" << std::endl;
+  }
+  
+  // An exported class with a constant installed on its prototype,
+  // to compare with reading a cached constant through a callback.
+  class PrototypeConstantWidget : public JSExportObject, public JSExport<PrototypeConstantWidget> {
+    
+  public:
+    
+    PrototypeConstantWidget(const JSContext& js_context) HAL_NOEXCEPT
+    : JSExportObject(js_context) {
+    }
+    
+    static void JSExportInitialize() {
+      JSExport<PrototypeConstantWidget>::SetClassVersion(1);
+      JSExport<PrototypeConstantWidget>::SetParent(JSExport<JSExportObject>::Class());
+      JSExport<PrototypeConstantWidget>::SetConstantsOnPrototype(true);
+      JSExport<PrototypeConstantWidget>::AddConstantProperty("CONST1", [](PrototypeConstantWidget& widget) { return widget.get_context().CreateNumber(1); });
+    }
+  };
+  
+  // Two otherwise identical exported classes, to measure the cost of
+  // creating and finalizing many short-lived objects with and without
+  // pooled allocation.
+  template<bool pooled>
+  class ProxyWidget : public JSExportObject, public JSExport<ProxyWidget<pooled>> {
+    
+  public:
+    
+    ProxyWidget(const JSContext& js_context) HAL_NOEXCEPT
+    : JSExportObject(js_context) {
+    }
+    
+    static void JSExportInitialize() {
+      JSExport<ProxyWidget<pooled>>::SetClassVersion(1);
+      JSExport<ProxyWidget<pooled>>::SetParent(JSExport<JSExportObject>::Class());
+      JSExport<ProxyWidget<pooled>>::SetPooledAllocation(pooled);
+    }
+  };
+  
+  // An exported class with many value properties, to measure the
+  // cost of finding a value property's callback by its name.
+  class WideWidget : public JSExportObject, public JSExport<WideWidget> {
+    
+  public:
+    
+    static const std::size_t property_count = 200;
+    
+    WideWidget(const JSContext& js_context) HAL_NOEXCEPT
+    : JSExportObject(js_context) {
+      values__.fill(0);
+    }
+    
+    static void JSExportInitialize() {
+      JSExport<WideWidget>::SetClassVersion(1);
+      JSExport<WideWidget>::SetParent(JSExport<JSExportObject>::Class());
+      for (std::size_t i = 0; i < property_count; ++i) {
+        JSExport<WideWidget>::AddValueProperty("p" + std::to_string(i),
+                                               [i](WideWidget& widget) { return widget.get_context().CreateNumber(widget.values__[i]); },
+                                               [i](WideWidget& widget, const JSValue& value) { widget.values__[i] = static_cast<double>(value); return true; });
+      }
+    }
+    
+  private:
+    
+    std::array<double, property_count> values__;
+  };
+  
+} // namespace {
+
+int main(int argc, char* argv[]) {
+  using namespace HAL;
+  
+  std::uint32_t iteration_count = 1000000;
+  if (argc > 1) {
+    iteration_count = static_cast<std::uint32_t>(std::stoul(argv[1]));
+  }
+  
+  JSContextGroup js_context_group;
+  JSContext js_context = js_context_group.CreateContext();
+  
+  auto widget = js_context.CreateObject(JSExport<Widget>::Class());
+  js_context.get_global_object().SetProperty("Widget", widget);
+  
+  Benchmark(js_context, "Widget.sayHello()"               , "Widget.sayHello();"                , iteration_count);
+  Benchmark(js_context, "Widget.testMemberNumberProperty()", "Widget.testMemberNumberProperty();", iteration_count);
+  Benchmark(js_context, "Widget.addNumbers(1, 2, 3)"      , "Widget.addNumbers(1, 2, 3);"       , iteration_count);
+  Benchmark(js_context, "Widget.add(1, 2.5)"              , "Widget.add(1, 2.5);"               , iteration_count);
+  Benchmark(js_context, "Widget.number"                   , "Widget.number;"                    , iteration_count);
+  Benchmark(js_context, "Widget.number = 7"               , "Widget.number = 7;"                , iteration_count);
+  Benchmark(js_context, "Widget instanceof Widget"        , "Widget instanceof Widget;"         , iteration_count);
+  
+  auto wide_widget = js_context.CreateObject(JSExport<WideWidget>::Class());
+  js_context.get_global_object().SetProperty("WideWidget", wide_widget);
+  
+  Benchmark(js_context, "WideWidget.p0"                   , "WideWidget.p0;"                    , iteration_count);
+  Benchmark(js_context, "WideWidget.p199"                 , "WideWidget.p199;"                  , iteration_count);
+  Benchmark(js_context, "WideWidget.p100 = i"             , "WideWidget.p100 = i;"              , iteration_count);
+  
+  auto other_widget = js_context.CreateObject(JSExport<OtherWidget>::Class());
+  js_context.get_global_object().SetProperty("OtherWidget", other_widget);
+  auto prototype_constant_widget = js_context.CreateObject(JSExport<PrototypeConstantWidget>::Class());
+  js_context.get_global_object().SetProperty("PrototypeConstantWidget", prototype_constant_widget);
+  
+  Benchmark(js_context, "OtherWidget.CONST1"              , "OtherWidget.CONST1;"               , iteration_count);
+  Benchmark(js_context, "PrototypeConstantWidget.CONST1"  , "PrototypeConstantWidget.CONST1;"   , iteration_count);
+  
+  js_context.get_global_object().SetProperty("ProxyWidget"      , js_context.CreateObject(JSExport<ProxyWidget<false>>::Class()));
+  js_context.get_global_object().SetProperty("PooledProxyWidget", js_context.CreateObject(JSExport<ProxyWidget<true>>::Class()));
+  
+  Benchmark(js_context, "new ProxyWidget()"               , "new ProxyWidget();"                , iteration_count);
+  Benchmark(js_context, "new PooledProxyWidget()"         , "new PooledProxyWidget();"          , iteration_count);
+  
+  auto list_widget = js_context.CreateObject(JSExport<ListWidget>::Class());
+  list_widget.GetPrivatePointer<ListWidget>()->get_rows().assign(1000, 1);
+  js_context.get_global_object().SetProperty("ListWidget", list_widget);
+  
+  Benchmark(js_context, "ListWidget[i % 1000]"            , "ListWidget[i % 1000];"             , iteration_count);
+  Benchmark(js_context, "ListWidget[i % 1000] = i"        , "ListWidget[i % 1000] = i;"         , iteration_count);
+  Benchmark(js_context, "ListWidget.length"               , "ListWidget.length;"                , iteration_count);
+}
@@ -0,0 +1,102 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/HAL.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+  
+  // Repeat sample until it is at least length bytes long.
+  std::string MakeInput(const std::string& sample, std::size_t length) {
+    std::string input;
+    while (input.size() < length) {
+      input += sample;
+    }
+    return input;
+  }
+  
+  // Run body iteration_count times and report the throughput in MB/s
+  // of UTF-8 text.
+  void Benchmark(const std::string& name, std::size_t byte_count, std::uint32_t iteration_count, const std::function<void()>& body) {
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < iteration_count; ++i) {
+      body();
+    }
+    const auto stop  = std::chrono::steady_clock::now();
+    
+    const double seconds = std::chrono::duration<double>(stop - start).count();
+    const double megabytes = static_cast<double>(byte_count) * iteration_count / (1024 * 1024);
+    std::cout << name << ": " << iteration_count << " iterations in " << seconds << " s ("
+              << static_cast<std::uint64_t>(megabytes / seconds) << " MB/s)" << std::endl;
+  }
+  
+  // Time the round trip std::string -> JSStringRef -> std::string through
+  // both the JavaScriptCore UTF-8 API and the HAL transcoder.
+  void Benchmark(const std::string& name, const std::string& input, std::uint32_t iteration_count) {
+    std::vector<char> buffer;
+    Benchmark(name + " (JavaScriptCore)", input.size(), iteration_count, [&input, &buffer]() {
+      JSStringRef js_string_ref = JSStringCreateWithUTF8CString(input.c_str());
+      buffer.resize(JSStringGetMaximumUTF8CStringSize(js_string_ref));
+      JSStringGetUTF8CString(js_string_ref, &buffer[0], buffer.size());
+      const std::string output(&buffer[0]);
+      JSStringRelease(js_string_ref);
+    });
+    
+    Benchmark(name + " (HAL)", input.size(), iteration_count, [&input]() {
+      JSStringRef js_string_ref = HAL::detail::JSStringCreateWithUTF8(input.data(), input.size());
+      const std::string output  = HAL::detail::JSStringToUTF8(js_string_ref);
+      JSStringRelease(js_string_ref);
+    });
+  }
+  
+  // Time JSStringRef -> std::string for a string created by
+  // JSStringCreateWithUTF8CString. JavaScriptCore stores ASCII and
+  // Latin-1 input as an 8-bit string, unlike the UTF-16 strings that
+  // the HAL transcoder creates, so this measures the 8-bit source
+  // path of both conversions.
+  void Benchmark8Bit(const std::string& name, const std::string& input, std::uint32_t iteration_count) {
+    JSStringRef js_string_ref = JSStringCreateWithUTF8CString(input.c_str());
+    std::vector<char> buffer;
+    Benchmark(name + " (JavaScriptCore)", input.size(), iteration_count, [js_string_ref, &buffer]() {
+      buffer.resize(JSStringGetMaximumUTF8CStringSize(js_string_ref));
+      JSStringGetUTF8CString(js_string_ref, &buffer[0], buffer.size());
+      const std::string output(&buffer[0]);
+    });
+    
+    Benchmark(name + " (HAL)", input.size(), iteration_count, [js_string_ref]() {
+      const std::string output = HAL::detail::JSStringToUTF8(js_string_ref);
+    });
+    JSStringRelease(js_string_ref);
+  }
+  
+} // namespace {
+
+int main(int argc, char* argv[]) {
+  std::uint32_t iteration_count = 100000;
+  if (argc > 1) {
+    iteration_count = static_cast<std::uint32_t>(std::stoul(argv[1]));
+  }
+  
+  std::cout << "transcoder: " << HAL::detail::GetTranscoderName() << std::endl;
+  
+  for (const std::size_t length : { 16, 256, 4096 }) {
+    const std::string suffix = " " + std::to_string(length) + " bytes";
+    Benchmark("ASCII"   + suffix, MakeInput("The quick brown fox jumps over the lazy dog. ", length), iteration_count);
+    Benchmark("Latin-1" + suffix, MakeInput(u8"Blåbærsyltetøy på smørbrød, café crème à Zürich. ", length), iteration_count);
+    Benchmark("CJK"     + suffix, MakeInput(u8"色は匂へど散りぬるを我が世誰ぞ常ならむ", length), iteration_count);
+    Benchmark8Bit("ASCII 8-bit source"   + suffix, MakeInput("The quick brown fox jumps over the lazy dog. ", length), iteration_count);
+    Benchmark8Bit("Latin-1 8-bit source" + suffix, MakeInput(u8"Blåbærsyltetøy på smørbrød, café crème à Zürich. ", length), iteration_count);
+  }
+}
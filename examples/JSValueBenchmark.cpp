@@ -0,0 +1,214 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/HAL.hpp"
+#include "HAL/detail/JSHandleRegistry.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  
+  std::atomic<std::uint64_t> allocation_count { 0 };
+  
+} // namespace {
+
+// Count every heap allocation made by the process.
+void* operator new(std::size_t size) {
+  ++allocation_count;
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) HAL_NOEXCEPT {
+  std::free(ptr);
+}
+
+namespace {
+  
+  using namespace HAL;
+  
+  // Run body iteration_count times and report the latency and the
+  // number of heap allocations per iteration.
+  void Benchmark(const std::string& name, std::uint32_t iteration_count, const std::function<void()>& body) {
+    const auto allocations = allocation_count.load();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::uint32_t i = 0; i < iteration_count; ++i) {
+      body();
+    }
+    const auto stop  = std::chrono::steady_clock::now();
+    
+    const double nanoseconds = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::cout << name << ": " << nanoseconds / iteration_count << " ns, "
+              << static_cast<double>(allocation_count.load() - allocations) / iteration_count << " allocations per iteration" << std::endl;
+  }
+  
+} // namespace {
+
+int main(int argc, char* argv[]) {
+  std::uint32_t iteration_count = 1000000;
+  if (argc > 1) {
+    iteration_count = static_cast<std::uint32_t>(std::stoul(argv[1]));
+  }
+  
+  JSContextGroup js_context_group;
+  JSContext js_context = js_context_group.CreateContext();
+  
+  // A pool of live handles, so that the registries hold a realistic
+  // number of entries while the benchmarks churn through them.
+  std::vector<JSValue>  js_values;
+  std::vector<JSObject> js_objects;
+  for (int i = 0; i < 1000; ++i) {
+    js_values.push_back(js_context.CreateNumber(i));
+    js_objects.push_back(js_context.CreateObject());
+  }
+  
+  std::uint32_t index = 0;
+  Benchmark("JSValue copy and destroy", iteration_count, [&]() {
+    JSValue js_value = js_values[index++ % js_values.size()];
+    static_cast<void>(js_value);
+  });
+  
+  Benchmark("JSObject copy and destroy", iteration_count, [&]() {
+    JSObject js_object = js_objects[index++ % js_objects.size()];
+    static_cast<void>(js_object);
+  });
+  
+  Benchmark("JSValue create and destroy", iteration_count, [&]() {
+    JSValue js_value = js_context.CreateNumber(index++);
+    static_cast<void>(js_value);
+  });
+  
+  HandleScope handle_scope(js_context);
+  Benchmark("Local<JSValue> create", iteration_count, [&]() {
+    Local<JSValue> js_value = handle_scope.CreateNumber(index++);
+    static_cast<void>(js_value);
+  });
+  
+  Local<JSObject> array = handle_scope.CreateArray();
+  for (std::uint32_t i = 0; i < 1000; ++i) {
+    array.SetProperty(i, handle_scope.CreateNumber(i));
+  }
+  const JSObject js_array = array;
+  Benchmark("JSObject::GetProperty(index)", iteration_count, [&]() {
+    JSValue js_value = js_array.GetProperty(index++ % 1000);
+    static_cast<void>(js_value);
+  });
+  
+  Benchmark("Local<JSObject>::GetProperty(index)", iteration_count, [&]() {
+    Local<JSValue> js_value = array.GetProperty(index++ % 1000);
+    static_cast<void>(js_value);
+  });
+  
+  bool is_array = false;
+  Benchmark("JSObject::IsArray", iteration_count, [&]() {
+    is_array ^= js_array.IsArray();
+  });
+  
+  bool is_error = false;
+  Benchmark("JSObject::IsError", iteration_count, [&]() {
+    is_error ^= js_array.IsError();
+  });
+  
+  JSObject add = static_cast<JSObject>(js_context.JSEvaluateScript("(function(a, b) { return a + b; })"));
+  JSObject global_object = js_context.get_global_object();
+  Benchmark("JSObject call with 2 arguments", iteration_count, [&]() {
+    JSValue result = add({ js_context.CreateNumber(index++), js_context.CreateNumber(1) }, global_object);
+    static_cast<void>(result);
+  });
+  
+  Benchmark("JSObject::Call with 2 arguments", iteration_count, [&]() {
+    JSValue result = add.Call(global_object, index++, 1);
+    static_cast<void>(result);
+  });
+  
+  JSPreparedCall prepared_add(add, global_object);
+  Benchmark("JSPreparedCall::Invoke with 2 arguments", iteration_count, [&]() {
+    JSValue result = prepared_add.Invoke(index++, 1);
+    static_cast<void>(result);
+  });
+  
+  Benchmark("JSPreparedCall::InvokeDiscardingResult", iteration_count, [&]() {
+    prepared_add.InvokeDiscardingResult(index++, 1);
+  });
+  
+  // Bulk conversions of a large array, so far fewer iterations.
+  const std::uint32_t array_iteration_count = std::max<std::uint32_t>(iteration_count / 10000, 1);
+  const JSArray numbers = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("(function() { var a = []; for (var i = 0; i < 100000; ++i) a.push(i / 4); return a; })()")));
+  const JSArray strings = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("(function() { var a = []; for (var i = 0; i < 100000; ++i) a.push('item ' + i); return a; })()")));
+  Benchmark("JSArray to 100000 doubles", array_iteration_count, [&]() {
+    const auto items = static_cast<std::vector<double>>(numbers);
+    static_cast<void>(items);
+  });
+  
+  Benchmark("JSArray to 100000 std::strings", array_iteration_count, [&]() {
+    const auto items = static_cast<std::vector<std::string>>(strings);
+    static_cast<void>(items);
+  });
+  
+  const auto doubles = static_cast<std::vector<double>>(numbers);
+  Benchmark("JSContext::CreateArray from 100000 doubles", array_iteration_count, [&]() {
+    JSArray items = js_context.CreateArray(doubles);
+    static_cast<void>(items);
+  });
+  
+  Benchmark("JSContext::CreateTypedArray of 100000 doubles", array_iteration_count, [&]() {
+    JSTypedArray<double> items = js_context.CreateTypedArray<double>(doubles.size());
+    std::copy(doubles.begin(), doubles.end(), items.GetElements().begin());
+  });
+  
+  // The registry on its own, against the std::unordered_map it
+  // replaced. Each iteration registers a new handle and releases it.
+  std::vector<std::uintptr_t> handles;
+  for (std::uintptr_t i = 1; i <= 1000; ++i) {
+    handles.push_back(i * 64);
+  }
+  
+  detail::JSHandleRegistry registry;
+  for (const auto handle : handles) {
+    registry.Retain(reinterpret_cast<const void*>(handle));
+  }
+  Benchmark("JSHandleRegistry retain and release", iteration_count, [&]() {
+    const auto handle = reinterpret_cast<const void*>((handles.size() + index++ % handles.size() + 1) * 64);
+    std::size_t count { 0 };
+    const void* context { nullptr };
+    registry.Retain(handle);
+    registry.Release(handle, count, context);
+  });
+  
+  std::unordered_map<std::intptr_t, std::size_t> map;
+  for (const auto handle : handles) {
+    map.emplace(static_cast<std::intptr_t>(handle), 1);
+  }
+  Benchmark("std::unordered_map retain and release", iteration_count, [&]() {
+    const auto key = static_cast<std::intptr_t>((handles.size() + index++ % handles.size() + 1) * 64);
+    const auto iter = map.find(key);
+    if (iter == map.end()) {
+      map.emplace(key, 1);
+    } else {
+      map[key] = ++iter->second;
+    }
+    const auto position = map.find(key);
+    if (--position->second == 0) {
+      map.erase(key);
+    } else {
+      map[key] = position->second;
+    }
+  });
+}
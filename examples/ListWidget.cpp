@@ -0,0 +1,82 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "ListWidget.hpp"
+
+ListWidget::ListWidget(const JSContext& js_context) HAL_NOEXCEPT
+: JSExportObject(js_context) {
+  HAL_LOG_DEBUG("ListWidget:: ctor ", this);
+}
+
+ListWidget::~ListWidget() HAL_NOEXCEPT {
+  HAL_LOG_DEBUG("ListWidget:: dtor ", this);
+}
+
+ListWidget::ListWidget(const ListWidget& rhs) HAL_NOEXCEPT
+: JSExportObject(rhs.get_context())
+, rows__(rhs.rows__) {
+  HAL_LOG_DEBUG("ListWidget:: copy ctor ", this);
+}
+
+ListWidget::ListWidget(ListWidget&& rhs) HAL_NOEXCEPT
+: JSExportObject(rhs.get_context())
+, rows__(std::move(rhs.rows__)) {
+  HAL_LOG_DEBUG("ListWidget:: move ctor ", this);
+}
+
+ListWidget& ListWidget::operator=(const ListWidget& rhs) HAL_NOEXCEPT {
+  HAL_LOG_DEBUG("ListWidget:: copy assign ", this);
+  JSExportObject::operator=(rhs);
+  rows__ = rhs.rows__;
+  return *this;
+}
+
+ListWidget& ListWidget::operator=(ListWidget&& rhs) HAL_NOEXCEPT {
+  HAL_LOG_DEBUG("ListWidget:: move assign ", this);
+  swap(rhs);
+  return *this;
+}
+
+void ListWidget::swap(ListWidget& other) HAL_NOEXCEPT {
+  HAL_LOG_DEBUG("ListWidget:: swap ", this);
+  JSExportObject::swap(other);
+  using std::swap;
+  swap(rows__, other.rows__);
+}
+
+void ListWidget::JSExportInitialize() {
+  JSExport<ListWidget>::SetClassVersion(1);
+  JSExport<ListWidget>::SetParent(JSExport<JSExportObject>::Class());
+  JSExport<ListWidget>::AddIndexedPropertyCallbacks(std::mem_fn(&ListWidget::js_get_row), std::mem_fn(&ListWidget::js_set_row), std::mem_fn(&ListWidget::js_get_row_count));
+}
+
+std::vector<std::int32_t>& ListWidget::get_rows() HAL_NOEXCEPT {
+  return rows__;
+}
+
+JSValue ListWidget::js_get_row(std::uint32_t index) {
+  return get_context().CreateNumber(rows__.at(index));
+}
+
+// Rows can be replaced, or appended one at a time.
+bool ListWidget::js_set_row(std::uint32_t index, const JSValue& value) {
+  if (index > rows__.size()) {
+    return false;
+  }
+  const auto row = static_cast<std::int32_t>(value);
+  if (index == rows__.size()) {
+    rows__.push_back(row);
+  } else {
+    rows__[index] = row;
+  }
+  return true;
+}
+
+std::uint32_t ListWidget::js_get_row_count() const HAL_NOEXCEPT {
+  return static_cast<std::uint32_t>(rows__.size());
+}
@@ -0,0 +1,74 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_EXAMPLES_LISTWIDGET_HPP_
+#define _HAL_EXAMPLES_LISTWIDGET_HPP_
+
+#include "HAL/HAL.hpp"
+#include <cstdint>
+#include <vector>
+
+using namespace HAL;
+
+/*!
+ @class
+ 
+ @discussion This is an example of how to create a JavaScript object
+ that is used like an array, whose rows are held by a C++ class.
+ */
+class ListWidget : public JSExportObject, public JSExport<ListWidget> {
+  
+public:
+  
+  /*!
+   @method
+   
+   @abstract This is the constructor used by JSContext::CreateObject
+   to create a ListWidget instance and add it to a JavaScript
+   execution context.
+   
+   @param js_context The JavaScriptCore execution context that your
+   JavaScript object will execute in.
+   */
+  ListWidget(const JSContext& js_context) HAL_NOEXCEPT;
+  
+  virtual ~ListWidget()                     HAL_NOEXCEPT;
+  ListWidget(const ListWidget&)             HAL_NOEXCEPT;
+  ListWidget(ListWidget&&)                  HAL_NOEXCEPT;
+  ListWidget& operator=(const ListWidget&)  HAL_NOEXCEPT;
+  ListWidget& operator=(ListWidget&&)       HAL_NOEXCEPT;
+  void swap(ListWidget&)                    HAL_NOEXCEPT;
+  
+  /*!
+   @method
+   
+   @abstract Define how your JavaScript objects appear to
+   JavaScriptCore.
+   
+   @discussion HAL will call this function exactly once
+   just before your first JavaScript object is created.
+   */
+  static void JSExportInitialize();
+  
+  std::vector<std::int32_t>& get_rows() HAL_NOEXCEPT;
+  
+  JSValue       js_get_row(std::uint32_t index);
+  bool          js_set_row(std::uint32_t index, const JSValue& value);
+  std::uint32_t js_get_row_count() const HAL_NOEXCEPT;
+  
+private:
+  
+  std::vector<std::int32_t> rows__;
+};
+
+inline
+void swap(ListWidget& first, ListWidget& second) HAL_NOEXCEPT {
+  first.swap(second);
+}
+
+#endif // _HAL_EXAMPLES_LISTWIDGET_HPP_
@@ -228,6 +228,9 @@ void Widget::JSExportInitialize() {
   JSExport<Widget>::AddFunctionProperty("testCallAsFunction", std::mem_fn(&Widget::js_testCallAsFunction));
   JSExport<Widget>::AddFunctionProperty("testException", std::mem_fn(&Widget::js_testException));
   JSExport<Widget>::AddFunctionProperty("testNestedException", std::mem_fn(&Widget::js_testNestedException));
+  JSExport<Widget>::AddFunctionProperty("addNumbers", std::mem_fn(&Widget::js_addNumbers));
+  JSExport<Widget>::AddFunctionProperty<HAL_JSEXPORT_METHOD(&Widget::add)>("add");
+  JSExport<Widget>::AddFunctionProperty<HAL_JSEXPORT_METHOD(&Widget::greet)>("greet");
 }
 
 JSValue Widget::js_get_name() const HAL_NOEXCEPT {
@@ -361,4 +364,20 @@ JSValue Widget::js_testException(const std::vector<JSValue>& arguments, JSObject
 JSValue Widget::js_testNestedException(const std::vector<JSValue>& arguments, JSObject& this_object) {
   const auto js_context = this_object.get_context();
   return js_context.JSEvaluateScript("this.testException()", this_object, "app.js", 123);
-}
\ No newline at end of file
+}
+
+JSValue Widget::js_addNumbers(const JSArguments& arguments, JSObject& this_object) {
+  double sum = 0;
+  for (std::size_t i = 0; i < arguments.size(); ++i) {
+    sum += arguments.GetNumber(i);
+  }
+  return this_object.get_context().CreateNumber(sum);
+}
+
+double Widget::add(int32_t lhs, double rhs) const {
+  return lhs + rhs;
+}
+
+std::string Widget::greet(const std::string& greeting) const {
+  return greeting + ", " + name__ + ".";
+}
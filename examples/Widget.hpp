@@ -113,6 +113,12 @@ public:
   JSValue js_testException(const std::vector<JSValue>& arguments, JSObject& this_object);
   JSValue js_testNestedException(const std::vector<JSValue>& arguments, JSObject& this_object);
 
+  JSValue js_addNumbers(const JSArguments& arguments, JSObject& this_object);
+
+  // Bound with their signatures deduced at compile-time.
+  double      add(int32_t lhs, double rhs) const;
+  std::string greet(const std::string& greeting) const;
+
   static uint32_t constructor_count__;
 private:
   
@@ -17,18 +17,26 @@
 #include "HAL/JSClass.hpp"
 
 #include "HAL/JSString.hpp"
+#include "HAL/JSPropertyKey.hpp"
 
 #include "HAL/JSValue.hpp"
 #include "HAL/JSUndefined.hpp"
 #include "HAL/JSNull.hpp"
 #include "HAL/JSBoolean.hpp"
 #include "HAL/JSNumber.hpp"
+#include "HAL/Local.hpp"
+#include "HAL/HandleScope.hpp"
+#include "HAL/JSArguments.hpp"
 
 #include "HAL/JSObject.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSSpan.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSTypedArray.hpp"
 #include "HAL/JSDate.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSFunction.hpp"
+#include "HAL/JSPreparedCall.hpp"
 #include "HAL/JSRegExp.hpp"
 
 #include "HAL/JSPropertyNameArray.hpp"
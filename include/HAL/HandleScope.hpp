@@ -0,0 +1,88 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_HANDLESCOPE_HPP_
+#define _HAL_HANDLESCOPE_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/Local.hpp"
+
+namespace HAL {
+
+  class JSString;
+
+  /*!
+   @class
+
+   @discussion A HandleScope creates Local<JSValue> and
+   Local<JSObject> handles for values that are only needed inside one
+   C++ function or native callback. These handles skip the
+   JSValueProtect/JSValueUnprotect pair and the registry update that
+   every JSValue and JSObject pays. JavaScriptCore's conservative scan
+   of the machine stack keeps them alive instead.
+
+   The scope holds the one JSContext reference that all of its Locals
+   share. Locals must not outlive the HandleScope that created them.
+   A value that escapes the scope has to be converted to a JSValue or
+   JSObject first.
+
+   A HandleScope and its Locals must live on the stack of the thread
+   that uses them.
+   */
+  class HAL_EXPORT HandleScope final {
+
+  public:
+
+    explicit HandleScope(const JSContext& js_context) HAL_NOEXCEPT;
+    ~HandleScope() HAL_NOEXCEPT;
+
+    HandleScope(const HandleScope&)            = delete;
+    HandleScope& operator=(const HandleScope&) = delete;
+
+    Local<JSValue>  CreateUndefined()                       const HAL_NOEXCEPT;
+    Local<JSValue>  CreateNull()                            const HAL_NOEXCEPT;
+    Local<JSValue>  CreateBoolean(bool boolean)             const HAL_NOEXCEPT;
+    Local<JSValue>  CreateNumber(double number)             const HAL_NOEXCEPT;
+    Local<JSValue>  CreateNumber(int32_t number)            const HAL_NOEXCEPT;
+    Local<JSValue>  CreateNumber(uint32_t number)           const HAL_NOEXCEPT;
+    Local<JSValue>  CreateString(const JSString& js_string) const HAL_NOEXCEPT;
+    Local<JSObject> CreateObject()                          const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Create an empty JavaScript array.
+
+     @throws std::runtime_error if creating the array threw a
+     JavaScript exception.
+     */
+    Local<JSObject> CreateArray() const;
+
+    const JSContext& get_context() const HAL_NOEXCEPT {
+      return js_context__;
+    }
+
+    // For interoperability with the JavaScriptCore C API.
+    explicit operator JSContextRef() const HAL_NOEXCEPT {
+      return js_context_ref__;
+    }
+
+  private:
+
+    // Prevent heap based objects.
+    static void * operator new(std::size_t);     // #1: To prevent allocation of scalar objects
+    static void * operator new [] (std::size_t); // #2: To prevent allocation of array of objects
+
+    JSContext    js_context__;
+    JSContextRef js_context_ref__;
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_HANDLESCOPE_HPP_
@@ -0,0 +1,141 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSARGUMENTS_HPP_
+#define _HAL_JSARGUMENTS_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSValue.hpp"
+
+#include <string>
+#include <vector>
+
+namespace HAL {
+
+  class JSString;
+  class JSObject;
+
+  /*!
+   @class
+
+   @discussion A JSArguments is a non-owning view of the arguments
+   that JavaScriptCore passes to a native callback. It borrows the
+   callback's arguments array, so creating one allocates nothing and
+   protects nothing.
+
+   Indexing past the end of the arguments yields undefined, as it
+   does in JavaScript. The typed getters convert the argument in
+   place without creating a JSValue.
+
+   A JSArguments is only valid for the duration of the callback it
+   was passed to.
+   */
+  class HAL_EXPORT JSArguments final {
+
+  public:
+
+    // For interoperability with the JavaScriptCore C API.
+    JSArguments(const JSContext& js_context, std::size_t argument_count, const JSValueRef arguments_array[]) HAL_NOEXCEPT;
+
+    std::size_t size() const HAL_NOEXCEPT {
+      return argument_count__;
+    }
+
+    bool empty() const HAL_NOEXCEPT {
+      return argument_count__ == 0;
+    }
+
+    const JSContext& get_context() const HAL_NOEXCEPT {
+      return *js_context__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the argument at index as a JSValue, or undefined
+     if index is past the end of the arguments.
+     */
+    JSValue operator[](std::size_t index) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the argument at index as a JSValue.
+
+     @throws std::out_of_range if index is past the end of the
+     arguments.
+     */
+    JSValue at(std::size_t index) const;
+
+    JSValue::Type GetType(std::size_t index)     const HAL_NOEXCEPT;
+    bool          IsUndefined(std::size_t index) const HAL_NOEXCEPT;
+    bool          IsNull(std::size_t index)      const HAL_NOEXCEPT;
+    bool          IsBoolean(std::size_t index)   const HAL_NOEXCEPT;
+    bool          IsNumber(std::size_t index)    const HAL_NOEXCEPT;
+    bool          IsString(std::size_t index)    const HAL_NOEXCEPT;
+    bool          IsObject(std::size_t index)    const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index using the JavaScript
+     ToBoolean, ToNumber, ToInt32, ToUint32 or ToString operations.
+
+     @throws std::runtime_error if the conversion threw a JavaScript
+     exception.
+     */
+    bool        GetBoolean(std::size_t index) const HAL_NOEXCEPT;
+    double      GetNumber(std::size_t index)  const;
+    int32_t     GetInt32(std::size_t index)   const;
+    uint32_t    GetUInt32(std::size_t index)  const;
+    std::string GetString(std::size_t index)  const;
+    JSString    GetJSString(std::size_t index) const;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index to a JSObject.
+
+     @throws std::runtime_error if the argument can't be converted to
+     an object.
+     */
+    JSObject GetObject(std::size_t index) const;
+
+    /*!
+     @method
+
+     @abstract Copy the arguments into a vector of protected JSValues.
+     */
+    std::vector<JSValue> to_vector() const;
+
+    // For interoperability with the JavaScriptCore C API.
+    JSValueRef GetJSValueRef(std::size_t index) const HAL_NOEXCEPT {
+      return index < argument_count__ ? arguments_array__[index] : JSValueMakeUndefined(js_context_ref__);
+    }
+
+    // For interoperability with the JavaScriptCore C API.
+    const JSValueRef* data() const HAL_NOEXCEPT {
+      return arguments_array__;
+    }
+
+  private:
+
+    // Prevent heap based objects.
+    static void * operator new(std::size_t);     // #1: To prevent allocation of scalar objects
+    static void * operator new [] (std::size_t); // #2: To prevent allocation of array of objects
+
+    const JSContext*  js_context__;
+    JSContextRef      js_context_ref__;
+    std::size_t       argument_count__;
+    const JSValueRef* arguments_array__;
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSARGUMENTS_HPP_
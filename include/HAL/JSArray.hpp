@@ -12,6 +12,7 @@
 #include "HAL/JSObject.hpp"
 #include "HAL/JSValue.hpp"
 #include "HAL/JSString.hpp"
+#include <cstddef>
 #include <vector>
 
 namespace HAL {
@@ -23,6 +24,14 @@ namespace HAL {
   
   The only way to create a JSArray is by using the
   JSContext::CreateArray member function.
+
+  The conversions to std::vector of bool, double, int32_t, uint32_t
+  and std::string convert all the elements in JavaScript with a single
+  function call and copy them out of a typed array or a joined string,
+  instead of getting each element through the C API. Elements are
+  converted just like the corresponding JSValue conversion operators.
+  If typed arrays aren't available they fall back to getting each
+  element.
 */
 class HAL_EXPORT JSArray final : public JSObject HAL_PERFORMANCE_COUNTER2(JSArray) {
 
@@ -110,8 +119,10 @@ private:
 	friend JSObject;
 	
 	JSArray(const JSContext& js_context, const std::vector<JSValue>& arguments = {});
+	JSArray(const JSContext& js_context, const double* values, std::size_t count);
 
 	static JSObjectRef MakeArray(const JSContext& js_context, const std::vector<JSValue>& arguments);
+	static JSObjectRef MakeArray(const JSContext& js_context, const double* values, std::size_t count);
 
 	// For interoperability with the JavaScriptCore C API.
 	JSArray(const JSContext& js_context, JSObjectRef js_object_ref);
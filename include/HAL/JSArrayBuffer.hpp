@@ -0,0 +1,104 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSARRAYBUFFER_HPP_
+#define _HAL_JSARRAYBUFFER_HPP_
+
+#include "HAL/JSObject.hpp"
+#include "HAL/JSSpan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JavaScript object of the ArrayBuffer type.
+
+   A JSArrayBuffer is created by the JSContext::CreateArrayBuffer
+   member functions, or from a JSObject that is an ArrayBuffer.
+
+   Its bytes are accessed directly through GetBytes without any copy,
+   so a JSArrayBuffer moves binary data between C++ and JavaScript at
+   memory bandwidth.
+   */
+  class HAL_EXPORT JSArrayBuffer final : public JSObject HAL_PERFORMANCE_COUNTER2(JSArrayBuffer) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a JSArrayBuffer from a JSObject that is an
+     ArrayBuffer.
+
+     @throws std::invalid_argument if the JSObject is not an
+     ArrayBuffer.
+     */
+    explicit JSArrayBuffer(const JSObject& js_object);
+
+    /*!
+     @method
+
+     @abstract Return the size of this ArrayBuffer in bytes.
+     */
+    std::size_t GetByteLength() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return a view of the bytes of this ArrayBuffer.
+
+     @discussion The view refers to the ArrayBuffer's memory, so it
+     sees changes made from JavaScript, and changes made through it
+     are seen by JavaScript. It is valid only while this ArrayBuffer
+     is reachable.
+     */
+    JSSpan<std::uint8_t> GetBytes() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return true if a JSObject is an ArrayBuffer.
+     */
+    static bool IsArrayBuffer(const JSObject& js_object) HAL_NOEXCEPT;
+
+  private:
+
+    // Only a JSContext can create a JSArrayBuffer from native memory.
+    friend JSContext;
+
+    JSArrayBuffer(const JSContext& js_context, std::size_t byte_length);
+    JSArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator);
+    JSArrayBuffer(const JSContext& js_context, const std::string& path, std::uint64_t offset, std::size_t length);
+
+    static JSObjectRef MakeArrayBuffer(const JSContext& js_context, std::size_t byte_length);
+    static JSObjectRef MakeArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator);
+    static JSObjectRef MakeArrayBuffer(const JSContext& js_context, const std::string& path, std::uint64_t offset, std::size_t length);
+  };
+
+  namespace detail {
+
+    // Return a copy of deallocator to pass as the deallocator context
+    // of the JavaScriptCore C API along with DeallocateBytes, or
+    // nullptr if there is no deallocator.
+    HAL_EXPORT void* MakeBytesDeallocatorContext(const JSBytesDeallocator& deallocator);
+
+    // The JSTypedArrayBytesDeallocator for a context made by
+    // MakeBytesDeallocatorContext. It calls the deallocator and then
+    // deletes it.
+    HAL_EXPORT void DeallocateBytes(void* bytes, void* deallocator_context);
+
+  } // namespace detail {
+
+} // namespace HAL {
+
+#endif // _HAL_JSARRAYBUFFER_HPP_
@@ -24,6 +24,9 @@ namespace HAL { namespace detail {
   
   template<typename T>
   class JSExportClassDefinitionBuilder;
+  
+  template<typename T>
+  class JSExportClass;
 }}
 
 namespace HAL {
@@ -84,7 +87,7 @@ namespace HAL {
     
   private:
     
-    // These five classes need access to operator JSClassRef().
+    // These six classes need access to operator JSClassRef().
     friend class JSContext; // for constructor
     friend class JSValue;   // for IsObjectOfClass
     friend class JSObject;  // for constructor
@@ -97,6 +100,10 @@ namespace HAL {
     template<typename T>
     friend class detail::JSExportClassDefinitionBuilder;
     
+    // For finding the prototype to install constant properties on
+    template<typename T>
+    friend class detail::JSExportClass;
+    
     explicit operator JSClassRef() const HAL_NOEXCEPT {
       return js_class_ref__;
     }
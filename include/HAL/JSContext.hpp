@@ -11,7 +11,11 @@
 
 #include "HAL/detail/JSBase.hpp"
 #include "HAL/JSContextGroup.hpp"
+#include "HAL/detail/JSNativeCallable.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <unordered_map>
 
@@ -30,7 +34,11 @@ namespace HAL {
   class JSError;
   class JSRegExp;
   class JSFunction;
+  class JSArrayBuffer;
+  template<typename T>
+  class JSTypedArray;
   class JSExportObject;
+  class JSArguments;
   
   namespace detail {
     template<typename T>
@@ -42,6 +50,19 @@ namespace HAL {
 namespace HAL {
 
   typedef std::function<JSValue(const std::vector<JSValue>, JSObject&)> JSFunctionCallback;
+  typedef std::function<JSValue(const JSArguments&, JSObject&)> JSFunctionArgumentsCallback;
+  
+  /*!
+   @typedef JSBytesDeallocator
+   
+   @abstract The callback that frees the native memory of a
+   JSArrayBuffer or JSTypedArray that was created without copying it.
+   
+   @discussion It is called with the memory once JavaScriptCore no
+   longer needs it, which may be during garbage collection, so it must
+   not call back into JavaScript.
+   */
+  typedef std::function<void(void* bytes)> JSBytesDeallocator;
   
   /*!
    @class
@@ -234,6 +255,143 @@ namespace HAL {
     JSArray CreateArray() const HAL_NOEXCEPT;
     JSArray CreateArray(const std::vector<JSValue>& arguments) const;
     
+    /*!
+     @method
+     
+     @abstract Create a JavaScript Array object of numbers.
+     
+     @discussion The numbers are copied into a Float64Array and moved
+     into the array by a single JavaScript function call, instead of
+     being created and set one at a time.
+     
+     @param values The numbers to populate the array with.
+     
+     @param count The number of numbers.
+     
+     @result A JavaScript object that is an Array of numbers.
+     */
+    JSArray CreateArray(const double* values, std::size_t count) const;
+    JSArray CreateArray(const std::vector<double>& values) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer object of zeroed bytes.
+     
+     @param byte_length The size of the ArrayBuffer in bytes.
+     
+     @result A JSArrayBuffer that owns its memory.
+     */
+    JSArrayBuffer CreateArrayBuffer(std::size_t byte_length) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer object whose bytes are
+     existing native memory, without copying it.
+     
+     @discussion The memory must remain valid until deallocator is
+     called. If deallocator is nullptr the memory is never released by
+     JavaScriptCore, so it must outlive every use of the ArrayBuffer.
+     
+     @param bytes The native memory for the ArrayBuffer to use.
+     
+     @param byte_length The size of the memory in bytes.
+     
+     @param deallocator The callback to call with bytes when the
+     ArrayBuffer is garbage collected.
+     
+     @result A JSArrayBuffer whose bytes are the given memory.
+     */
+    JSArrayBuffer CreateArrayBuffer(void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer object whose bytes are
+     a memory mapping of a file.
+     
+     @discussion Pages of the file are read only when they are first
+     accessed, so creating the ArrayBuffer is fast and its memory use
+     grows with the pages that are touched rather than with its size.
+     The mapping is copy-on-write: the file is opened read-only and
+     writes to the ArrayBuffer are never written back to it. The file
+     is unmapped when the ArrayBuffer is garbage collected.
+     
+     The file must not be truncated while it is mapped.
+     
+     @param path The path of the file to map.
+     
+     @param offset The offset in bytes of the first byte to map, which
+     need not be a multiple of the page size.
+     
+     @param length The number of bytes to map, or 0 to map the rest of
+     the file.
+     
+     @throws std::invalid_argument if the range is outside of the
+     file.
+     
+     @throws std::runtime_error if the file can't be opened or mapped.
+     
+     @result A JSArrayBuffer whose bytes are the mapped file.
+     */
+    JSArrayBuffer CreateArrayBufferFromFile(const std::string& path, std::uint64_t offset = 0, std::size_t length = 0) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript typed array of zeroed elements, such
+     as a Float32Array for JSTypedArray<float>.
+     
+     @param length The number of elements.
+     
+     @result A JSTypedArray<T> with its own ArrayBuffer.
+     */
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(std::size_t length) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript typed array whose elements are
+     existing native memory, without copying it.
+     
+     @discussion The memory must remain valid until deallocator is
+     called, as for CreateArrayBuffer.
+     
+     @param elements The native elements for the typed array to use.
+     
+     @param length The number of elements.
+     
+     @param deallocator The callback to call with elements when the
+     typed array's ArrayBuffer is garbage collected.
+     
+     @result A JSTypedArray<T> whose elements are the given memory.
+     */
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(T* elements, std::size_t length, const JSBytesDeallocator& deallocator) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript typed array that views part of an
+     existing ArrayBuffer.
+     
+     @param array_buffer The ArrayBuffer to view.
+     
+     @param byte_offset The offset in bytes of the first element,
+     which must be a multiple of sizeof(T).
+     
+     @param length The number of elements.
+     
+     @throws std::runtime_error if the elements don't fit in the
+     ArrayBuffer.
+     
+     @result A JSTypedArray<T> that shares the ArrayBuffer's memory.
+     */
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length) const;
+    
     /*!
      @method
      
@@ -333,6 +491,34 @@ namespace HAL {
     JSFunction CreateFunction(JSFunctionCallback& callback) const;
     JSFunction CreateFunction(const JSString& function_name, JSFunctionCallback& callback) const;
 
+    /*!
+     @method
+     
+     @abstract Create a JavaScript function whose callback takes its
+     arguments as a JSArguments view instead of a std::vector of
+     JSValues, so that calling it allocates nothing for its
+     arguments.
+     */
+    JSFunction CreateFunction(JSFunctionArgumentsCallback& callback) const;
+    JSFunction CreateFunction(const JSString& function_name, JSFunctionArgumentsCallback& callback) const;
+
+    /*!
+     @method
+     
+     @abstract Create a JavaScript function from a C++ function
+     pointer or lambda whose signature is deduced at compile-time,
+     e.g. [](int32_t lhs, double rhs) { return lhs + rhs; }. The
+     JavaScript arguments are converted directly into the parameter
+     types, and the result back into a JavaScript value.
+
+     @discussion See JSNativeBinding.hpp for the supported parameter
+     and result types. These overloads are defined in JSFunction.hpp.
+     */
+    template<typename F, typename = typename std::enable_if<detail::IsJSNativeCallable<typename std::decay<F>::type>::value>::type>
+    JSFunction CreateFunction(F function) const;
+    template<typename F, typename = typename std::enable_if<detail::IsJSNativeCallable<typename std::decay<F>::type>::value>::type>
+    JSFunction CreateFunction(const JSString& function_name, F function) const;
+
     /*!
      @method
      
@@ -461,6 +647,10 @@ namespace HAL {
     
     JSContext(const JSContextGroup& js_context_group, const JSClass& global_object_class) HAL_NOEXCEPT;
     
+    // Evaluate a script with a raw 'this' object. A null this_object_ref
+    // means the global object.
+    JSValue JSEvaluateScript(const JSString& script, JSObjectRef this_object_ref, const JSString& source_url, int starting_line_number) const;
+    
     HAL_EXPORT friend bool operator==(const JSValue& lhs, const JSValue& rhs) HAL_NOEXCEPT;
     HAL_EXPORT friend std::vector<JSValue> detail::to_vector(const JSContext&, size_t, const JSValueRef[]);
    
@@ -15,6 +15,12 @@
 #include <string>
 #include <memory>
 #include <mutex>
+#include <functional>
+
+// Expands a pointer to member function into the template arguments of
+// the compile-time bound JSExport::AddFunctionProperty, e.g.
+// AddFunctionProperty<HAL_JSEXPORT_METHOD(&Widget::add)>("add").
+#define HAL_JSEXPORT_METHOD(method) decltype(method), method
 
 namespace HAL {
   
@@ -117,6 +123,79 @@ namespace HAL {
      */
     static detail::JSExportClass<T> Class();
     
+    /*!
+     @method
+     
+     @abstract Return the JavaScript object of your JSClass that stands
+     for a native key in a JSContext, creating it the first time.
+     
+     @discussion Use this in a getter that returns a child object for
+     some native instance, such as a member of your native object, so
+     that every call returns the same JavaScript object instead of
+     creating a new one:
+     
+     JSValue Parent::js_get_child() {
+       return JSExport<Child>::WrapExisting(get_context(), &child_model__, [this](Child& child) {
+         child.set_model(&child_model__);
+       });
+     }
+     
+     The key is only compared by address, so you must call
+     ForgetWrapper before the native instance it points to is
+     destroyed. Otherwise a new instance at the same address would be
+     given the JavaScript object of the old one:
+     
+     Parent::~Parent() {
+       JSExport<Child>::ForgetWrapper(get_context(), &child_model__);
+     }
+     
+     Where JavaScriptCore has WeakRef the JSContext remembers the
+     JavaScript object without keeping it alive, and the next call
+     after it has been garbage collected creates a new one. Otherwise
+     the JavaScript object is kept alive until ForgetWrapper is called
+     or the JSContext is destroyed. The initialize function is only
+     called for a newly created JavaScript object, to set up its
+     native object.
+     
+     The JavaScript object always has a native object of its own,
+     because the native objects of a JSClass are allocated together
+     with their class information. An existing instance of T can't be
+     the private data of a JavaScript object, so initialize must copy
+     or refer to what the native object needs from the key.
+     
+     For a native object that already is the private data of a
+     JavaScript object, JSExportObject::get_object returns that
+     object.
+     
+     @param js_context The JSContext to find or create the JavaScript
+     object in.
+     
+     @param key The native instance that the JavaScript object stands
+     for.
+     
+     @param initialize An optional function to set up the native
+     object of a newly created JavaScript object.
+     */
+    static JSObject WrapExisting(const JSContext& js_context, const void* key, const std::function<void(T&)>& initialize = nullptr);
+    
+    /*!
+     @method
+     
+     @abstract Forget the JavaScript object that WrapExisting returned
+     for a native key in a JSContext, so that the next call creates a
+     new one.
+     
+     @discussion Call this before the native instance that the key
+     points to is destroyed.
+     
+     @param js_context The JSContext the JavaScript object was created
+     in.
+     
+     @param key The native instance that the JavaScript object stood
+     for.
+     */
+    static void ForgetWrapper(const JSContext& js_context, const void* key);
+    
     /*
      @method
      @abstract Erase all constant cache
@@ -162,9 +241,40 @@ namespace HAL {
      
      @abstract Set the parent of your JSClass. By default your JSClass
      will have the default JavaScript object class.
+
+     @discussion If the parent is the JSClass of another JSExport
+     class, your C++ class must derive from that class, because
+     JSObject::GetPrivate<T> and 'instanceof' trust the parent chain
+     instead of using a dynamic_cast.
      */
     static void SetParent(const JSClass& parent);
     
+    /*!
+     @method
+     
+     @abstract Set whether the properties added by AddConstantProperty
+     are installed as read-only, non-deletable data properties on your
+     JSClass's prototype, once per JSContext. By default they are
+     value properties whose results are cached.
+     
+     @discussion Please see
+     JSExportClassDefinitionBuilder::ConstantsOnPrototype for the
+     details.
+     */
+    static void SetConstantsOnPrototype(bool constants_on_prototype);
+    
+    /*!
+     @method
+     
+     @abstract Set whether the instances of your C++ class that back
+     your JavaScript objects are allocated from a pool of fixed-size
+     slots. By default each one is allocated from the heap.
+     
+     @discussion Please see
+     JSExportClassDefinitionBuilder::PooledAllocation for the details.
+     */
+    static void SetPooledAllocation(bool pooled_allocation);
+    
     /*!
      @method
      
@@ -293,6 +403,56 @@ namespace HAL {
      */
     static void AddFunctionProperty(const JSString& function_name, detail::CallNamedFunctionCallback<T> function_callback, bool enumerable = true);
     
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     callback takes its arguments as a JSArguments view, so that
+     calling the function allocates nothing for its arguments.
+     
+     @discussion For example, given this class definition:
+     
+     class Foo {
+     JSValue Hello(const JSArguments& arguments, JSObject& this_object);
+     };
+     
+     You would call AddFunctionProperty like this:
+     
+     AddFunctionProperty("hello", &Foo::Hello);
+     
+     @throws std::invalid_argument exception under the same
+     preconditions as the std::vector overload.
+     */
+    static void AddFunctionProperty(const JSString& function_name, detail::CallNamedFunctionArgumentsCallback<T> function_callback, bool enumerable = true);
+    
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object that
+     calls a member function whose signature is deduced at
+     compile-time, without a std::function or a copy of the arguments
+     in between.
+     
+     @discussion For example, given this class definition:
+     
+     class Foo {
+     double Add(int32_t lhs, double rhs);
+     };
+     
+     You would call AddFunctionProperty like this:
+     
+     AddFunctionProperty<HAL_JSEXPORT_METHOD(&Foo::Add)>("add");
+     
+     @throws std::invalid_argument exception under these
+     preconditions:
+     
+     1. If function_name is empty.
+     
+     2. You have already added a property with the same property_name.
+     */
+    template<typename M, M method>
+    static void AddFunctionProperty(const JSString& function_name, bool enumerable = true);
+    
     /*!
      @method
      
@@ -474,6 +634,54 @@ namespace HAL {
      */
     static void AddGetPropertyNamesCallback(const detail::GetPropertyNamesCallback<T>& get_property_names_callback);
     
+    /*!
+     @method
+     
+     @abstract Set the callbacks to invoke for the array index
+     properties and the length property of your JavaScript object, for
+     a class that is used like an array.
+     
+     @discussion A property name that is a canonical array index, such
+     as "0" or "42" but not "042" or "-1", is recognized from its UTF-16
+     characters and passed to your callbacks as an integer, without
+     converting the name to a JSString. All other property names go to
+     the callbacks added by AddGetPropertyCallback and
+     AddSetPropertyCallback (if any), then to properties added by the
+     AddValueProperty and AddFunctionProperty methods.
+     
+     Getting an array index below the length calls the get callback,
+     and the length property is the result of the length callback.
+     Setting an array index calls the set callback, or is ignored below
+     the length if there is no set callback. A for...in loop visits the
+     array indexes below the length.
+     
+     For example, given this class definition:
+     
+     class Foo {
+     JSValue       GetRow(std::uint32_t index);
+     bool          SetRow(std::uint32_t index, const JSValue& value);
+     std::uint32_t GetRowCount() const;
+     };
+     
+     You would call AddIndexedPropertyCallbacks like this:
+     
+     AddIndexedPropertyCallbacks(&Foo::GetRow, &Foo::SetRow, &Foo::GetRowCount);
+     
+     @param get_indexed_property_callback The callback to invoke when
+     getting an array index below the length.
+     
+     @param set_indexed_property_callback The callback to invoke when
+     setting an array index, or nullptr if the array index properties
+     are read-only.
+     
+     @param get_length_callback The callback to invoke when getting
+     the number of array index properties.
+     
+     @throws std::invalid_argument if the get_indexed_property_callback
+     or the get_length_callback is missing.
+     */
+    static void AddIndexedPropertyCallbacks(const detail::GetIndexedPropertyCallback<T>& get_indexed_property_callback, const detail::SetIndexedPropertyCallback<T>& set_indexed_property_callback, const detail::GetLengthCallback<T>& get_length_callback);
+    
     /*!
      @method
      
@@ -507,6 +715,15 @@ namespace HAL {
      */
     static void AddCallAsFunctionCallback(const detail::CallAsFunctionCallback<T>& call_as_function_callback);
     
+    /*!
+     @method
+     
+     @abstract Set the callback to invoke when your JavaScript object
+     is called as a function, passing the arguments as a JSArguments
+     view instead of a std::vector of JSValues.
+     */
+    static void AddCallAsFunctionCallback(const detail::CallAsFunctionArgumentsCallback<T>& call_as_function_callback);
+    
     /*!
      @method
      
@@ -562,6 +779,16 @@ namespace HAL {
     builder__.Parent(parent);
   }
   
+  template<typename T>
+  void JSExport<T>::SetConstantsOnPrototype(bool constants_on_prototype) {
+    builder__.ConstantsOnPrototype(constants_on_prototype);
+  }
+  
+  template<typename T>
+  void JSExport<T>::SetPooledAllocation(bool pooled_allocation) {
+    builder__.PooledAllocation(pooled_allocation);
+  }
+  
   template<typename T>
   void JSExport<T>::AddValueProperty(const JSString& property_name, detail::GetNamedValuePropertyCallback<T> get_callback, detail::SetNamedValuePropertyCallback<T> set_callback, bool enumerable) {
     builder__.AddValueProperty(property_name, get_callback, set_callback, enumerable);
@@ -577,6 +804,17 @@ namespace HAL {
     builder__.AddFunctionProperty(function_name, function_callback, enumerable);
   }
   
+  template<typename T>
+  void JSExport<T>::AddFunctionProperty(const JSString& function_name, detail::CallNamedFunctionArgumentsCallback<T> function_callback, bool enumerable) {
+    builder__.AddFunctionProperty(function_name, function_callback, enumerable);
+  }
+  
+  template<typename T>
+  template<typename M, M method>
+  void JSExport<T>::AddFunctionProperty(const JSString& function_name, bool enumerable) {
+    builder__.template AddFunctionProperty<M, method>(function_name, enumerable);
+  }
+  
   template<typename T>
   void JSExport<T>::AddHasPropertyCallback(const detail::HasPropertyCallback<T>& has_property_callback) {
     builder__.HasProperty(has_property_callback);
@@ -602,11 +840,21 @@ namespace HAL {
     builder__.GetPropertyNames(get_property_names_callback);
   }
   
+  template<typename T>
+  void JSExport<T>::AddIndexedPropertyCallbacks(const detail::GetIndexedPropertyCallback<T>& get_indexed_property_callback, const detail::SetIndexedPropertyCallback<T>& set_indexed_property_callback, const detail::GetLengthCallback<T>& get_length_callback) {
+    builder__.IndexedProperty(get_indexed_property_callback, set_indexed_property_callback, get_length_callback);
+  }
+  
   template<typename T>
   void JSExport<T>::AddCallAsFunctionCallback(const detail::CallAsFunctionCallback<T>& call_as_function_callback) {
     builder__.CallAsFunction(call_as_function_callback);
   }
   
+  template<typename T>
+  void JSExport<T>::AddCallAsFunctionCallback(const detail::CallAsFunctionArgumentsCallback<T>& call_as_function_callback) {
+    builder__.CallAsFunction(call_as_function_callback);
+  }
+  
   template<typename T>
   void JSExport<T>::AddConvertToTypeCallback(const detail::ConvertToTypeCallback<T>& convert_to_type_callback) {
     builder__.ConvertToType(convert_to_type_callback);
@@ -629,6 +877,18 @@ namespace HAL {
     return js_export_class;
   }
   
+  template<typename T>
+  JSObject JSExport<T>::WrapExisting(const JSContext& js_context, const void* key, const std::function<void(T&)>& initialize) {
+    Class();
+    return detail::JSExportClass<T>::WrapExisting(js_context, key, initialize);
+  }
+  
+  template<typename T>
+  void JSExport<T>::ForgetWrapper(const JSContext& js_context, const void* key) {
+    Class();
+    detail::JSExportClass<T>::ForgetWrapper(js_context, key);
+  }
+  
   template<typename T>
   void JSExport<T>::EvictAllCache() {
     detail::JSExportClass<T>::EvictAllCache();
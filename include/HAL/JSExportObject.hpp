@@ -49,6 +49,11 @@ namespace HAL {
      
      @abstract Return the JSObject of this JavaScript value.
      
+     @discussion The JavaScript object is found through a pointer
+     back to it, which is set when this native object becomes its
+     private data and cleared when it is finalized. Until then, and in
+     a copy of this native object, the result is a JSError.
+     
      @result The JSObject of this JavaScript value.
      */
     virtual JSObject get_object() HAL_NOEXCEPT final;
@@ -56,12 +61,8 @@ namespace HAL {
     JSExportObject(const JSContext& js_context) HAL_NOEXCEPT;
     
     virtual ~JSExportObject() HAL_NOEXCEPT;
-    JSExportObject(const JSExportObject&)            = default;
-    JSExportObject& operator=(const JSExportObject&) = default;
-#ifdef HAL_MOVE_CTOR_AND_ASSIGN_DEFAULT_ENABLE
-    JSExportObject(JSExportObject&&)                 = default;
-    JSExportObject& operator=(JSExportObject&&)      = default;
-#endif
+    JSExportObject(const JSExportObject&)            HAL_NOEXCEPT;
+    JSExportObject& operator=(const JSExportObject&) HAL_NOEXCEPT;
 
     void swap(JSExportObject&) HAL_NOEXCEPT;
     
@@ -95,8 +96,17 @@ namespace HAL {
 		
   private:
     
+    // Only JSExportClass knows which JavaScript object a native
+    // object belongs to.
+    template<typename T>
+    friend class detail::JSExportClass;
+    
     JSContext js_context__;
     
+    // The JavaScript object whose private data this is. It isn't
+    // protected, so that it can be garbage collected.
+    JSObjectRef js_object_ref__ { nullptr };
+    
 #undef  HAL_JSEXPORTOBJECT_LOCK_GUARD
 #ifdef  HAL_THREAD_SAFE
     std::recursive_mutex mutex__;
@@ -10,8 +10,11 @@
 #define _HAL_JSFUNCTION_HPP_
 
 #include "HAL/JSObject.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/detail/JSNativeBinding.hpp"
 #include <functional>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
 
 namespace HAL {
 
@@ -26,22 +29,15 @@ namespace HAL {
 
   The only way to create a JSFunction is by using the
   JSContext::CreateFunction member function.
+
+  A JSFunction created from a native callback keeps the callback as
+  the private data of its JavaScript object, which frees it when the
+  object is garbage collected. Copies of a JSFunction therefore refer
+  to the same JavaScript object, just like copies of any other
+  JSObject.
 */
 class HAL_EXPORT JSFunction final : public JSObject HAL_PERFORMANCE_COUNTER2(JSFunction) {
 
-public:
-    
-    static void RegisterJSFunctionCallback(JSObjectRef js_object_ref, JSFunctionCallback);
-    static void UnRegisterJSFunctionCallback(JSObjectRef js_object_ref);
-    static JSFunctionCallback FindJSFunctionCallback(JSObjectRef js_object_ref);
-
-    JSFunction(const JSFunction& rhs);
-    JSFunction(JSFunction&& rhs);
-    JSFunction& operator=(const JSFunction& rhs);
-    JSFunction& operator=(JSFunction&& rhs);
-
-    virtual ~JSFunction() HAL_NOEXCEPT;
-
 private:
     
     // Only a JSContext can create a JSFunction.
@@ -49,23 +45,104 @@ private:
     
     JSFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number);
     JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback);
+    JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionArgumentsCallback& callback);
+    JSFunction(const JSContext& js_context, JSObjectRef js_object_ref);
 
     static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number);
 
-    static JSValueRef  JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
-    static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback);
+    static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionArgumentsCallback& callback);
+    static JSObjectRef MakeFunction(const JSContext& js_context, JSClassRef js_class_ref, void* private_data);
+    static JSFunctionArgumentsCallback ToArgumentsCallback(const JSFunctionCallback& callback);
 
-    void RetainCallbackAfterCopy();
+    // Create the JSClass of functions created from a native callback.
+    static JSClassRef  MakeCallbackClass(const JSStaticValue* static_values, ::JSObjectFinalizeCallback finalize, ::JSObjectCallAsFunctionCallback call_as_function);
 
-    // Silence 4251 on Windows since private member variables do not
-    // need to be exported from a DLL.
-#pragma warning(push)
-#pragma warning(disable: 4251)
-    static std::unordered_map<std::intptr_t, JSFunctionCallback> js_object_ref_to_js_function__;
-#pragma warning(pop)
+    // Set *exception to a JavaScript Error for a C++ exception thrown
+    // by a native callback.
+    static void        SetException(JSContextRef context_ref, JSValueRef* exception, const std::string& what);
 
+    // The JSClass shared by all functions created from a native
+    // callback, which is created the first time it is needed.
+    static JSClassRef  GetCallbackClass();
+    static void        JSObjectFinalizeCallback(JSObjectRef object_ref);
+    static JSValueRef  JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+    static JSValueRef  JSObjectGetNameCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception);
+
+    // The private data of a function created from a native callable
+    // of type F.
+    template<typename F>
+    struct NativeFunctionData {
+      F        function;
+      JSString name;
+    };
+
+    // Each callable type F has its own JSClass whose callAsFunction
+    // callback converts the arguments and result for F directly, so
+    // calling it needs neither a std::function nor a JSValue.
+    template<typename F>
+    static JSClassRef  GetNativeFunctionClass();
+    template<typename F>
+    static void        NativeFinalizeCallback(JSObjectRef object_ref);
+    template<typename F>
+    static JSValueRef  NativeCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+    template<typename F>
+    static JSValueRef  NativeGetNameCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception);
 };
 
+template<typename F>
+JSClassRef JSFunction::GetNativeFunctionClass() {
+    static const JSStaticValue static_values[] = {
+        { "name", JSFunction::NativeGetNameCallback<F>, nullptr, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontEnum | kJSPropertyAttributeDontDelete },
+        { nullptr, nullptr, nullptr, 0 }
+    };
+    static const JSClassRef js_class_ref = MakeCallbackClass(static_values, JSFunction::NativeFinalizeCallback<F>, JSFunction::NativeCallAsFunctionCallback<F>);
+    return js_class_ref;
+}
+
+template<typename F>
+void JSFunction::NativeFinalizeCallback(JSObjectRef object_ref) {
+    delete static_cast<NativeFunctionData<F>*>(JSObjectGetPrivate(object_ref));
+}
+
+template<typename F>
+JSValueRef JSFunction::NativeCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
+    const auto function_data = static_cast<NativeFunctionData<F>*>(JSObjectGetPrivate(function_ref));
+    if (!function_data) {
+        return JSValueMakeUndefined(context_ref);
+    }
+    const JSContext js_context(context_ref);
+    return detail::JSNativeCallable<F>::Call(function_data->function, JSArguments(js_context, argument_count, arguments_array));
+} catch (const std::exception& e) {
+    SetException(context_ref, exception, e.what());
+    return nullptr;
+} catch (...) {
+    SetException(context_ref, exception, "unknown exception");
+    return nullptr;
+}
+
+template<typename F>
+JSValueRef JSFunction::NativeGetNameCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef, JSValueRef*) {
+    const auto function_data = static_cast<NativeFunctionData<F>*>(JSObjectGetPrivate(object_ref));
+    if (!function_data) {
+        return nullptr;
+    }
+    return JSValueMakeString(context_ref, static_cast<JSStringRef>(function_data->name));
+}
+
+template<typename F, typename>
+JSFunction JSContext::CreateFunction(F function) const {
+  return CreateFunction<F>(JSString(), function);
+}
+
+template<typename F, typename>
+JSFunction JSContext::CreateFunction(const JSString& function_name, F function) const {
+  typedef typename std::decay<F>::type function_type;
+  HAL_JSCONTEXT_LOCK_GUARD;
+  const JSContext js_context(js_global_context_ref__);
+  const auto private_data = new JSFunction::NativeFunctionData<function_type> { function, function_name };
+  return JSFunction(js_context, JSFunction::MakeFunction(js_context, JSFunction::GetNativeFunctionClass<function_type>(), private_data));
+}
+
 } // namespace HAL {
 
 #endif // _HAL_JSFUNCTION_HPP_
@@ -13,6 +13,9 @@
 #include "HAL/JSContext.hpp"
 #include "HAL/JSPropertyAttribute.hpp"
 #include "HAL/JSPropertyNameArray.hpp"
+#include "HAL/JSPropertyKey.hpp"
+#include "HAL/detail/JSHandleRegistry.hpp"
+#include "HAL/detail/JSExportClassInfo.hpp"
 
 #include <memory>
 #include <vector>
@@ -47,6 +50,8 @@ namespace HAL {
    
    JSFunction
    JSArray
+   JSArrayBuffer
+   JSTypedArray<T>
    JSDate
    JSError
    JSRegExp
@@ -70,6 +75,18 @@ namespace HAL {
      */
     virtual bool HasProperty(const JSString& property_name) const HAL_NOEXCEPT final;
     
+    /*!
+     @method
+     
+     @abstract Determine whether this JavaScript object has a
+     property using an interned property key.
+     
+     @param property_key The interned name of the property.
+     
+     @result true if this JavaScript object has the property.
+     */
+    virtual bool HasProperty(const JSPropertyKey& property_key) const HAL_NOEXCEPT final;
+    
     /*!
      @method
      
@@ -85,6 +102,22 @@ namespace HAL {
      */
     virtual JSValue GetProperty(const JSString& property_name) const final;
     
+    /*!
+     @method
+     
+     @abstract Return a property of this JavaScript object using an
+     interned property key.
+     
+     @param property_key The interned name of the property to get.
+     
+     @result The property's value if this JavaScript object has the
+     property, otherwise JSUndefined.
+     
+     @throws std::runtime_error if getting the property threw a
+     JavaScript exception.
+     */
+    virtual JSValue GetProperty(const JSPropertyKey& property_key) const final;
+    
     /*!
      @method
      
@@ -124,6 +157,24 @@ namespace HAL {
      */
     virtual void SetProperty(const JSString& property_name, const JSValue& property_value, const std::unordered_set<JSPropertyAttribute>& attributes = {}) final;
     
+    /*!
+     @method
+     
+     @abstract Set a property on this JavaScript object using an
+     interned property key with an optional set of attributes.
+     
+     @param property_key The interned name of the property to set.
+     
+     @param value The value of the the property to set.
+     
+     @param attributes An optional set of property attributes to give
+     to the property.
+     
+     @throws std::runtime_error if setting the property threw a
+     JavaScript exception.
+     */
+    virtual void SetProperty(const JSPropertyKey& property_key, const JSValue& property_value, const std::unordered_set<JSPropertyAttribute>& attributes = {}) final;
+    
     /*!
      @method
      
@@ -156,6 +207,21 @@ namespace HAL {
      */
     virtual bool DeleteProperty(const JSString& property_name) final;
     
+    /*!
+     @method
+     
+     @abstract Delete a property from this JavaScript object using an
+     interned property key.
+     
+     @param property_key The interned name of the property to delete.
+     
+     @result true if the property was deleted.
+     
+     @throws std::runtime_error if deleting the property threw a
+     JavaScript exception.
+     */
+    virtual bool DeleteProperty(const JSPropertyKey& property_key) final;
+    
     /*!
      @method
      
@@ -268,6 +334,53 @@ namespace HAL {
     virtual JSObject CallAsConstructor(const std::vector<JSString>& arguments) final;
     virtual JSObject CallAsConstructor(const std::vector<JSValue>&  arguments) final;
     
+    /*!
+     @method
+     
+     @abstract Call this JavaScript object as a function with C++
+     arguments, and convert its return value to R.
+     
+     @discussion The arguments may be bool, integers of at most 32
+     bits, float, double, std::string, string literals, JSString, and
+     JSValue or JSObject or any class derived from them. They are
+     converted directly into an array of JSValueRefs on the stack, so
+     the call itself allocates nothing on the heap.
+     
+     R may be any of the same types except string literals, or void to
+     ignore the return value. The default is JSValue.
+     
+     For example:
+     
+     const int32_t sum = add.Call<int32_t>(this_object, 1, 2);
+     
+     @param this_object The JavaScript object to use as 'this'.
+     
+     @param arguments The arguments to pass to the function.
+     
+     @result The function's return value converted to R.
+     
+     @throws std::runtime_error if either this JavaScript object can't
+     be called as a function, or calling the function itself threw a
+     JavaScript exception.
+     */
+    template<typename R = JSValue, typename... Args>
+    R Call(const JSObject& this_object, Args&&... arguments);
+    
+    /*!
+     @method
+     
+     @abstract Call this JavaScript object as a constructor as if in a
+     'new' expression, with C++ arguments converted as by Call.
+     
+     @result The JavaScript object of the constructor's return value.
+     
+     @throws std::runtime_error if either this JavaScript object can't
+     be called as a constructor, or calling the constructor itself
+     threw a JavaScript exception.
+     */
+    template<typename... Args>
+    JSObject Construct(Args&&... arguments);
+    
     /*!
      @method
      
@@ -336,7 +449,23 @@ namespace HAL {
      */
     template<typename T>
     std::shared_ptr<T> GetPrivate() const HAL_NOEXCEPT;
-    
+
+    /*!
+     @method
+
+     @abstract Return a pointer to this object's private data without
+     sharing ownership of this object.
+
+     @discussion Unlike GetPrivate<T>, this doesn't allocate. The
+     pointer is valid only while this object's JavaScript object is
+     reachable, for example while this JSObject exists.
+
+     @result A T* to this object's private data if the object has
+     private data of type T*, otherwise nullptr.
+     */
+    template<typename T>
+    T* GetPrivatePointer() const HAL_NOEXCEPT;
+
     
     virtual ~JSObject()            HAL_NOEXCEPT;
     JSObject(const JSObject&)      HAL_NOEXCEPT;
@@ -344,9 +473,19 @@ namespace HAL {
     JSObject& operator=(JSObject);
     void swap(JSObject&)           HAL_NOEXCEPT;
     
+    /*!
+     @method
+
+     @abstract Return the JavaScript object whose private data is the
+     given native object created by JSExport, or a JSError if it has
+     none, for example because it has been finalized, or if the
+     private data isn't a JSExportObject created by JSExport.
+
+     @discussion This is the same as calling get_object on the
+     JSExportObject.
+     */
     static JSObject FindJSObjectFromPrivateData(JSContext js_context, void* private_data);
-    static void     UnRegisterPrivateData(void* private_data);
-    static void     RegisterPrivateData(JSObjectRef js_object_ref, void* private_data);
+
     // The JSExportClass static functions also need access to
     // GetPrivate and SetPrivate.
     template<typename T>
@@ -359,6 +498,15 @@ namespace HAL {
     explicit operator JSObjectRef() const HAL_NOEXCEPT {
       return js_object_ref__;
     }
+    
+    /*!
+     @method
+     
+     @abstract Return the number of JSObjects that hold a reference to
+     a JavaScriptCore object. The object is protected from garbage
+     collection by HAL while the count is greater than 0.
+     */
+    static std::size_t GetReferenceCount(JSObjectRef js_object_ref) HAL_NOEXCEPT;
      
   protected:
   
@@ -383,6 +531,11 @@ namespace HAL {
      JavaScript exception.
      */
     virtual JSValue CallAsFunction(const std::vector<JSValue>&  arguments, JSObject this_object);
+    
+    // Call this JavaScript object as a function or constructor with an
+    // array of arguments, and return the unprotected result.
+    JSValueRef  CallWithArray(JSObjectRef this_object_ref, std::size_t argument_count, const JSValueRef arguments_array[]);
+    JSObjectRef ConstructWithArray(std::size_t argument_count, const JSValueRef arguments_array[]);
 
     /*!
      @method
@@ -446,8 +599,7 @@ namespace HAL {
 #pragma warning(push)
 #pragma warning(disable: 4251)
     JSObjectRef js_object_ref__;
-    static std::unordered_map<std::intptr_t, std::tuple<std::intptr_t, std::size_t>> js_object_ref_to_js_context_ref_map__;
-    static std::unordered_map<std::intptr_t, std::intptr_t> js_private_data_to_js_object_ref_map__;
+    static detail::JSHandleRegistry js_object_handle_registry__;
 #pragma warning(pop)
 
 #undef  HAL_JSOBJECT_LOCK_GUARD
@@ -470,9 +622,17 @@ namespace HAL {
   
   template<typename T>
   std::shared_ptr<T> JSObject::GetPrivate() const HAL_NOEXCEPT {
-    return std::shared_ptr<T>(std::make_shared<JSObject>(*this), dynamic_cast<T*>(static_cast<JSExportObject*>(GetPrivate())));
+    return std::shared_ptr<T>(std::make_shared<JSObject>(*this), GetPrivatePointer<T>());
+  }
+  
+  template<typename T>
+  T* JSObject::GetPrivatePointer() const HAL_NOEXCEPT {
+    return detail::JSExportCast<T>(static_cast<JSContextRef>(js_context__), js_object_ref__);
   }
   
 } // namespace HAL {
 
+// Call and Construct are defined with the conversions they use.
+#include "HAL/detail/JSNativeBinding.hpp"
+
 #endif // _HAL_JSOBJECT_HPP_
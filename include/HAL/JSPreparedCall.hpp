@@ -0,0 +1,152 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSPREPAREDCALL_HPP_
+#define _HAL_JSPREPAREDCALL_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/detail/JSNativeBinding.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSPreparedCall is a JavaScript function bound to a
+   'this' object, for calling the same function from C++ many times,
+   such as a callback that is invoked for every frame or message.
+
+   The function is checked once when the JSPreparedCall is created.
+   Invoke converts its C++ arguments directly into a JSValueRef array
+   on the stack, using the same conversions as the native functions
+   created by JSContext::CreateFunction, so a call allocates nothing
+   for its arguments. Apply reuses an argument buffer that is reserved
+   for the given arity.
+
+   InvokeDiscardingResult doesn't wrap the result in a JSValue, so the
+   result is never protected.
+
+   A JSPreparedCall is not thread safe.
+   */
+  class HAL_EXPORT JSPreparedCall final {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Bind a function and the 'this' object to call it with.
+
+     @param function The JavaScript function to call.
+
+     @param this_object The object to use as 'this' in the call.
+
+     @param arity The number of arguments that Apply is expected to
+     pass, for which the argument buffer is reserved.
+
+     @throws std::invalid_argument if function is not a function.
+     */
+    JSPreparedCall(const JSObject& function, const JSObject& this_object, std::size_t arity = 0);
+
+    /*!
+     @method
+
+     @abstract Bind a function to call with the global object as
+     'this'.
+
+     @throws std::invalid_argument if function is not a function.
+     */
+    explicit JSPreparedCall(const JSObject& function, std::size_t arity = 0);
+
+    JSObject get_function() const HAL_NOEXCEPT {
+      return function__;
+    }
+
+    JSObject get_this_object() const HAL_NOEXCEPT {
+      return this_object__;
+    }
+
+    /*!
+     @method
+
+     @abstract Call the function with the given C++ arguments and
+     return its result.
+
+     @discussion The arguments may be of any type that a native
+     function created by JSContext::CreateFunction can return, and
+     string literals.
+
+     @throws std::runtime_error if the function threw a JavaScript
+     exception.
+     */
+    template<typename... Args>
+    JSValue Invoke(Args&&... arguments) {
+      return JSValue(js_context__, Call(std::forward<Args>(arguments)...));
+    }
+
+    /*!
+     @method
+
+     @abstract Call the function with the given C++ arguments and
+     ignore its result, without protecting it.
+
+     @throws std::runtime_error if the function threw a JavaScript
+     exception.
+     */
+    template<typename... Args>
+    void InvokeDiscardingResult(Args&&... arguments) {
+      Call(std::forward<Args>(arguments)...);
+    }
+
+    /*!
+     @method
+
+     @abstract Call the function with a list of arguments and return
+     its result.
+
+     @throws std::runtime_error if the function threw a JavaScript
+     exception.
+     */
+    JSValue Apply(const std::vector<JSValue>& arguments);
+
+  private:
+
+    template<typename... Args>
+    JSValueRef Call(Args&&... arguments) {
+      const auto js_context_ref = static_cast<JSContextRef>(js_context__);
+      // The extra element keeps the array non-empty when there are
+      // no arguments.
+      const JSValueRef arguments_array[] = { detail::JSNativeToJS<Args>::type::ToJS(js_context_ref, arguments)..., nullptr };
+      return CallWithArray(sizeof...(Args), arguments_array);
+    }
+
+    JSValueRef CallWithArray(std::size_t argument_count, const JSValueRef arguments_array[]);
+
+    JSContext   js_context__;
+    JSObject    function__;
+    JSObject    this_object__;
+    JSObjectRef function_ref__;
+    JSObjectRef this_object_ref__;
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    std::vector<JSValueRef> arguments__;
+#pragma warning(pop)
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSPREPAREDCALL_HPP_
@@ -0,0 +1,170 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSPROPERTYKEY_HPP_
+#define _HAL_JSPROPERTYKEY_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSString.hpp"
+
+#include <string>
+#include <cstddef>
+#include <functional>
+
+namespace HAL {
+  
+  /*!
+   @class
+   
+   @discussion A JSPropertyKey is an interned JavaScript property
+   name. All JSPropertyKeys with the same name share one JSStringRef
+   from a process-wide atom table, which keeps it alive for the
+   lifetime of the process.
+   
+   Creating a JSPropertyKey transcodes and hashes its name once, so
+   create them ahead of time (e.g. as function-local statics) for
+   property names used on hot paths. Copying a JSPropertyKey and
+   passing it to JSObject::GetProperty, SetProperty, HasProperty and
+   DeleteProperty does no transcoding and no allocation.
+   
+   Well-known property names such as "length" and "message" are
+   interned when the atom table is created and are available from
+   the static member functions of this class.
+   */
+  class HAL_EXPORT JSPropertyKey final HAL_PERFORMANCE_COUNTER1(JSPropertyKey) {
+    
+  public:
+    
+    /*!
+     @method
+     
+     @abstract Return the interned property key for a null-terminated
+     UTF-8 string.
+     
+     @param name The property's name.
+     
+     @result The interned property key for name.
+     */
+    explicit JSPropertyKey(const char* name) HAL_NOEXCEPT;
+    
+    /*!
+     @method
+     
+     @abstract Return the interned property key for a UTF-8 encoded
+     std::string.
+     
+     @param name The property's name.
+     
+     @result The interned property key for name.
+     */
+    explicit JSPropertyKey(const std::string& name) HAL_NOEXCEPT;
+    
+    /*!
+     @method
+     
+     @abstract Return the interned property key for a JavaScript
+     string.
+     
+     @param name The property's name.
+     
+     @result The interned property key for name.
+     */
+    explicit JSPropertyKey(const JSString& name) HAL_NOEXCEPT;
+    
+    /*!
+     @method
+     
+     @abstract Convert this property key to a JavaScript string. This
+     only retains the interned JSStringRef.
+     
+     @result A JavaScript string containing this property key's name.
+     */
+    operator JSString() const HAL_NOEXCEPT {
+      return JSString(js_string_ref__);
+    }
+    
+    /*!
+     @method
+     
+     @abstract Convert this property key to a UTF-8 encoded
+     std::string.
+     
+     @result This property key's name as a UTF-8 encoded std::string.
+     */
+    explicit operator std::string() const HAL_NOEXCEPT {
+      return static_cast<std::string>(JSString(js_string_ref__));
+    }
+    
+    // Well-known property names, which are interned when the atom
+    // table is created.
+    static const JSPropertyKey& Array()       HAL_NOEXCEPT;
+    static const JSPropertyKey& Constructor() HAL_NOEXCEPT;
+    static const JSPropertyKey& Error()       HAL_NOEXCEPT;
+    static const JSPropertyKey& FileName()    HAL_NOEXCEPT;
+    static const JSPropertyKey& IsArray()     HAL_NOEXCEPT;
+    static const JSPropertyKey& Length()      HAL_NOEXCEPT;
+    static const JSPropertyKey& LineNumber()  HAL_NOEXCEPT;
+    static const JSPropertyKey& Message()     HAL_NOEXCEPT;
+    static const JSPropertyKey& Name()        HAL_NOEXCEPT;
+    static const JSPropertyKey& NativeStack() HAL_NOEXCEPT;
+    static const JSPropertyKey& Prototype()   HAL_NOEXCEPT;
+    static const JSPropertyKey& Stack()       HAL_NOEXCEPT;
+    
+    ~JSPropertyKey()                               = default;
+    JSPropertyKey(const JSPropertyKey&)            = default;
+    JSPropertyKey& operator=(const JSPropertyKey&) = default;
+    
+    // For interoperability with the JavaScriptCore C API.
+    explicit operator JSStringRef() const HAL_NOEXCEPT {
+      return js_string_ref__;
+    }
+    
+  private:
+    
+    friend bool operator==(const JSPropertyKey& lhs, const JSPropertyKey& rhs) HAL_NOEXCEPT;
+    
+    JSStringRef js_string_ref__ { nullptr };
+  };
+  
+  // Return true if the two JSPropertyKeys are equal. Since property
+  // keys are interned this is a pointer comparison.
+  inline
+  bool operator==(const JSPropertyKey& lhs, const JSPropertyKey& rhs) HAL_NOEXCEPT {
+    return lhs.js_string_ref__ == rhs.js_string_ref__;
+  }
+  
+  // Return true if the two JSPropertyKeys are not equal.
+  inline
+  bool operator!=(const JSPropertyKey& lhs, const JSPropertyKey& rhs) HAL_NOEXCEPT {
+    return ! (lhs == rhs);
+  }
+  
+  inline
+  std::string to_string(const JSPropertyKey& js_property_key) {
+    return static_cast<std::string>(js_property_key);
+  }
+  
+} // namespace HAL {
+
+namespace std {
+  
+  using HAL::JSPropertyKey;
+  
+  template<>
+  struct hash<JSPropertyKey> {
+    using argument_type = JSPropertyKey;
+    using result_type   = std::size_t;
+    
+    result_type operator()(const argument_type& js_property_key) const {
+      return std::hash<JSStringRef>()(static_cast<JSStringRef>(js_property_key));
+    }
+  };
+  
+}  // namespace std
+
+#endif // _HAL_JSPROPERTYKEY_HPP_
@@ -0,0 +1,84 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSSPAN_HPP_
+#define _HAL_JSSPAN_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+#include <cassert>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSSpan is a view of a contiguous sequence of elements
+   that it doesn't own, in the manner of C++20's std::span. JSArrayBuffer
+   and JSTypedArray return their bytes and elements as a JSSpan.
+
+   A JSSpan of a JavaScript object's memory is valid only while the
+   JavaScript object is reachable, for example while the JSArrayBuffer
+   or JSTypedArray that returned it exists.
+   */
+  template<typename T>
+  class JSSpan final {
+
+  public:
+
+    typedef T           element_type;
+    typedef T*          iterator;
+    typedef std::size_t size_type;
+
+    JSSpan() HAL_NOEXCEPT = default;
+
+    JSSpan(T* data, std::size_t size) HAL_NOEXCEPT
+    : data__(data)
+    , size__(data ? size : 0) {
+    }
+
+    T* data() const HAL_NOEXCEPT {
+      return data__;
+    }
+
+    // Return the number of elements.
+    std::size_t size() const HAL_NOEXCEPT {
+      return size__;
+    }
+
+    std::size_t size_bytes() const HAL_NOEXCEPT {
+      return size__ * sizeof(T);
+    }
+
+    bool empty() const HAL_NOEXCEPT {
+      return size__ == 0;
+    }
+
+    T& operator[](std::size_t index) const HAL_NOEXCEPT {
+      assert(index < size__);
+      return data__[index];
+    }
+
+    iterator begin() const HAL_NOEXCEPT {
+      return data__;
+    }
+
+    iterator end() const HAL_NOEXCEPT {
+      return data__ + size__;
+    }
+
+  private:
+
+    T*          data__ { nullptr };
+    std::size_t size__ { 0 };
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSSPAN_HPP_
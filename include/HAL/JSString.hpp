@@ -17,8 +17,14 @@
 #include <cstddef>
 #include <vector>
 #include <utility>
+#include <memory>
 #include <mutex>
 
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#include <string_view>
+#define HAL_JSSTRING_STRING_VIEW_ENABLE
+#endif
+
 namespace HAL {
   class JSString;
 }
@@ -45,6 +51,11 @@ namespace HAL {
    Specifically, a JSString is comparable with an equivalence relation,
    provides a strict weak ordering, and provides a custom hash
    function.
+   
+   The UTF-8 representation and the hash value of a JSString are only
+   computed the first time they are asked for, so a JSString that is
+   only compared or passed back to JavaScriptCore holds nothing but its
+   JSStringRef.
    */
     class HAL_EXPORT JSString final HAL_PERFORMANCE_COUNTER1(JSString) {
       
@@ -85,6 +96,62 @@ namespace HAL {
        */
       JSString(const std::string& string) HAL_NOEXCEPT;
       
+      /*!
+       @method
+       
+       @abstract Create a JavaScript string from a buffer of UTF-16
+       code units without transcoding.
+       
+       @param string The UTF-16 code units to copy into the new
+       JSString.
+       
+       @param length The number of UTF-16 code units in string.
+       
+       @result A JSString containing string.
+       */
+      JSString(const char16_t* string, std::size_t length) HAL_NOEXCEPT;
+      
+      /*!
+       @method
+       
+       @abstract Create a JavaScript string from a null-terminated
+       UTF-16 string without transcoding.
+       
+       @param string The null-terminated UTF-16 string to copy into the
+       new JSString.
+       
+       @result A JSString containing string.
+       */
+      JSString(const char16_t* string) HAL_NOEXCEPT;
+      
+      /*!
+       @method
+       
+       @abstract Create a JavaScript string from a UTF-16 encoded
+       std::u16string without transcoding.
+       
+       @param string The UTF-16 string to copy into the new JSString.
+       
+       @result A JSString containing string.
+       */
+      JSString(const std::u16string& string) HAL_NOEXCEPT;
+      
+#ifdef HAL_JSSTRING_STRING_VIEW_ENABLE
+      /*!
+       @method
+       
+       @abstract Create a JavaScript string from a UTF-16 encoded
+       std::u16string_view without transcoding.
+       
+       @param string The UTF-16 string to copy into the new JSString.
+       
+       @result A JSString containing string.
+       */
+      JSString(std::u16string_view string) HAL_NOEXCEPT
+      : JSString(string.data(), string.size()) {
+      }
+#endif
+      
       /*!
        @method
        
@@ -128,6 +195,90 @@ namespace HAL {
        */
       operator std::string() const HAL_NOEXCEPT;
       
+      /*!
+       @method
+       
+       @abstract Convert this JavaScript string to a UTF-16 encoded
+       std::u16string.
+       
+       @result This JavaScript string converted to a UTF-16 encoded
+       std::u16string.
+       */
+      operator std::u16string() const HAL_NOEXCEPT;
+      
+      /*!
+       @method
+       
+       @abstract Return a pointer to the UTF-16 code units of this
+       JavaScript string. There are length() code units, and they are
+       not null-terminated.
+       
+       @discussion The code units are not copied if JavaScriptCore
+       stores the string as UTF-16. A string that JavaScriptCore stores
+       as 8-bit Latin-1, which is typical of strings created from ASCII
+       UTF-8, is upconverted to UTF-16 the first time it is asked for,
+       and that copy is kept by the underlying JSStringRef.
+       
+       The pointer is only valid for the lifetime of this JSString.
+       
+       @result A pointer to the UTF-16 code units of this JavaScript
+       string.
+       */
+      const char16_t* u16data() const HAL_NOEXCEPT;
+      
+      /*!
+       @method
+       
+       @abstract Return the UTF-8 representation of this JavaScript
+       string without copying it. It is transcoded the first time it is
+       asked for and shared by all copies of this JSString.
+       
+       @discussion The reference is only valid for the lifetime of this
+       JSString.
+       
+       @result The UTF-8 representation of this JavaScript string.
+       */
+      const std::string& utf8() const HAL_NOEXCEPT;
+      
+#ifdef HAL_JSSTRING_STRING_VIEW_ENABLE
+      /*!
+       @method
+       
+       @abstract Return a view of the UTF-16 code units of this
+       JavaScript string that is valid for the lifetime of this
+       JSString.
+       
+       @result A view of the UTF-16 code units of this JavaScript
+       string.
+       */
+      std::u16string_view u16string_view() const HAL_NOEXCEPT {
+        return std::u16string_view(u16data(), length());
+      }
+      
+      /*!
+       @method
+       
+       @abstract Return a view of the UTF-8 representation of this
+       JavaScript string that is valid for the lifetime of this
+       JSString.
+       
+       @result A view of the UTF-8 representation of this JavaScript
+       string.
+       */
+      std::string_view string_view() const HAL_NOEXCEPT {
+        return utf8();
+      }
+#endif
+      
+      /*!
+       @method
+       
+       @abstract Return the hash value of this JavaScript string, which
+       is computed from its UTF-8 representation the first time it is
+       asked for.
+       
+       @result The hash value of this JavaScript string.
+       */
       std::size_t hash_value() const;
       
       ~JSString()                   HAL_NOEXCEPT;
@@ -169,13 +320,18 @@ namespace HAL {
       friend void swap(JSString& first, JSString& second) HAL_NOEXCEPT;
       HAL_EXPORT friend bool operator==(const JSString& lhs, const JSString& rhs);
       
+      // Holds the values of this JavaScript string that are computed
+      // on demand. Copies of a JSString share the same cache since the
+      // underlying JSStringRef is immutable.
+      struct Cache;
+      Cache& get_cache() const HAL_NOEXCEPT;
+      
     // Silence 4251 on Windows since private member variables do not
     // need to be exported from a DLL.
 #pragma warning(push)
 #pragma warning(disable: 4251)
-      JSStringRef    js_string_ref__ { nullptr };
-      std::string    string__;
-      std::size_t    hash_value__;
+      JSStringRef            js_string_ref__ { nullptr };
+      std::shared_ptr<Cache> cache__;
 #pragma warning(pop)
       
 #undef HAL_JSSTRING_LOCK_GUARD
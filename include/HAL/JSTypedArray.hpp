@@ -0,0 +1,168 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSTYPEDARRAY_HPP_
+#define _HAL_JSTYPEDARRAY_HPP_
+
+#include "HAL/JSObject.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSSpan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace HAL { namespace detail {
+
+  // The JavaScript typed array type for each element type.
+  template<typename T>
+  struct JSTypedArrayTraits;
+
+  template<> struct JSTypedArrayTraits<std::int8_t>   { static const JSTypedArrayType type = kJSTypedArrayTypeInt8Array;    };
+  template<> struct JSTypedArrayTraits<std::uint8_t>  { static const JSTypedArrayType type = kJSTypedArrayTypeUint8Array;   };
+  template<> struct JSTypedArrayTraits<std::int16_t>  { static const JSTypedArrayType type = kJSTypedArrayTypeInt16Array;   };
+  template<> struct JSTypedArrayTraits<std::uint16_t> { static const JSTypedArrayType type = kJSTypedArrayTypeUint16Array;  };
+  template<> struct JSTypedArrayTraits<std::int32_t>  { static const JSTypedArrayType type = kJSTypedArrayTypeInt32Array;   };
+  template<> struct JSTypedArrayTraits<std::uint32_t> { static const JSTypedArrayType type = kJSTypedArrayTypeUint32Array;  };
+  template<> struct JSTypedArrayTraits<float>         { static const JSTypedArrayType type = kJSTypedArrayTypeFloat32Array; };
+  template<> struct JSTypedArrayTraits<double>        { static const JSTypedArrayType type = kJSTypedArrayTypeFloat64Array; };
+
+  // The non-template parts of JSTypedArray<T>. Each throws
+  // std::runtime_error if JavaScriptCore reports an exception.
+  HAL_EXPORT JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, std::size_t length);
+  HAL_EXPORT JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator);
+  HAL_EXPORT JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length);
+
+  // Throw std::invalid_argument unless js_object is a typed array of
+  // the given type.
+  HAL_EXPORT void CheckTypedArrayType(const JSObject& js_object, JSTypedArrayType type);
+
+  HAL_EXPORT void*       GetTypedArrayBytes(const JSObject& js_object)      HAL_NOEXCEPT;
+  HAL_EXPORT std::size_t GetTypedArrayLength(const JSObject& js_object)     HAL_NOEXCEPT;
+  HAL_EXPORT std::size_t GetTypedArrayByteOffset(const JSObject& js_object) HAL_NOEXCEPT;
+  HAL_EXPORT JSObject    GetTypedArrayBuffer(const JSObject& js_object);
+
+}} // namespace HAL { namespace detail {
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JavaScript typed array object whose elements are of
+   type T, which is one of int8_t, uint8_t, int16_t, uint16_t, int32_t,
+   uint32_t, float and double. For example a JSTypedArray<float> is a
+   Float32Array.
+
+   A JSTypedArray is created by the JSContext::CreateTypedArray member
+   functions, or from a JSObject that is a typed array of the matching
+   type.
+
+   Its elements are accessed directly through GetElements without any
+   copy.
+   */
+  template<typename T>
+  class JSTypedArray final : public JSObject {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a JSTypedArray from a JSObject that is a typed
+     array of the matching type.
+
+     @throws std::invalid_argument if the JSObject is not a typed
+     array of the matching type.
+     */
+    explicit JSTypedArray(const JSObject& js_object)
+    : JSObject(js_object) {
+      detail::CheckTypedArrayType(*this, detail::JSTypedArrayTraits<T>::type);
+    }
+
+    /*!
+     @method
+
+     @abstract Return the number of elements in this typed array.
+     */
+    std::size_t GetLength() const HAL_NOEXCEPT {
+      return detail::GetTypedArrayLength(*this);
+    }
+
+    /*!
+     @method
+
+     @abstract Return a view of the elements of this typed array.
+
+     @discussion The view refers to the typed array's memory, so it
+     sees changes made from JavaScript, and changes made through it
+     are seen by JavaScript. It is valid only while this typed array
+     is reachable.
+     */
+    JSSpan<T> GetElements() const HAL_NOEXCEPT {
+      return JSSpan<T>(static_cast<T*>(detail::GetTypedArrayBytes(*this)), GetLength());
+    }
+
+    /*!
+     @method
+
+     @abstract Return the offset in bytes of this typed array's first
+     element in its ArrayBuffer.
+     */
+    std::size_t GetByteOffset() const HAL_NOEXCEPT {
+      return detail::GetTypedArrayByteOffset(*this);
+    }
+
+    /*!
+     @method
+
+     @abstract Return the ArrayBuffer that holds this typed array's
+     elements.
+     */
+    JSArrayBuffer GetBuffer() const {
+      return JSArrayBuffer(detail::GetTypedArrayBuffer(*this));
+    }
+
+  private:
+
+    // Only a JSContext can create a JSTypedArray.
+    friend JSContext;
+
+    JSTypedArray(const JSContext& js_context, std::size_t length)
+    : JSObject(js_context, detail::MakeTypedArray(js_context, detail::JSTypedArrayTraits<T>::type, length)) {
+    }
+
+    JSTypedArray(const JSContext& js_context, T* elements, std::size_t length, const JSBytesDeallocator& deallocator)
+    : JSObject(js_context, detail::MakeTypedArray(js_context, detail::JSTypedArrayTraits<T>::type, elements, length * sizeof(T), deallocator)) {
+    }
+
+    JSTypedArray(const JSContext& js_context, const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length)
+    : JSObject(js_context, detail::MakeTypedArray(js_context, detail::JSTypedArrayTraits<T>::type, array_buffer, byte_offset, length)) {
+    }
+  };
+
+  template<typename T>
+  JSTypedArray<T> JSContext::CreateTypedArray(std::size_t length) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSTypedArray<T>(JSContext(js_global_context_ref__), length);
+  }
+
+  template<typename T>
+  JSTypedArray<T> JSContext::CreateTypedArray(T* elements, std::size_t length, const JSBytesDeallocator& deallocator) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSTypedArray<T>(JSContext(js_global_context_ref__), elements, length, deallocator);
+  }
+
+  template<typename T>
+  JSTypedArray<T> JSContext::CreateTypedArray(const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSTypedArray<T>(JSContext(js_global_context_ref__), array_buffer, byte_offset, length);
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSTYPEDARRAY_HPP_
@@ -11,6 +11,7 @@
 
 #include "HAL/detail/JSBase.hpp"
 #include "HAL/JSContext.hpp"
+#include "HAL/detail/JSHandleRegistry.hpp"
 
 #include <vector>
 #include <ostream>
@@ -327,6 +328,15 @@ namespace HAL {
       }
       return js_value_ref__;
     }
+    
+    /*!
+     @method
+     
+     @abstract Return the number of JSValues that hold a reference to
+     a JavaScriptCore value. The value is protected from garbage
+     collection by HAL while the count is greater than 0.
+     */
+    static std::size_t GetReferenceCount(JSValueRef js_value_ref) HAL_NOEXCEPT;
      
   protected:
     
@@ -360,7 +370,7 @@ namespace HAL {
 #pragma warning(push)
 #pragma warning(disable: 4251)
     JSValueRef js_value_ref__ { nullptr };
-    static std::unordered_map<std::intptr_t, std::size_t> js_value_retain_count_map__;
+    static detail::JSHandleRegistry js_value_handle_registry__;
 #pragma warning(pop)
     
 #undef  HAL_JSVALUE_LOCK_GUARD
@@ -0,0 +1,222 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_LOCAL_HPP_
+#define _HAL_LOCAL_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+
+#include <string>
+
+namespace HAL {
+
+  class HandleScope;
+  class JSString;
+  class JSPropertyKey;
+
+  template<typename T>
+  class Local;
+
+  /*!
+   @class
+
+   @discussion A Local<JSValue> is an unprotected handle to a
+   JavaScript value, owned by the HandleScope that created it.
+
+   Unlike a JSValue, creating or copying a Local<JSValue> neither calls
+   JSValueProtect nor touches the handle registry. The value is kept
+   alive by JavaScriptCore's conservative scan of the machine stack,
+   so a Local must live in an automatic variable within its
+   HandleScope. Convert it to a JSValue (see Escape) before storing it
+   on the heap or returning it from the scope.
+   */
+  template<>
+  class HAL_EXPORT Local<JSValue> final {
+
+  public:
+
+    // For interoperability with the JavaScriptCore C API.
+    Local(const HandleScope& handle_scope, JSValueRef js_value_ref) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Create a Local that refers to the same JavaScript value
+     as a JSValue, without protecting it again. The JSValue must
+     outlive the Local.
+     */
+    Local(const HandleScope& handle_scope, const JSValue& js_value) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return a protected JSValue referring to this value, so
+     that it can outlive its HandleScope.
+     */
+    JSValue Escape() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Convert this Local to a protected JSValue. Same as
+     Escape.
+     */
+    operator JSValue() const HAL_NOEXCEPT {
+      return Escape();
+    }
+
+    /*!
+     @method
+
+     @abstract Convert this value to a Local<JSObject>.
+
+     @throws std::runtime_error if this value is not an object.
+     */
+    explicit operator Local<JSObject>() const;
+
+    explicit operator JSString()    const;
+    explicit operator std::string() const;
+    explicit operator bool()        const HAL_NOEXCEPT;
+    explicit operator double()      const;
+    explicit operator int32_t()     const;
+    explicit operator uint32_t()    const;
+
+    JSValue::Type GetType()     const HAL_NOEXCEPT;
+    bool          IsUndefined() const HAL_NOEXCEPT;
+    bool          IsNull()      const HAL_NOEXCEPT;
+    bool          IsBoolean()   const HAL_NOEXCEPT;
+    bool          IsNumber()    const HAL_NOEXCEPT;
+    bool          IsString()    const HAL_NOEXCEPT;
+    bool          IsObject()    const HAL_NOEXCEPT;
+
+    const HandleScope& get_handle_scope() const HAL_NOEXCEPT {
+      return *handle_scope__;
+    }
+
+    // For interoperability with the JavaScriptCore C API.
+    explicit operator JSValueRef() const HAL_NOEXCEPT {
+      return js_value_ref__;
+    }
+
+  private:
+
+    // Prevent heap based objects.
+    static void * operator new(std::size_t);     // #1: To prevent allocation of scalar objects
+    static void * operator new [] (std::size_t); // #2: To prevent allocation of array of objects
+
+    const HandleScope* handle_scope__;
+    JSValueRef         js_value_ref__;
+  };
+
+  /*!
+   @class
+
+   @discussion A Local<JSObject> is an unprotected handle to a
+   JavaScript object, owned by the HandleScope that created it. The
+   values it returns are Locals in the same HandleScope. See
+   Local<JSValue> for the lifetime rules.
+   */
+  template<>
+  class HAL_EXPORT Local<JSObject> final {
+
+  public:
+
+    // For interoperability with the JavaScriptCore C API.
+    Local(const HandleScope& handle_scope, JSObjectRef js_object_ref) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Create a Local that refers to the same JavaScript
+     object as a JSObject, without protecting it again. The JSObject
+     must outlive the Local.
+     */
+    Local(const HandleScope& handle_scope, const JSObject& js_object) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return a protected JSObject referring to this object,
+     so that it can outlive its HandleScope.
+     */
+    JSObject Escape() const;
+
+    /*!
+     @method
+
+     @abstract Convert this Local to a protected JSObject. Same as
+     Escape.
+     */
+    operator JSObject() const {
+      return Escape();
+    }
+
+    /*!
+     @method
+
+     @abstract Convert this Local to a Local<JSValue> in the same
+     HandleScope.
+     */
+    operator Local<JSValue>() const HAL_NOEXCEPT {
+      return Local<JSValue>(*handle_scope__, js_object_ref__);
+    }
+
+    bool HasProperty(const JSPropertyKey& property_key) const HAL_NOEXCEPT;
+    bool HasProperty(const JSString& property_name)     const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return a property of this object without protecting
+     it.
+
+     @throws std::runtime_error if getting the property threw a
+     JavaScript exception.
+     */
+    Local<JSValue> GetProperty(const JSPropertyKey& property_key) const;
+    Local<JSValue> GetProperty(const JSString& property_name)     const;
+    Local<JSValue> GetProperty(unsigned property_index)           const;
+
+    /*!
+     @method
+
+     @abstract Set a property of this object.
+
+     @throws std::runtime_error if setting the property threw a
+     JavaScript exception.
+     */
+    void SetProperty(const JSPropertyKey& property_key, const Local<JSValue>& property_value);
+    void SetProperty(const JSString& property_name    , const Local<JSValue>& property_value);
+    void SetProperty(unsigned property_index          , const Local<JSValue>& property_value);
+
+    bool IsFunction() const HAL_NOEXCEPT;
+
+    const HandleScope& get_handle_scope() const HAL_NOEXCEPT {
+      return *handle_scope__;
+    }
+
+    // For interoperability with the JavaScriptCore C API.
+    explicit operator JSObjectRef() const HAL_NOEXCEPT {
+      return js_object_ref__;
+    }
+
+  private:
+
+    // Prevent heap based objects.
+    static void * operator new(std::size_t);     // #1: To prevent allocation of scalar objects
+    static void * operator new [] (std::size_t); // #2: To prevent allocation of array of objects
+
+    const HandleScope* handle_scope__;
+    JSObjectRef        js_object_ref__;
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_LOCAL_HPP_
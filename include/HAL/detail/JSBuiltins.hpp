@@ -0,0 +1,250 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSBUILTINS_HPP_
+#define _HAL_DETAIL_JSBUILTINS_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace HAL {
+  class JSContext;
+}
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion JSBuiltins caches the global object and the well-known
+   builtin objects of one global JavaScript execution context, so that
+   type checks such as JSObject::IsArray and JSObject::IsError don't
+   have to look them up through the global object every time.
+
+   The builtins are looked up the first time they are needed. They
+   are kept alive by a hidden, read-only and non-enumerable object on
+   the global object instead of being protected, since a protected
+   builtin would keep its global object alive forever. The JSBuiltins
+   is deleted when that object is finalized, so it lives exactly as
+   long as the global context, no matter how many JSContexts refer to
+   it. A builtin that doesn't exist in the context (for example
+   Promise in older JavaScriptCore releases) is cached as nullptr.
+
+   Because the builtins are looked up at most once, replacing e.g.
+   Array on the global object after its first use doesn't affect HAL's
+   type checks.
+   */
+  class HAL_EXPORT JSBuiltins final {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Return the builtins of a JSContext's global context,
+     looking them up if this is the first time they are needed. The
+     result remains valid for as long as the JSContext exists.
+     */
+    static const JSBuiltins& Get(const JSContext& js_context);
+
+    JSObjectRef get_global_object()        const HAL_NOEXCEPT { return global_object__;        }
+    JSObjectRef get_object_constructor()   const HAL_NOEXCEPT { return object_constructor__;   }
+    JSObjectRef get_function_constructor() const HAL_NOEXCEPT { return function_constructor__; }
+    JSObjectRef get_function_prototype()   const HAL_NOEXCEPT { return function_prototype__;   }
+    JSObjectRef get_array_constructor()    const HAL_NOEXCEPT { return array_constructor__;    }
+    JSObjectRef get_error_constructor()    const HAL_NOEXCEPT { return error_constructor__;    }
+    JSObjectRef get_date_constructor()     const HAL_NOEXCEPT { return date_constructor__;     }
+    JSObjectRef get_regexp_constructor()   const HAL_NOEXCEPT { return regexp_constructor__;   }
+    JSObjectRef get_promise_constructor()  const HAL_NOEXCEPT { return promise_constructor__;  }
+    JSObjectRef get_json_object()          const HAL_NOEXCEPT { return json_object__;          }
+
+    /*!
+     @method
+
+     @abstract Return true if a JavaScript object is an array, as
+     determined by the builtin Array.isArray.
+     */
+    bool IsArray(JSObjectRef js_object_ref) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return true if a JavaScript object is an instance of
+     the builtin Error constructor, or if the builtin
+     Object.prototype.toString reports it as "[object Error]".
+     */
+    bool IsError(JSObjectRef js_object_ref) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Define a read-only, non-deletable data property on a
+     JavaScript object using the builtin Object.defineProperty.
+
+     @discussion Unlike JSObjectSetProperty, this defines an own
+     property even if the object inherits a read-only property with
+     the same name.
+
+     @result true if the property was defined.
+     */
+    bool DefineConstantProperty(JSObjectRef js_object_ref, JSStringRef property_name_ref, JSValueRef js_value_ref, bool enumerable) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Record that a JSClass has done its one-time setup in
+     this context, such as installing its constant properties.
+
+     @result true if this is the first time the class was marked in
+     this context, in which case the caller should do the setup.
+     */
+    bool MarkClassInitialized(JSClassRef js_class_ref) const;
+
+    /*!
+     @method
+
+     @abstract Return the JavaScript object of a JSClass that was
+     recorded for a native key with SetWrapper in this context, or
+     nullptr if there is none or it has been garbage collected.
+     */
+    JSObjectRef FindWrapper(JSClassRef js_class_ref, const void* key) const;
+
+    /*!
+     @method
+
+     @abstract Record the JavaScript object of a JSClass for a native
+     key, replacing any object recorded for it before.
+
+     @discussion Where the context has WeakRef the object is held
+     through a WeakRef, so that it can still be garbage collected.
+     Otherwise it is kept alive until ForgetWrapper is called or the
+     global context is destroyed.
+     */
+    void SetWrapper(JSClassRef js_class_ref, const void* key, JSObjectRef js_object_ref) const;
+
+    /*!
+     @method
+
+     @abstract Forget the JavaScript object recorded for a native key,
+     if any.
+     */
+    void ForgetWrapper(JSClassRef js_class_ref, const void* key) const;
+
+    // The JavaScript functions that JSArray uses to move all the
+    // elements of an array across the C API at once.
+    enum class ArrayHelper {
+      // (typed_array, array): typed_array[i] = array[i].
+      CopyElements,
+      // (typed_array, array): typed_array[i] = array[i] ? 1 : 0.
+      CopyBooleans,
+      // (lengths, array): return the elements converted to strings
+      // and joined, with the length of each in lengths.
+      JoinStrings,
+      // (typed_array): return a new Array with the elements of
+      // typed_array.
+      FromTypedArray,
+      Count
+    };
+
+    /*!
+     @method
+
+     @abstract Return one of the helper functions used by JSArray,
+     compiling it the first time it is needed in this context.
+
+     @result The helper function, or nullptr if it couldn't be
+     compiled.
+     */
+    JSObjectRef GetArrayHelper(ArrayHelper helper) const HAL_NOEXCEPT;
+
+    JSBuiltins(const JSBuiltins&)            = delete;
+    JSBuiltins& operator=(const JSBuiltins&) = delete;
+
+  private:
+
+    explicit JSBuiltins(JSContextRef js_global_context_ref);
+    ~JSBuiltins() HAL_NOEXCEPT;
+
+    // The JSClass of the hidden object that owns a JSBuiltins as its
+    // private data, and deletes it when it is finalized.
+    static JSClassRef GetHolderClass();
+    static void JSObjectFinalizeCallback(JSObjectRef object_ref);
+
+    // Keep a JavaScript object alive as an indexed property of the
+    // hidden object, and return the index to pass to Drop when it is
+    // no longer needed.
+    unsigned Keep(JSObjectRef js_object_ref) const;
+    void     Drop(unsigned slot) const;
+
+    JSContextRef js_global_context_ref__;
+    JSObjectRef  holder__               { nullptr };
+    JSObjectRef  global_object__        { nullptr };
+    JSObjectRef  object_constructor__   { nullptr };
+    JSObjectRef  object_to_string__     { nullptr };
+    JSObjectRef  function_constructor__ { nullptr };
+    JSObjectRef  function_prototype__   { nullptr };
+    JSObjectRef  array_constructor__    { nullptr };
+    JSObjectRef  array_is_array__       { nullptr };
+    JSObjectRef  string_constructor__   { nullptr };
+    JSObjectRef  error_constructor__    { nullptr };
+    JSObjectRef  date_constructor__     { nullptr };
+    JSObjectRef  regexp_constructor__   { nullptr };
+    JSObjectRef  promise_constructor__  { nullptr };
+    JSObjectRef  json_object__          { nullptr };
+    JSObjectRef  object_define_property__ { nullptr };
+    JSObjectRef  weak_ref_constructor__ { nullptr };
+    JSObjectRef  weak_ref_deref__       { nullptr };
+    mutable JSObjectRef array_helpers__[static_cast<std::size_t>(ArrayHelper::Count)] { };
+    mutable unsigned    slot_count__ { 0 };
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    // The indices released by Drop, for Keep to reuse.
+    mutable std::vector<unsigned> free_slots__;
+
+    // The classes marked by MarkClassInitialized.
+    mutable std::unordered_set<JSClassRef> initialized_classes__;
+
+    typedef std::pair<JSClassRef, const void*> WrapperKey_t;
+
+    struct WrapperKeyHash {
+      std::size_t operator()(const WrapperKey_t& key) const HAL_NOEXCEPT {
+        return std::hash<const void*>()(key.second) ^ (std::hash<JSClassRef>()(key.first) << 1);
+      }
+    };
+
+    // An object recorded by SetWrapper, kept either itself or through
+    // a WeakRef to it.
+    struct Wrapper {
+      JSObjectRef js_object_ref;
+      unsigned    slot;
+      bool        weak;
+    };
+
+    mutable std::unordered_map<WrapperKey_t, Wrapper, WrapperKeyHash> wrappers__;
+#pragma warning(pop)
+
+#undef  HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC
+#ifdef  HAL_THREAD_SAFE
+    static std::recursive_mutex mutex_static__;
+#define HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC std::lock_guard<std::recursive_mutex> lock_static(JSBuiltins::mutex_static__)
+#else
+#define HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC
+#endif  // HAL_THREAD_SAFE
+  };
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSBUILTINS_HPP_
@@ -17,6 +17,7 @@ namespace HAL {
   class JSString;
   class JSObject;
   class JSPropertyNameAccumulator;
+  class JSArguments;
 }
 
 
@@ -106,6 +107,28 @@ namespace HAL { namespace detail {
   template<typename T>
   using CallNamedFunctionCallback = std::function<JSValue(T&, const std::vector<JSValue>&, JSObject&)>;
   
+  /*!
+   @typedef CallNamedFunctionArgumentsCallback
+   
+   @abstract The same as CallNamedFunctionCallback, except that the
+   arguments are passed as a JSArguments view of the JavaScriptCore
+   arguments array instead of being copied into a std::vector of
+   JSValues. Calling a function with this callback allocates nothing
+   for its arguments.
+   
+   @discussion For example, given this class definition:
+   
+   class Foo {
+   JSValue Hello(const JSArguments& arguments, JSObject& this_object);
+   };
+   
+   You would define the callback like this:
+   
+   CallNamedFunctionArgumentsCallback callback(&Foo::Hello);
+   */
+  template<typename T>
+  using CallNamedFunctionArgumentsCallback = std::function<JSValue(T&, const JSArguments&, JSObject&)>;
+  
   /*!
    @typedef HasPropertyCallback
    
@@ -308,6 +331,86 @@ namespace HAL { namespace detail {
   template<typename T>
   using GetPropertyNamesCallback = std::function<void(T&, JSPropertyNameAccumulator&)>;
   
+  /*!
+   @typedef GetIndexedPropertyCallback
+   
+   @abstract The callback to invoke when getting an array index
+   property below the length from your JavaScript object.
+   
+   For example, given this class definition:
+   
+   class Foo {
+   JSValue GetRow(std::uint32_t index);
+   };
+   
+   You would define the callback like this:
+   
+   GetIndexedPropertyCallback callback(&Foo::GetRow);
+   
+   @param 1 A non-const reference to the C++ object that implements
+   your JavaScript object.
+   
+   @param 2 The array index, which is below the length.
+   
+   @result The value at the array index.
+   */
+  template<typename T>
+  using GetIndexedPropertyCallback = std::function<JSValue(T&, std::uint32_t)>;
+  
+  /*!
+   @typedef SetIndexedPropertyCallback
+   
+   @abstract The callback to invoke when setting an array index
+   property on your JavaScript object.
+   
+   For example, given this class definition:
+   
+   class Foo {
+   bool SetRow(std::uint32_t index, const JSValue& value);
+   };
+   
+   You would define the callback like this:
+   
+   SetIndexedPropertyCallback callback(&Foo::SetRow);
+   
+   @param 1 A non-const reference to the C++ object that implements
+   your JavaScript object.
+   
+   @param 2 The array index, which may be at or above the length.
+   
+   @param 3 A const reference to the property's value.
+   
+   @result Return true if the value was set. Return false to set it
+   as an ordinary property of your JavaScript object.
+   */
+  template<typename T>
+  using SetIndexedPropertyCallback = std::function<bool(T&, std::uint32_t, const JSValue&)>;
+  
+  /*!
+   @typedef GetLengthCallback
+   
+   @abstract The callback to invoke when getting the number of array
+   index properties of your JavaScript object, which is also the value
+   of its length property.
+   
+   For example, given this class definition:
+   
+   class Foo {
+   std::uint32_t GetRowCount() const;
+   };
+   
+   You would define the callback like this:
+   
+   GetLengthCallback callback(&Foo::GetRowCount);
+   
+   @param 1 A const reference to the C++ object that implements your
+   JavaScript object.
+   
+   @result The number of array index properties.
+   */
+  template<typename T>
+  using GetLengthCallback = std::function<std::uint32_t(const T&)>;
+  
   /*!
    @typedef CallAsFunctionCallback
    
@@ -346,6 +449,17 @@ namespace HAL { namespace detail {
   template<typename T>
   using CallAsFunctionCallback = std::function<JSValue(T&, const std::vector<JSValue>&, JSObject&)>;
   
+  /*!
+   @typedef CallAsFunctionArgumentsCallback
+   
+   @abstract The same as CallAsFunctionCallback, except that the
+   arguments are passed as a JSArguments view of the JavaScriptCore
+   arguments array instead of being copied into a std::vector of
+   JSValues.
+   */
+  template<typename T>
+  using CallAsFunctionArgumentsCallback = std::function<JSValue(T&, const JSArguments&, JSObject&)>;
+  
   /*!
    @typedef ConvertToTypeCallback
    
@@ -19,21 +19,36 @@
 #include "HAL/JSNumber.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArguments.hpp"
 
 #include "HAL/detail/JSPropertyNameAccumulator.hpp"
+#include "HAL/detail/JSBuiltins.hpp"
+#include "HAL/detail/JSExportClassInfo.hpp"
+#include "HAL/detail/JSExportPool.hpp"
+#include "HAL/detail/JSNativeBinding.hpp"
 #include "HAL/detail/JSUtil.hpp"
 #include "HAL/detail/JSValueUtil.hpp"
 
 #include <string>
-#include <regex>
 #include <cstdint>
+#include <cstddef>
+#include <type_traits>
 #include <vector>
 #include <memory>
+#include <new>
 #include <utility>
 #include <typeinfo>
 #include <typeindex>
 #include <unordered_map>
 #include <list>
+#include <functional>
+
+// The number of named function properties per class that dispatch
+// through a dedicated per-slot callback. Named functions beyond this
+// limit fall back to a lookup by the function's name.
+#ifndef HAL_JSEXPORT_MAX_NAMED_FUNCTION_SLOTS
+#define HAL_JSEXPORT_MAX_NAMED_FUNCTION_SLOTS 64
+#endif
 
 namespace HAL {
   template<typename T>
@@ -76,7 +91,8 @@ namespace HAL { namespace detail {
     JSExportClass& operator=(JSExportClass&&)      = default;
 #endif
 
-    // Erase least-recently-used constant cache.
+    // Erase least-recently-used constant cache. Constants are cached
+    // per global context, and installed constants are not cached.
     // Making this public only for testing porpose.
     static void EvictCache();
     
@@ -90,6 +106,16 @@ namespace HAL { namespace detail {
     // Making this public only for testing porpose.
     static std::vector<std::string> GetCachedKeys();
 
+    // Returns the pool that the native objects of this class are
+    // allocated from if it uses pooled allocation.
+    static JSExportPool& GetPool();
+    
+    // Please see JSExport::WrapExisting.
+    static JSObject WrapExisting(const JSContext& js_context, const void* key, const std::function<void(T&)>& initialize);
+    
+    // Please see JSExport::ForgetWrapper.
+    static void ForgetWrapper(const JSContext& js_context, const void* key);
+
   private:
     
     void Print() const;
@@ -110,8 +136,24 @@ namespace HAL { namespace detail {
     static JSValueRef  GetNamedValuePropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception);
     static bool        SetNamedValuePropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef value_ref, JSValueRef* exception);
     
-    // Support for JSStaticFunction
+    // Support for JSStaticFunction. Each named function property is
+    // assigned a slot, and each slot has its own callback so that a
+    // call dispatches without having to recover the function's name.
+    template<std::size_t N>
+    static JSValueRef  CallNamedFunctionCallbackAt(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
     static JSValueRef  CallNamedFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+    static JSValueRef  CallNamedFunction(const JSExportNamedFunctionPropertyCallback<T>& named_function_property_callback, JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+    static ::JSObjectCallAsFunctionCallback GetCallNamedFunctionCallback(std::size_t slot) HAL_NOEXCEPT;
+    
+    template<std::size_t N>
+    static void InitializeCallNamedFunctionCallbacks(::JSObjectCallAsFunctionCallback* callbacks, std::integral_constant<std::size_t, N>) HAL_NOEXCEPT;
+    static void InitializeCallNamedFunctionCallbacks(::JSObjectCallAsFunctionCallback* callbacks, std::integral_constant<std::size_t, 0>) HAL_NOEXCEPT;
+    
+    // Support for JSStaticFunction bound to a pointer to member
+    // function at compile-time. The callback converts the arguments
+    // directly into the member function's parameter types.
+    template<typename M, M method>
+    static JSValueRef  CallBoundFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
     
     // JavaScriptCore C API callback interface.
     static void        JSObjectInitializeCallback(JSContextRef context_ref, JSObjectRef object_ref);
@@ -126,16 +168,51 @@ namespace HAL { namespace detail {
     static bool        JSObjectHasInstanceCallback(JSContextRef context_ref, JSObjectRef constructor_ref, JSValueRef possible_instance_ref, JSValueRef* exception);
     static JSValueRef  JSObjectConvertToTypeCallback(JSContextRef context_ref, JSObjectRef object_ref, JSType type, JSValueRef* exception);
     
+    // Allocate and destroy the native object of a JavaScript object.
+    static T*   CreateNativeObject(const JSContext& js_context);
+    static void DestroyNativeObject(void* native_object_ptr) HAL_NOEXCEPT;
+    
+    // Set the pointer from a native object back to its JavaScript
+    // object, if it is a JSExportObject. These are templates so that
+    // the member access waits until JSExportObject is complete.
+    template<typename U>
+    static typename std::enable_if<std::is_base_of<JSExportObject, U>::value>::type SetJSObjectRef(U* native_object_ptr, JSObjectRef object_ref) HAL_NOEXCEPT;
+    template<typename U>
+    static typename std::enable_if<!std::is_base_of<JSExportObject, U>::value>::type SetJSObjectRef(U* native_object_ptr, JSObjectRef object_ref) HAL_NOEXCEPT;
+    
+    // Evaluate the constants that are installed on the prototype and
+    // define them there, the first time an object of this class is
+    // initialized in a global context.
+    static void InstallPrototypeConstants(const JSObject& js_object, T& native_object);
+    
     // Helper functions.
-    static JSValue CreateJSError(const std::string& function_name, const std::string& location, JSObject js_object, const js_runtime_error& e);
-    static JSValue CreateJSError(const std::string& function_name, JSObject js_object, const std::exception& e);
-    static JSValue CreateJSError(const std::string& function_name, JSObject js_object, const std::string& what);
+    static JSValue CreateJSError(const std::string& function_name, const std::string& location, JSContextRef context_ref, const js_runtime_error& e);
+    static JSValue CreateJSError(const std::string& function_name, JSContextRef context_ref, const std::exception& e);
+    static JSValue CreateJSError(const std::string& function_name, JSContextRef context_ref, const std::string& what);
     static std::string GetJSExportComponentName(const std::string& function_name, const std::string& location = "");
     
+    // A cached constant is keyed by the global context it was
+    // evaluated in and its name.
+    typedef std::pair<JSContextRef, std::string> ConstantsCacheKey_t;
+    
+    struct ConstantsCacheKeyHash {
+      std::size_t operator()(const ConstantsCacheKey_t& key) const HAL_NOEXCEPT {
+        return std::hash<std::string>()(key.second) ^ (std::hash<JSContextRef>()(key.first) << 1);
+      }
+    };
+    
+    // The cached constants in Most-Recently-Used order, and an index
+    // into them so that a lookup, a refresh and an eviction are all
+    // O(1).
+    typedef std::list<std::pair<ConstantsCacheKey_t, JSValue>> ConstantsCacheList_t;
+    typedef std::unordered_map<ConstantsCacheKey_t, typename ConstantsCacheList_t::iterator, ConstantsCacheKeyHash> ConstantsCacheMap_t;
+    
     static JSExportClassDefinition<T> js_export_class_definition__;
-    static std::unordered_map<std::string, JSValue> constants_cache__;
-    static std::list<std::string>                   constants_cache_history__;
-    static std::uint32_t                            constants_cache_capacity__;
+    static JSClassRef                 js_export_class_ref__;
+    static const JSExportClassInfo*   js_export_class_info__;
+    static ConstantsCacheList_t       constants_cache_list__;
+    static ConstantsCacheMap_t        constants_cache__;
+    static std::uint32_t              constants_cache_capacity__;
     
 #undef HAL_DETAIL_JSEXPORTCLASS_LOCK_GUARD_STATIC
 #ifdef HAL_THREAD_SAFE
@@ -155,10 +232,16 @@ namespace HAL { namespace detail {
   JSExportClassDefinition<T> JSExportClass<T>::js_export_class_definition__;
 
   template<typename T>
-  std::unordered_map<std::string, JSValue> JSExportClass<T>::constants_cache__;
+  JSClassRef JSExportClass<T>::js_export_class_ref__ { nullptr };
 
   template<typename T>
-  std::list<std::string> JSExportClass<T>::constants_cache_history__;
+  const JSExportClassInfo* JSExportClass<T>::js_export_class_info__ { nullptr };
+
+  template<typename T>
+  typename JSExportClass<T>::ConstantsCacheList_t JSExportClass<T>::constants_cache_list__;
+
+  template<typename T>
+  typename JSExportClass<T>::ConstantsCacheMap_t JSExportClass<T>::constants_cache__;
 
   //
   // Constants cache capacity
@@ -178,6 +261,14 @@ namespace HAL { namespace detail {
     HAL_DETAIL_JSEXPORTCLASS_LOCK_GUARD_STATIC;
     HAL_LOG_TRACE("JSExportClass<", typeid(T).name(), ">:: ctor 2 ", this);
     js_export_class_definition__ = js_export_class_definition;
+    js_export_class_ref__        = static_cast<JSClassRef>(*this);
+    
+    // The class info is never destroyed, since the native objects
+    // created with it may still be finalized during static
+    // destruction.
+    js_export_class_info__       = new JSExportClassInfo(DestroyNativeObject, js_export_class_ref__, js_export_class_definition.js_class_definition__.parentClass, std::is_base_of<JSExportObject, T>::value);
+    JSExportClassId<T>::value        = js_export_class_info__->get_id();
+    JSExportClassId<T>::js_class_ref = js_export_class_ref__;
     //js_export_class_definition__.Print();
   }
   
@@ -211,62 +302,178 @@ namespace HAL { namespace detail {
     JSObject js_object(JSContext(context_ref), object_ref);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::Initialize: JSContextRef = ", context_ref, ", JSObjectRef = ", object_ref);
 
-    const auto previous_native_object_ptr = static_cast<JSExport<T>*>(js_object.GetPrivate());
-    const auto native_object_ptr          = new T(js_object.get_context());
+    // The previous native object was created by the initialize
+    // callback of a parent class, so it isn't necessarily a T.
+    const auto previous_native_object_ptr = js_object.GetPrivate();
+    const auto native_object_ptr          = CreateNativeObject(js_object.get_context());
     
     if (previous_native_object_ptr != nullptr) {
       HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::Initialize: replace ", previous_native_object_ptr, " with ", native_object_ptr, " for ", object_ref);
-      delete previous_native_object_ptr;
+      JSExportPool::Destroy(previous_native_object_ptr);
     }
     
     const bool result = js_object.SetPrivate(native_object_ptr);
+    SetJSObjectRef(native_object_ptr, object_ref);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::Initialize: private data set to ", js_object.GetPrivate(), " for ", object_ref);
     
     native_object_ptr->postInitialize(js_object);
     
     assert(result);
+    
+    if (!js_export_class_definition__.named_prototype_constant_callbacks__.empty()) {
+      InstallPrototypeConstants(js_object, *native_object_ptr);
+    }
+  }
+  
+  template<typename T>
+  void JSExportClass<T>::InstallPrototypeConstants(const JSObject& js_object, T& native_object) {
+    const auto& js_context = js_object.get_context();
+    const auto& builtins   = JSBuiltins::Get(js_context);
+    if (!js_export_class_ref__ || !builtins.MarkClassInitialized(js_export_class_ref__)) {
+      return;
+    }
+    
+    // The object being initialized doesn't have its prototype yet,
+    // but a constructor for the class finds the same automatically
+    // generated prototype without creating an object.
+    const auto  context_ref        = static_cast<JSContextRef>(js_context);
+    const auto  constructor_ref    = JSObjectMakeConstructor(context_ref, js_export_class_ref__, nullptr);
+    JSStringRef prototype_name_ref = JSStringCreateWithUTF8CString("prototype");
+    const auto  prototype_ref      = JSObjectGetProperty(context_ref, constructor_ref, prototype_name_ref, nullptr);
+    JSStringRelease(prototype_name_ref);
+    if (!prototype_ref || !JSValueIsObject(context_ref, prototype_ref)) {
+      HAL_LOG_ERROR("JSExportClass<", typeid(T).name(), ">::InstallPrototypeConstants: class has no prototype");
+      return;
+    }
+    
+    const auto prototype_object_ref = JSValueToObject(context_ref, prototype_ref, nullptr);
+    for (const auto& constant_callback : js_export_class_definition__.named_prototype_constant_callbacks__) {
+      const auto& property_name = constant_callback.get_name();
+      const auto& attributes    = constant_callback.get_attributes();
+      const bool  enumerable    = attributes.find(JSPropertyAttribute::DontEnum) == attributes.end();
+      try {
+        const auto& callback = constant_callback.get_callback();
+        const auto  result   = callback(native_object);
+        if (!builtins.DefineConstantProperty(prototype_object_ref, static_cast<JSStringRef>(JSString(property_name)), static_cast<JSValueRef>(result), enumerable)) {
+          HAL_LOG_ERROR("JSExportClass<", typeid(T).name(), ">::InstallPrototypeConstants: failed to define ", property_name);
+        }
+      } catch (const std::exception& e) {
+        HAL_LOG_ERROR("JSExportClass<", typeid(T).name(), ">::InstallPrototypeConstants: ", property_name, " threw ", e.what());
+      }
+    }
   }
   
   template<typename T>
   void JSExportClass<T>::JSObjectFinalizeCallback(JSObjectRef object_ref) {
     HAL_DETAIL_JSEXPORTCLASS_LOCK_GUARD_STATIC;
     
-    auto native_object_ptr = static_cast<JSExport<T>*>(JSObjectGetPrivate(object_ref));
+    auto native_object_ptr = JSObjectGetPrivate(object_ref);
     
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::Finalize: delete native object ", native_object_ptr, " for ", object_ref);
     if (native_object_ptr) {
-      //delete reinterpret_cast<T*>(native_object_ptr);
-      delete native_object_ptr;
+      // The most derived class is finalized first, so the native
+      // object is a T.
+      SetJSObjectRef(static_cast<T*>(native_object_ptr), nullptr);
+      JSExportPool::Destroy(native_object_ptr);
       JSObjectSetPrivate(object_ref, nullptr);
     }
   }
   
+  template<typename T>
+  JSExportPool& JSExportClass<T>::GetPool() {
+    // The pool is never destroyed, since JavaScript objects may still
+    // be finalized during static destruction.
+    static JSExportPool* pool = new JSExportPool(sizeof(T), std::alignment_of<T>::value);
+    return *pool;
+  }
+  
+  template<typename T>
+  T* JSExportClass<T>::CreateNativeObject(const JSContext& js_context) {
+    // precondition
+    assert(js_export_class_info__);
+    
+    const auto& class_info = *js_export_class_info__;
+    void* storage = js_export_class_definition__.pooled_allocation__ ? GetPool().Allocate(class_info) : JSExportPool::AllocateUnpooled(sizeof(T), class_info);
+    try {
+      return new (storage) T(js_context);
+    } catch (...) {
+      JSExportPool::Deallocate(storage);
+      throw;
+    }
+  }
+  
+  template<typename T>
+  void JSExportClass<T>::DestroyNativeObject(void* native_object_ptr) HAL_NOEXCEPT {
+    static_cast<T*>(native_object_ptr)->~T();
+  }
+  
+  template<typename T>
+  template<typename U>
+  typename std::enable_if<std::is_base_of<JSExportObject, U>::value>::type JSExportClass<T>::SetJSObjectRef(U* native_object_ptr, JSObjectRef object_ref) HAL_NOEXCEPT {
+    native_object_ptr->js_object_ref__ = object_ref;
+  }
+  
+  template<typename T>
+  template<typename U>
+  typename std::enable_if<!std::is_base_of<JSExportObject, U>::value>::type JSExportClass<T>::SetJSObjectRef(U*, JSObjectRef) HAL_NOEXCEPT {
+  }
+  
+  template<typename T>
+  JSObject JSExportClass<T>::WrapExisting(const JSContext& js_context, const void* key, const std::function<void(T&)>& initialize) {
+    HAL_DETAIL_JSEXPORTCLASS_LOCK_GUARD_STATIC;
+    
+    const auto& builtins      = JSBuiltins::Get(js_context);
+    const auto  js_object_ref = builtins.FindWrapper(js_export_class_ref__, key);
+    if (js_object_ref) {
+      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::WrapExisting: found ", js_object_ref, " for ", key);
+      return JSObject(js_context, js_object_ref);
+    }
+    
+    auto js_object = js_context.CreateObject(JSExport<T>::Class());
+    const auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    if (initialize) {
+      initialize(*native_object_ptr);
+    }
+    
+    builtins.SetWrapper(js_export_class_ref__, key, static_cast<JSObjectRef>(js_object));
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::WrapExisting: created ", static_cast<JSObjectRef>(js_object), " for ", key);
+    
+    return js_object;
+  }
+  
+  template<typename T>
+  void JSExportClass<T>::ForgetWrapper(const JSContext& js_context, const void* key) {
+    HAL_DETAIL_JSEXPORTCLASS_LOCK_GUARD_STATIC;
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::ForgetWrapper: ", key);
+    JSBuiltins::Get(js_context).ForgetWrapper(js_export_class_ref__, key);
+  }
+  
   template<typename T>
   void JSExportClass<T>::EvictCache() {
-    assert(!constants_cache_history__.empty());
-    const auto least_cache_key = constants_cache_history__.front();
-    constants_cache_history__.pop_front();
-    constants_cache__.erase(least_cache_key);
+    assert(!constants_cache_list__.empty());
+    constants_cache__.erase(constants_cache_list__.back().first);
+    constants_cache_list__.pop_back();
   }
 
   template<typename T>
   void JSExportClass<T>::EvictAllCache() {
-    constants_cache_history__.clear();
-    constants_cache__.clear();    
+    constants_cache__.clear();
+    constants_cache_list__.clear();
   }
 
   template<typename T>
   void JSExportClass<T>::ResizeCache(const std::uint32_t& maxSize) {
-    constants_cache_history__.clear();
-    constants_cache__.clear();    
+    constants_cache__.clear();
+    constants_cache_list__.clear();
     constants_cache_capacity__ = maxSize;
   }
 
   template<typename T>
   std::vector<std::string> JSExportClass<T>::GetCachedKeys() {
     std::vector<std::string> keys;
-    for (auto it = constants_cache_history__.rbegin(); it != constants_cache_history__.rend(); ++it) {
-      keys.push_back(*it);
+    keys.reserve(constants_cache_list__.size());
+    for (const auto& entry : constants_cache_list__) {
+      keys.push_back(entry.first.second);
     }
     return keys;
   }
@@ -274,179 +481,238 @@ namespace HAL { namespace detail {
   template<typename T>
   JSValueRef JSExportClass<T>::GetNamedValuePropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
+    // A getter only needs the native object, so neither a JSContext
+    // nor a JSObject is created unless it throws.
+    const auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
     
-    const std::string property_name = JSString(property_name_ref);
+    const auto callback_index = js_export_class_definition__.named_value_property_table__.Find(property_name_ref);
+    const bool callback_found = callback_index != JSPropertyNameTable::npos;
     
-    const auto callback_position = js_export_class_definition__.named_value_property_callback_map__.find(property_name);
-    const bool callback_found    = callback_position != js_export_class_definition__.named_value_property_callback_map__.end();
-    
-    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: callback found = ", callback_found, " for ", to_string(js_object), ".", property_name);
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", JSString(property_name_ref));
     
     // precondition
     assert(callback_found);
     
+    const auto& named_value_property_callback = js_export_class_definition__.named_value_property_callbacks__[callback_index];
+    
     try {
 
       // check if it's a constant
-      const auto constant_position = js_export_class_definition__.named_constants__.find(property_name);
-      const bool constant_found    = constant_position != js_export_class_definition__.named_constants__.end();
+      const bool constant_found = js_export_class_definition__.named_value_property_constants__[callback_index];
+      const ConstantsCacheKey_t cache_key = constant_found ? ConstantsCacheKey_t(JSContextGetGlobalContext(context_ref), named_value_property_callback.get_name()) : ConstantsCacheKey_t();
       if (constant_found) {
 
-        HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: constant found = ", constant_found, " for ", to_string(js_object), ".", property_name);
+        HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: constant found = ", constant_found, " for this[", native_object_ptr, "].", cache_key.second);
 
         // check if it's cached
-        const auto cache_position = constants_cache__.find(property_name);
+        const auto cache_position = constants_cache__.find(cache_key);
         const bool cache_found    = cache_position != constants_cache__.end();
 
         // if it's cached, we just use it
         if (cache_found) {
-          HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: constant cache found = ", constant_found, " for ", to_string(js_object), ".", property_name);
+          HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: constant cache found = ", constant_found, " for this[", native_object_ptr, "].", cache_key.second);
 
           //
           // update LRU cache access history
           //
-          const auto cache_history_position = std::find(constants_cache_history__.begin(), constants_cache_history__.end(), property_name);
-          assert(cache_history_position != constants_cache_history__.end());
-          constants_cache_history__.splice(constants_cache_history__.end(), constants_cache_history__, cache_history_position);
+          constants_cache_list__.splice(constants_cache_list__.begin(), constants_cache_list__, cache_position->second);
 
-          return static_cast<JSValueRef>(constants_cache__.at(property_name));
+          return static_cast<JSValueRef>(cache_position->second->second);
         } 
       }
 
-      auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
-      const auto callback          = (callback_position -> second).get_callback();
-      const auto result            = callback(*native_object_ptr);
+      if (!native_object_ptr) {
+        ThrowRuntimeError(GetJSExportComponentName("GetNamedProperty", named_value_property_callback.get_name()), "this is not an instance of the exported class");
+      }
       
-      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: result = ", to_string(result), " for ", to_string(js_object), ".", property_name);
+      const auto& callback = named_value_property_callback.get_callback();
+      const auto  result   = callback(*native_object_ptr);
+      
+      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetNamedProperty: result = ", to_string(result), " for this[", native_object_ptr, "].", named_value_property_callback.get_name());
 
       // make sure to cache the result if it's a constant
-      if (constant_found) {
-        constants_cache__.emplace(property_name, result);
-
-        //
-        // create LRU cache access history
-        //
-        const auto cache_history_position = std::find(constants_cache_history__.begin(), constants_cache_history__.end(), property_name);
-        // make sure it's called only when cache misses
-        assert(cache_history_position == constants_cache_history__.end());
+      if (constant_found && constants_cache_capacity__ > 0) {
         //
         // check the capacity and evict when necessary
         // this only caches up to constants_cache_capacity__ entries
         // consider optimizing this based on memory consumption
         //
-        if (constants_cache_history__.size() >= constants_cache_capacity__) {
+        while (constants_cache_list__.size() >= constants_cache_capacity__) {
           EvictCache();
         }
 
-        constants_cache_history__.insert(constants_cache_history__.end(), property_name);
+        constants_cache_list__.emplace_front(cache_key, result);
+        const auto cache_insert_result = constants_cache__.emplace(cache_key, constants_cache_list__.begin());
+        // make sure it's called only when cache misses
+        assert(cache_insert_result.second);
+        static_cast<void>(cache_insert_result);
       }
       
       return static_cast<JSValueRef>(result);
 
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", property_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", named_value_property_callback.get_name(), context_ref, e));
       return nullptr;
     }
 
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("GetNamedProperty", context_ref, "unknown exception"));
     return nullptr;
   }
   
   template<typename T>
   bool JSExportClass<T>::SetNamedValuePropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef value_ref, JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    JSValue  js_value(js_object.get_context(), value_ref);
-    
-    const std::string property_name = JSString(property_name_ref);
+    const auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
     
-    const auto callback_position = js_export_class_definition__.named_value_property_callback_map__.find(property_name);
-    const bool callback_found    = callback_position != js_export_class_definition__.named_value_property_callback_map__.end();
+    const auto callback_index = js_export_class_definition__.named_value_property_table__.Find(property_name_ref);
+    const bool callback_found = callback_index != JSPropertyNameTable::npos;
     
-    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetNamedProperty: callback found = ", callback_found, " for ", to_string(js_object), ".", property_name);
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetNamedProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", JSString(property_name_ref));
     
     // precondition
     assert(callback_found);
     
+    const auto& named_value_property_callback = js_export_class_definition__.named_value_property_callbacks__[callback_index];
+    
     try {
-      auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
-      const auto callback    = (callback_position -> second).set_callback();
-      const auto result      = callback(*native_object_ptr, js_value);
+      if (!native_object_ptr) {
+        ThrowRuntimeError(GetJSExportComponentName("SetNamedProperty", named_value_property_callback.get_name()), "this is not an instance of the exported class");
+      }
       
-      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetNamedProperty: result = ", result, " for ", to_string(js_object), ".", property_name);
+      const auto& callback = named_value_property_callback.set_callback();
+      const auto  result   = callback(*native_object_ptr, JSValue(JSContext(context_ref), value_ref));
+      
+      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetNamedProperty: result = ", result, " for this[", native_object_ptr, "].", named_value_property_callback.get_name());
       
       return result;
 
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", property_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", named_value_property_callback.get_name(), context_ref, e));
       return false;
     }
     
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", context_ref, e));
     return false;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("SetNamedProperty", context_ref, "unknown exception"));
     return false;
   }
   
   template<typename T>
-  JSValueRef JSExportClass<T>::CallNamedFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
-    // to_string(js_object) produces this text:
-    //
-    // function sayHello() {
-    //     [native code]
-    // }
-    //
-    // So this is the regular expression we use to determing the
-    // function's name for lookup.
-    static std::regex regex("^function\\s+([^(]+)\\(\\)(.|\\n)*$");
-    
-    JSObject          js_object(JSObject::FindJSObject(context_ref, function_ref));
-    JSObject          this_object(JSObject::FindJSObject(context_ref, this_object_ref));
-    const std::string js_object_string = to_string(js_object);
-    std::smatch       match_results;
-    const bool        found = std::regex_match(js_object_string, match_results, regex);
-
-    static_cast<void>(found);
-    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: function name found = ", found, ", match_results.size() = ", match_results.size(), ", input = ", js_object_string);
+  template<std::size_t N>
+  void JSExportClass<T>::InitializeCallNamedFunctionCallbacks(::JSObjectCallAsFunctionCallback* callbacks, std::integral_constant<std::size_t, N>) HAL_NOEXCEPT {
+    callbacks[N - 1] = CallNamedFunctionCallbackAt<N - 1>;
+    InitializeCallNamedFunctionCallbacks(callbacks, std::integral_constant<std::size_t, N - 1>());
+  }
+  
+  template<typename T>
+  void JSExportClass<T>::InitializeCallNamedFunctionCallbacks(::JSObjectCallAsFunctionCallback* /*callbacks*/, std::integral_constant<std::size_t, 0>) HAL_NOEXCEPT {
+  }
+  
+  template<typename T>
+  ::JSObjectCallAsFunctionCallback JSExportClass<T>::GetCallNamedFunctionCallback(std::size_t slot) HAL_NOEXCEPT {
+    struct CallNamedFunctionCallbacks {
+      CallNamedFunctionCallbacks() HAL_NOEXCEPT {
+        InitializeCallNamedFunctionCallbacks(callbacks, std::integral_constant<std::size_t, HAL_JSEXPORT_MAX_NAMED_FUNCTION_SLOTS>());
+      }
+      ::JSObjectCallAsFunctionCallback callbacks[HAL_JSEXPORT_MAX_NAMED_FUNCTION_SLOTS];
+    };
     
-    // precondition
-    // The size of the match results should be 3:
-    // match_results[0] == the whole string.
-    // match_results[1] == The function's name
-    // match_results[2] == Everything after the function's name.
-    assert(match_results.size() == 3);
-    const std::string function_name = match_results[1];
+    static const CallNamedFunctionCallbacks call_named_function_callbacks;
+    
+    if (slot < HAL_JSEXPORT_MAX_NAMED_FUNCTION_SLOTS) {
+      return call_named_function_callbacks.callbacks[slot];
+    }
+    
+    return CallNamedFunctionCallback;
+  }
+  
+  template<typename T>
+  template<std::size_t N>
+  JSValueRef JSExportClass<T>::CallNamedFunctionCallbackAt(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) {
+    const auto& named_function_property_callbacks = js_export_class_definition__.named_function_property_callbacks__;
     
     // precondition
-    assert(js_object.IsFunction());
+    assert(N < named_function_property_callbacks.size());
+    
+    return CallNamedFunction(named_function_property_callbacks[N], context_ref, function_ref, this_object_ref, argument_count, arguments_array, exception);
+  }
+  
+  template<typename T>
+  JSValueRef JSExportClass<T>::CallNamedFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
+    // Only named functions that did not get a slot of their own end
+    // up here, so look the callback up by the function's name.
+    const JSContext   js_context(context_ref);
+    const JSObject    js_object(js_context, function_ref);
+    const std::string function_name = static_cast<std::string>(js_object.GetProperty(JSPropertyKey::Name()));
     
     const auto callback_position = js_export_class_definition__.named_function_property_callback_map__.find(function_name);
     const bool callback_found    = callback_position != js_export_class_definition__.named_function_property_callback_map__.end();
-    const auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
-    const auto native_this_ptr   = static_cast<T*>(this_object.GetPrivate());
-
-    static_cast<void>(native_object_ptr);
-    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: callback found = ", callback_found, " for this[", native_this_ptr, "].", function_name, "(...)");
+    
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: callback found = ", callback_found, " for ", function_name);
     
     // precondition
     assert(callback_found);
-
+    
+    return CallNamedFunction(callback_position -> second, context_ref, function_ref, this_object_ref, argument_count, arguments_array, exception);
+    
+  } catch (const std::exception& e) {
+    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, e));
+    return nullptr;
+  } catch (...) {
+    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, "unknown exception"));
+    return nullptr;
+  }
+  
+  template<typename T>
+  template<typename M, M method>
+  JSValueRef JSExportClass<T>::CallBoundFunctionCallback(JSContextRef context_ref, JSObjectRef /*function_ref*/, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
+    static_assert(std::is_base_of<typename JSNativeMethod<M>::class_type, T>::value, "HAL: the member function must belong to the exported class or one of its bases");
+    
+    const auto native_this_ptr = static_cast<T*>(JSObjectGetPrivate(this_object_ref));
+    if (!native_this_ptr) {
+      ThrowRuntimeError(GetJSExportComponentName("CallBoundFunction"), "this is not an instance of the exported class");
+    }
+    
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallBoundFunction: this[", native_this_ptr, "].(...)");
+    
+    const JSContext js_context(context_ref);
+    return JSNativeMethod<M>::Call(*native_this_ptr, method, JSArguments(js_context, argument_count, arguments_array));
+    
+  } catch (const js_runtime_error& e) {
+    *exception = static_cast<JSValueRef>(CreateJSError("CallBoundFunction", "", context_ref, e));
+    return nullptr;
+  } catch (const std::exception& e) {
+    *exception = static_cast<JSValueRef>(CreateJSError("CallBoundFunction", context_ref, e));
+    return nullptr;
+  } catch (...) {
+    *exception = static_cast<JSValueRef>(CreateJSError("CallBoundFunction", context_ref, "unknown exception"));
+    return nullptr;
+  }
+  
+  template<typename T>
+  JSValueRef JSExportClass<T>::CallNamedFunction(const JSExportNamedFunctionPropertyCallback<T>& named_function_property_callback, JSContextRef context_ref, JSObjectRef /*function_ref*/, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
+    
+    const auto native_this_ptr = static_cast<T*>(JSObjectGetPrivate(this_object_ref));
+    
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: this[", native_this_ptr, "].", named_function_property_callback.get_name(), "(...)");
+    
     try {
-      const auto callback = (callback_position -> second).function_callback();
-      const auto result   = callback(*native_this_ptr, to_vector(this_object.get_context(), argument_count, arguments_array), this_object);
+      if (!native_this_ptr) {
+        ThrowRuntimeError(GetJSExportComponentName("CallNamedFunction", named_function_property_callback.get_name()), "this is not an instance of the exported class");
+      }
+      
+      // The callback's signature takes this as a JSObject, which is
+      // wrapped directly rather than looked up with FindJSObject.
+      const auto&     callback = named_function_property_callback.function_callback();
+      const JSContext js_context(context_ref);
+      JSObject        this_object(js_context, this_object_ref);
+      const auto      result   = callback(*native_this_ptr, JSArguments(js_context, argument_count, arguments_array), this_object);
       
 #ifdef HAL_LOGGING_ENABLE
       std::string js_value_str;
@@ -459,38 +725,33 @@ namespace HAL { namespace detail {
         js_value_str = to_string(result);
       }
       
-      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: result = ", js_value_str, " for this[", native_this_ptr, "].", function_name, "(...)");
+      HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallNamedFunction: result = ", js_value_str, " for this[", native_this_ptr, "].", named_function_property_callback.get_name(), "(...)");
 #endif
       
       return static_cast<JSValueRef>(result);
 
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", function_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", named_function_property_callback.get_name(), context_ref, e));
       return nullptr;
     } catch (const std::exception& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", js_object, function_name + ": " + e.what()));
+      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, named_function_property_callback.get_name() + ": " + e.what()));
       return nullptr;
     } catch (...) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", js_object, function_name + ": " + "unknown exception"));
+      *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, named_function_property_callback.get_name() + ": " + "unknown exception"));
       return nullptr;
     }
 
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("CallNamedFunction", context_ref, "unknown exception"));
     return nullptr;
   }
 
   template<typename T>
-  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, const std::string& location, JSObject js_source, const js_runtime_error& e) {
-    const auto js_context = js_source.get_context();
+  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, const std::string& location, JSContextRef context_ref, const js_runtime_error& e) {
+    const JSContext js_context(context_ref);
     const auto name = GetJSExportComponentName(function_name, location);
 
     HAL_LOG_ERROR(name, ": ", e.what());
@@ -499,42 +760,56 @@ namespace HAL { namespace detail {
     js_stack.push_back(js_context.CreateString(name));
 
     auto js_error = js_context.CreateError();
-    js_error.SetProperty("message",    js_context.CreateString(e.js_message()));
-    js_error.SetProperty("name",       js_context.CreateString(e.js_name()));
-    js_error.SetProperty("fileName",   js_context.CreateString(e.js_filename()));
-    js_error.SetProperty("native_stack",      js_context.CreateArray(js_stack));
-    js_error.SetProperty("lineNumber", js_context.CreateNumber(e.js_linenumber()));
+    js_error.SetProperty(JSPropertyKey::Message(),     js_context.CreateString(e.js_message()));
+    js_error.SetProperty(JSPropertyKey::Name(),        js_context.CreateString(e.js_name()));
+    js_error.SetProperty(JSPropertyKey::FileName(),    js_context.CreateString(e.js_filename()));
+    js_error.SetProperty(JSPropertyKey::NativeStack(), js_context.CreateArray(js_stack));
+    js_error.SetProperty(JSPropertyKey::LineNumber(),  js_context.CreateNumber(e.js_linenumber()));
     return js_error;
   }
 
   template<typename T>
-  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, JSObject js_source, const std::exception& e) {
-    return CreateJSError(function_name, js_source, e.what());
+  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, JSContextRef context_ref, const std::exception& e) {
+    return CreateJSError(function_name, context_ref, e.what());
   }
 
   template<typename T>
-  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, JSObject js_source, const std::string& what) {
-    const auto js_context = js_source.get_context();
+  JSValue JSExportClass<T>::CreateJSError(const std::string& function_name, JSContextRef context_ref, const std::string& what) {
+    const JSContext js_context(context_ref);
     const auto name = GetJSExportComponentName(function_name);
 
     HAL_LOG_ERROR(name, ": ", what);
 
     auto js_error = js_context.CreateError();
-    js_error.SetProperty("message",    js_context.CreateString(what));
-    js_error.SetProperty("native_stack",      js_context.CreateArray({ js_context.CreateString(name) }));
+    js_error.SetProperty(JSPropertyKey::Message(),     js_context.CreateString(what));
+    js_error.SetProperty(JSPropertyKey::NativeStack(), js_context.CreateArray({ js_context.CreateString(name) }));
     return js_error;
   }
   
   template<typename T>
-  bool JSExportClass<T>::JSObjectHasPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref) try {
+  bool JSExportClass<T>::JSObjectHasPropertyCallback(JSContextRef /*context_ref*/, JSObjectRef object_ref, JSStringRef property_name_ref) try {
+    
+    const auto native_object_ptr = static_cast<const T*>(JSObjectGetPrivate(object_ref));
+    
+    // JavaScriptCore doesn't ask getProperty once hasProperty exists,
+    // so the indexed properties have to be answered here too.
+    const auto& get_length_callback = js_export_class_definition__.get_length_callback__;
+    if (get_length_callback) {
+      std::uint32_t index = 0;
+      if (ToArrayIndex(property_name_ref, index)) {
+        if (index < get_length_callback(*native_object_ptr)) {
+          return true;
+        }
+      } else if (IsPropertyName(property_name_ref, "length")) {
+        return true;
+      }
+    }
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
     JSString property_name(property_name_ref);
     
     auto       callback       = js_export_class_definition__.has_property_callback__;
     const bool callback_found = callback != nullptr;
 
-    const auto native_object_ptr = static_cast<const T*>(js_object.GetPrivate());
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::HasProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
     
     // precondition
@@ -557,18 +832,30 @@ namespace HAL { namespace detail {
   template<typename T>
   JSValueRef JSExportClass<T>::JSObjectGetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    JSString property_name(property_name_ref);
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
+    
+    const auto& get_length_callback = js_export_class_definition__.get_length_callback__;
+    if (get_length_callback) {
+      std::uint32_t index = 0;
+      if (ToArrayIndex(property_name_ref, index)) {
+        if (index < get_length_callback(*native_object_ptr)) {
+          HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetProperty: for this[", native_object_ptr, "][", index, "]");
+          return static_cast<JSValueRef>(js_export_class_definition__.get_indexed_property_callback__(*native_object_ptr, index));
+        }
+      } else if (IsPropertyName(property_name_ref, "length")) {
+        return JSValueMakeNumber(context_ref, get_length_callback(*native_object_ptr));
+      }
+    }
     
     auto       callback       = js_export_class_definition__.get_property_callback__;
     const bool callback_found = callback != nullptr;
+    if (!callback_found) {
+      return nullptr;
+    }
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    JSString property_name(property_name_ref);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
     
-    // precondition
-    assert(callback_found);
-    
     try {
       const auto result = callback(*native_object_ptr, property_name);
       
@@ -587,66 +874,77 @@ namespace HAL { namespace detail {
       
       return static_cast<JSValueRef>(result);
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", property_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", property_name, context_ref, e));
       return nullptr;
     }
 
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("GetProperty", context_ref, "unknown exception"));
     return nullptr;
   }
   
   template<typename T>
   bool JSExportClass<T>::JSObjectSetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef value_ref, JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    JSString property_name(property_name_ref);
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
+    
+    const auto& get_length_callback = js_export_class_definition__.get_length_callback__;
+    if (get_length_callback) {
+      std::uint32_t index = 0;
+      if (ToArrayIndex(property_name_ref, index)) {
+        const auto& set_indexed_property_callback = js_export_class_definition__.set_indexed_property_callback__;
+        if (set_indexed_property_callback) {
+          HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetProperty: for this[", native_object_ptr, "][", index, "]");
+          return set_indexed_property_callback(*native_object_ptr, index, JSValue(JSContext(context_ref), value_ref));
+        }
+        
+        // The array indexes below the length are read-only.
+        if (index < get_length_callback(*native_object_ptr)) {
+          return true;
+        }
+      } else if (IsPropertyName(property_name_ref, "length")) {
+        return true;
+      }
+    }
     
     auto       callback       = js_export_class_definition__.set_property_callback__;
     const bool callback_found = callback != nullptr;
+    if (!callback_found) {
+      return false;
+    }
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    JSString property_name(property_name_ref);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
     
-    // precondition
-    assert(callback_found);
-    
     try {
-      const auto result = callback(*native_object_ptr, property_name, JSValue(js_object.get_context(), value_ref));
+      const auto result = callback(*native_object_ptr, property_name, JSValue(JSContext(context_ref), value_ref));
       HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::SetProperty: result = ", result, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
       return result;
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", property_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", property_name, context_ref, e));
       return false;
     }
 
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", context_ref, e));
     return false;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("SetProperty", context_ref, "unknown exception"));
     return false;
   }
   
   template<typename T>
   bool JSExportClass<T>::JSObjectDeletePropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
     JSString property_name(property_name_ref);
     
     auto       callback       = js_export_class_definition__.delete_property_callback__;
     const bool callback_found = callback != nullptr;
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::DeleteProperty: callback found = ", callback_found, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
     
     // precondition
@@ -657,37 +955,40 @@ namespace HAL { namespace detail {
       HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::DeleteProperty: result = ", result, " for this[", native_object_ptr, "].", static_cast<std::string>(property_name));
       return result;
     } catch (const js_runtime_error& e) {
-      JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-      *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", property_name, js_object, e));
+      *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", property_name, context_ref, e));
       return false;
     }
     
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", context_ref, e));
     return false;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("DeleteProperty", context_ref, "unknown exception"));
     return false;
   }
   
   template<typename T>
-  void JSExportClass<T>::JSObjectGetPropertyNamesCallback(JSContextRef context_ref, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names) try {
+  void JSExportClass<T>::JSObjectGetPropertyNamesCallback(JSContextRef /*context_ref*/, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names) try {
     
-    JSObject                  js_object(JSObject::FindJSObject(context_ref, object_ref));
     JSPropertyNameAccumulator js_property_name_accumulator(property_names);
     
     auto       callback       = js_export_class_definition__.get_property_names_callback__;
     const bool callback_found = callback != nullptr;
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(object_ref));
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::GetPropertyNames: callback found = ", callback_found, " for this[", native_object_ptr, "]");
     
-    // precondition
-    assert(callback_found);
+    const auto& get_length_callback = js_export_class_definition__.get_length_callback__;
+    if (get_length_callback) {
+      const std::uint32_t length = get_length_callback(*native_object_ptr);
+      for (std::uint32_t index = 0; index < length; ++index) {
+        js_property_name_accumulator.AddName(JSString(std::to_string(index)));
+      }
+    }
     
-    callback(*native_object_ptr, js_property_name_accumulator);
+    if (callback_found) {
+      callback(*native_object_ptr, js_property_name_accumulator);
+    }
 
   } catch (const std::exception& e) {
     HAL_LOG_ERROR(GetJSExportComponentName("GetPropertyNames"), ": ", e.what());
@@ -698,116 +999,95 @@ namespace HAL { namespace detail {
   template<typename T>
   JSValueRef JSExportClass<T>::JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
     
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    JSObject this_object(JSObject::FindJSObject(context_ref, this_object_ref));
-    
     // precondition
-    assert(js_object.IsFunction());
+    assert(JSObjectIsFunction(context_ref, function_ref));
     
     auto       callback       = js_export_class_definition__.call_as_function_callback__;
     const bool callback_found = callback != nullptr;
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
-    auto native_this_ptr   = static_cast<T*>(this_object.GetPrivate());
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(function_ref));
+    auto native_this_ptr   = static_cast<T*>(JSObjectGetPrivate(this_object_ref));
     static_cast<void>(native_this_ptr);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallAsFunction: callback found = ", callback_found, " for this[", native_this_ptr, "].this[", native_object_ptr, "](...)");
     
     // precondition
     assert(callback_found);
     
-    const auto result = callback(*native_object_ptr, to_vector(this_object.get_context(), argument_count, arguments_array), this_object);
+    const JSContext js_context(context_ref);
+    JSObject        this_object(js_context, this_object_ref);
+    const auto      result = callback(*native_object_ptr, JSArguments(js_context, argument_count, arguments_array), this_object);
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallAsFunction: result = ", to_string(result), " for this[", native_this_ptr, "].this[", native_object_ptr, "](...)");
     return static_cast<JSValueRef>(result);
 
   } catch (const js_runtime_error& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", "", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", "", context_ref, e));
     return nullptr;
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, function_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("CallAsFunction", context_ref, "unknown exception"));
     return nullptr;
   }
   
   template<typename T>
   JSObjectRef JSExportClass<T>::JSObjectCallAsConstructorCallback(JSContextRef context_ref, JSObjectRef constructor_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
     
-    JSObject  js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    JSContext js_context = js_object.get_context();
+    JSContext js_context(context_ref);
+    JSObject  js_object(js_context, constructor_ref);
 
     auto new_object = js_context.CreateObject(JSExport<T>::Class());
     const auto native_object_ptr = static_cast<T*>(new_object.GetPrivate());
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::CallAsConstructor: for this[", native_object_ptr, "]");
 
-    new_object.SetProperty("constructor", js_object);
+    new_object.SetProperty(JSPropertyKey::Constructor(), js_object);
 
     native_object_ptr->postCallAsConstructor(js_context, to_vector(js_context, argument_count, arguments_array));
 
     return static_cast<JSObjectRef>(new_object);
     
   } catch (const js_runtime_error& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", "", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", "", context_ref, e));
     return nullptr;
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectCallAsConstructorCallback", context_ref, "unknown exception"));
     return nullptr;
   }
   
   template<typename T>
   bool JSExportClass<T>::JSObjectHasInstanceCallback(JSContextRef context_ref, JSObjectRef constructor_ref, JSValueRef possible_instance_ref, JSValueRef* exception) try {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    JSValue  possible_instance(js_object.get_context(), possible_instance_ref);
-
     bool result = false;
-    if (possible_instance.IsObject()) {
-      JSObject possible_object = static_cast<JSObject>(possible_instance);
-      if (possible_object.GetPrivate() != nullptr) {
-        auto possible_js_export_ptr     = static_cast<JSExport<T>*>(possible_object.GetPrivate());
-        auto possible_native_object_ptr = dynamic_cast<T*>(possible_js_export_ptr);
-        if (possible_native_object_ptr != nullptr) {
-          result = true;
-        }
-      }
+    if (JSValueIsObject(context_ref, possible_instance_ref)) {
+      result = JSExportCast<T>(context_ref, JSValueToObject(context_ref, possible_instance_ref, nullptr)) != nullptr;
     }
     
-    auto native_object_ptr = static_cast<T*>(js_object.GetPrivate());
+    auto native_object_ptr = static_cast<T*>(JSObjectGetPrivate(constructor_ref));
     static_cast<void>(native_object_ptr);
-    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::HasInstance: result = ", result, " for ", to_string(possible_instance), " instanceof this[", native_object_ptr, "]");
+    HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::HasInstance: result = ", result, " for ", possible_instance_ref, " instanceof this[", native_object_ptr, "]");
     return result;
     
   } catch (const js_runtime_error& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", "", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", "", context_ref, e));
     return false;
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", context_ref, e));
     return false;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, constructor_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectHasInstanceCallback", context_ref, "unknown exception"));
     return false;
   }
   
   template<typename T>
   JSValueRef JSExportClass<T>::JSObjectConvertToTypeCallback(JSContextRef context_ref, JSObjectRef object_ref, JSType type, JSValueRef* exception) try {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
     JSValue::Type js_value_type = ToJSValueType(type);
     
     auto       callback       = js_export_class_definition__.convert_to_type_callback__;
     const bool callback_found = callback != nullptr;
     
-    const auto native_object_ptr = static_cast<const T*>(js_object.GetPrivate());
+    const auto native_object_ptr = static_cast<const T*>(JSObjectGetPrivate(object_ref));
     HAL_LOG_DEBUG("JSExportClass<", typeid(T).name(), ">::ConvertToType: callback found = ", callback_found, " for this[", native_object_ptr, "]");
     
     // precondition
@@ -820,16 +1100,13 @@ namespace HAL { namespace detail {
     return static_cast<JSValueRef>(result);
     
   } catch (const js_runtime_error& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", "", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", "", context_ref, e));
     return nullptr;
   } catch (const std::exception& e) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", js_object, e));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", context_ref, e));
     return nullptr;
   } catch (...) {
-    JSObject js_object(JSObject::FindJSObject(context_ref, object_ref));
-    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", js_object, "unknown exception"));
+    *exception = static_cast<JSValueRef>(CreateJSError("JSObjectConvertToTypeCallback", context_ref, "unknown exception"));
     return nullptr;
   }
   
@@ -16,8 +16,11 @@
 #include "HAL/detail/JSExportNamedValuePropertyCallback.hpp"
 #include "HAL/detail/JSExportNamedFunctionPropertyCallback.hpp"
 #include "HAL/detail/JSExportCallbacks.hpp"
+#include "HAL/detail/JSPropertyNameTable.hpp"
 
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <unordered_map>
 
 namespace HAL { namespace detail {
@@ -67,21 +70,46 @@ namespace HAL { namespace detail {
     template<typename U>
     friend class JSExportClass;
     
+    bool                                          constants_on_prototype__       { false };
+    bool                                          pooled_allocation__            { false };
     std::unordered_set<std::string>               named_constants__;
     JSExportNamedValuePropertyCallbackMap_t<T>    named_value_property_callback_map__;
     JSExportNamedFunctionPropertyCallbackMap_t<T> named_function_property_callback_map__;
+    
+    // The named function property callbacks indexed by slot, which is
+    // rebuilt by InitializeNamedPropertyCallbacks.
+    std::vector<JSExportNamedFunctionPropertyCallback<T>> named_function_property_callbacks__;
+    
+    // The named value property callbacks and whether each one is a
+    // constant, indexed by the position of their name in
+    // named_value_property_table__. Both are rebuilt by
+    // InitializeNamedPropertyCallbacks.
+    JSPropertyNameTable                                named_value_property_table__;
+    std::vector<JSExportNamedValuePropertyCallback<T>> named_value_property_callbacks__;
+    std::vector<bool>                                  named_value_property_constants__;
+    
+    // The constant properties that JSExportClass installs on the
+    // prototype instead, which is rebuilt by
+    // InitializeNamedPropertyCallbacks.
+    std::vector<JSExportNamedValuePropertyCallback<T>> named_prototype_constant_callbacks__;
+    
     HasPropertyCallback<T>                        has_property_callback__        { nullptr };
     GetPropertyCallback<T>                        get_property_callback__        { nullptr };
     SetPropertyCallback<T>                        set_property_callback__        { nullptr };
     DeletePropertyCallback<T>                     delete_property_callback__     { nullptr };
     GetPropertyNamesCallback<T>                   get_property_names_callback__  { nullptr };
-    CallAsFunctionCallback<T>                     call_as_function_callback__    { nullptr };
+    GetIndexedPropertyCallback<T>                 get_indexed_property_callback__ { nullptr };
+    SetIndexedPropertyCallback<T>                 set_indexed_property_callback__ { nullptr };
+    GetLengthCallback<T>                          get_length_callback__          { nullptr };
+    CallAsFunctionArgumentsCallback<T>            call_as_function_callback__    { nullptr };
     ConvertToTypeCallback<T>                      convert_to_type_callback__     { nullptr };
   };
   
   template<typename T>
   JSExportClassDefinition<T>::JSExportClassDefinition(const JSExportClassDefinition<T>& rhs) HAL_NOEXCEPT
   : JSClassDefinition(rhs)
+  , constants_on_prototype__(rhs.constants_on_prototype__)
+  , pooled_allocation__(rhs.pooled_allocation__)
   , named_constants__(rhs.named_constants__)
   , named_value_property_callback_map__(rhs.named_value_property_callback_map__)
   , named_function_property_callback_map__(rhs.named_function_property_callback_map__)
@@ -90,6 +118,9 @@ namespace HAL { namespace detail {
   , set_property_callback__(rhs.set_property_callback__)
   , delete_property_callback__(rhs.delete_property_callback__)
   , get_property_names_callback__(rhs.get_property_names_callback__)
+  , get_indexed_property_callback__(rhs.get_indexed_property_callback__)
+  , set_indexed_property_callback__(rhs.set_indexed_property_callback__)
+  , get_length_callback__(rhs.get_length_callback__)
   , call_as_function_callback__(rhs.call_as_function_callback__)
   , convert_to_type_callback__(rhs.convert_to_type_callback__) {
     InitializeNamedPropertyCallbacks();
@@ -101,6 +132,8 @@ namespace HAL { namespace detail {
   template<typename T>
   JSExportClassDefinition<T>::JSExportClassDefinition(JSExportClassDefinition<T>&& rhs) HAL_NOEXCEPT
   : JSClassDefinition(rhs)
+  , constants_on_prototype__(rhs.constants_on_prototype__)
+  , pooled_allocation__(rhs.pooled_allocation__)
   , named_constants__(std::move(rhs.named_constants__))
   , named_value_property_callback_map__(std::move(rhs.named_value_property_callback_map__))
   , named_function_property_callback_map__(std::move(rhs.named_function_property_callback_map__))
@@ -109,6 +142,9 @@ namespace HAL { namespace detail {
   , set_property_callback__(std::move(rhs.set_property_callback__))
   , delete_property_callback__(std::move(rhs.delete_property_callback__))
   , get_property_names_callback__(std::move(rhs.get_property_names_callback__))
+  , get_indexed_property_callback__(std::move(rhs.get_indexed_property_callback__))
+  , set_indexed_property_callback__(std::move(rhs.set_indexed_property_callback__))
+  , get_length_callback__(std::move(rhs.get_length_callback__))
   , call_as_function_callback__(std::move(rhs.call_as_function_callback__))
   , convert_to_type_callback__(std::move(rhs.convert_to_type_callback__)) {
     InitializeNamedPropertyCallbacks();
@@ -121,6 +157,8 @@ namespace HAL { namespace detail {
   JSExportClassDefinition<T>& JSExportClassDefinition<T>::operator=(const JSExportClassDefinition<T>& rhs) HAL_NOEXCEPT {
     HAL_JSCLASSDEFINITION_LOCK_GUARD;
     JSClassDefinition::operator=(rhs);
+    constants_on_prototype__               = rhs.constants_on_prototype__;
+    pooled_allocation__                    = rhs.pooled_allocation__;
     named_constants__                      = rhs.named_constants__;
     named_value_property_callback_map__    = rhs.named_value_property_callback_map__;
     named_function_property_callback_map__ = rhs.named_function_property_callback_map__;
@@ -129,6 +167,9 @@ namespace HAL { namespace detail {
     set_property_callback__                = rhs.set_property_callback__;
     delete_property_callback__             = rhs.delete_property_callback__;
     get_property_names_callback__          = rhs.get_property_names_callback__;
+    get_indexed_property_callback__        = rhs.get_indexed_property_callback__;
+    set_indexed_property_callback__        = rhs.set_indexed_property_callback__;
+    get_length_callback__                  = rhs.get_length_callback__;
     call_as_function_callback__            = rhs.call_as_function_callback__;
     convert_to_type_callback__             = rhs.convert_to_type_callback__;
     InitializeNamedPropertyCallbacks();
@@ -159,14 +200,24 @@ namespace HAL { namespace detail {
       
       // By swapping the members of two classes, the two classes are
       // effectively swapped.
+      swap(constants_on_prototype__              , other.constants_on_prototype__);
+      swap(pooled_allocation__                   , other.pooled_allocation__);
       swap(named_constants__                     , other.named_constants__);
       swap(named_value_property_callback_map__   , other.named_value_property_callback_map__);
       swap(named_function_property_callback_map__, other.named_function_property_callback_map__);
+      swap(named_function_property_callbacks__   , other.named_function_property_callbacks__);
+      swap(named_value_property_table__          , other.named_value_property_table__);
+      swap(named_value_property_callbacks__      , other.named_value_property_callbacks__);
+      swap(named_value_property_constants__      , other.named_value_property_constants__);
+      swap(named_prototype_constant_callbacks__  , other.named_prototype_constant_callbacks__);
       swap(has_property_callback__               , other.has_property_callback__);
       swap(get_property_callback__               , other.get_property_callback__);
       swap(set_property_callback__               , other.set_property_callback__);
       swap(delete_property_callback__            , other.delete_property_callback__);
       swap(get_property_names_callback__         , other.get_property_names_callback__);
+      swap(get_indexed_property_callback__       , other.get_indexed_property_callback__);
+      swap(set_indexed_property_callback__       , other.set_indexed_property_callback__);
+      swap(get_length_callback__                 , other.get_length_callback__);
       swap(call_as_function_callback__           , other.call_as_function_callback__);
       swap(convert_to_type_callback__            , other.convert_to_type_callback__);
     }
@@ -179,38 +230,78 @@ namespace HAL { namespace detail {
     template<typename T>
     void JSExportClassDefinition<T>::InitializeNamedPropertyCallbacks() HAL_NOEXCEPT {
       
-      // Initialize staticValues.
+      // Initialize staticValues. The set of value properties is fixed
+      // from here on, so freeze their names into a table that the
+      // JSExportClass callbacks can search by JSStringRef. Constants
+      // installed on the prototype are left out, since a static value
+      // would shadow them.
+      const bool constants_on_prototype = constants_on_prototype__ && !(js_class_definition__.attributes & kJSClassAttributeNoAutomaticPrototype);
       static_values__.clear();
+      named_value_property_callbacks__.clear();
+      named_value_property_constants__.clear();
+      named_prototype_constant_callbacks__.clear();
+      named_value_property_table__ = JSPropertyNameTable();
       js_class_definition__.staticValues = nullptr;
       if (!named_value_property_callback_map__.empty()) {
+        std::vector<std::string> property_names;
+        property_names.reserve(named_value_property_callback_map__.size());
+        named_value_property_callbacks__.reserve(named_value_property_callback_map__.size());
         for (const auto& entry : named_value_property_callback_map__) {
           const auto& property_name       = entry.first;
           const auto& property_attributes = entry.second.get_attributes();
+          const bool  constant            = named_constants__.find(property_name) != named_constants__.end();
+          if (constant && constants_on_prototype) {
+            named_prototype_constant_callbacks__.push_back(entry.second);
+            continue;
+          }
           ::JSStaticValue static_value;
           static_value.name        = property_name.c_str();
           static_value.getProperty = JSExportClass<T>::GetNamedValuePropertyCallback;
           static_value.setProperty = JSExportClass<T>::SetNamedValuePropertyCallback;
           static_value.attributes  = ToJSPropertyAttributes(property_attributes);
           static_values__.push_back(static_value);
+          property_names.push_back(property_name);
+          named_value_property_callbacks__.push_back(entry.second);
+          named_value_property_constants__.push_back(constant);
           // HAL_LOG_DEBUG("JSExportClassDefinition<", name__, "> added value property ", static_values__.back().name);
         }
-        static_values__.push_back({nullptr, nullptr, nullptr, kJSPropertyAttributeNone});
-        js_class_definition__.staticValues = &static_values__[0];
+        if (!static_values__.empty()) {
+          static_values__.push_back({nullptr, nullptr, nullptr, kJSPropertyAttributeNone});
+          js_class_definition__.staticValues = &static_values__[0];
+          named_value_property_table__ = JSPropertyNameTable(property_names);
+        }
       }
       
-      // Initialize staticFunctions.
+      // Initialize staticFunctions. Each function is assigned a slot
+      // with its own callback so that calling it does not require
+      // recovering its name. Slots are assigned in name order so that
+      // every copy of this definition agrees on them. A function with
+      // a native callback is called through it directly.
       static_functions__.clear();
+      named_function_property_callbacks__.clear();
       js_class_definition__.staticFunctions = nullptr;
       if (!named_function_property_callback_map__.empty()) {
+        using entry_t = typename JSExportNamedFunctionPropertyCallbackMap_t<T>::value_type;
+        std::vector<const entry_t*> entries;
+        entries.reserve(named_function_property_callback_map__.size());
         for (const auto& entry : named_function_property_callback_map__) {
-          const auto& function_name = entry.first;
-          const auto& property_attributes = entry.second.get_attributes();
+          entries.push_back(&entry);
+        }
+        std::sort(entries.begin(), entries.end(), [](const entry_t* lhs, const entry_t* rhs) {
+          return lhs -> first < rhs -> first;
+        });
+        
+        for (std::size_t slot = 0; slot < entries.size(); ++slot) {
+          const auto& function_name       = entries[slot] -> first;
+          const auto& property_attributes = entries[slot] -> second.get_attributes();
+          const auto  native_callback     = entries[slot] -> second.native_callback();
           ::JSStaticFunction static_function;
           static_function.name           = function_name.c_str();
-          static_function.callAsFunction = JSExportClass<T>::CallNamedFunctionCallback;
+          static_function.callAsFunction = native_callback ? native_callback : JSExportClass<T>::GetCallNamedFunctionCallback(slot);
           static_function.attributes     = ToJSPropertyAttributes(property_attributes);
           static_functions__.push_back(static_function);
-          // HAL_LOG_DEBUG("JSExportClassDefinition<", name__, "> added function property ", static_functions__.back().name);
+          named_function_property_callbacks__.push_back(entries[slot] -> second);
+          // HAL_LOG_DEBUG("JSExportClassDefinition<", name__, "> added function property ", static_functions__.back().name, " at slot ", slot);
         }
         static_functions__.push_back({nullptr, nullptr, kJSPropertyAttributeNone});
         js_class_definition__.staticFunctions = &static_functions__[0];
@@ -200,6 +200,79 @@ namespace HAL { namespace detail {
       return *this;
     }
     
+    /*!
+     @method
+     
+     @abstract Return whether your JSClass installs its constant
+     properties on its prototype.
+     
+     @result true if your JSClass installs its constant properties on
+     its prototype.
+     */
+    bool ConstantsOnPrototype() const HAL_NOEXCEPT {
+      return constants_on_prototype__;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Set whether your JSClass installs the properties added
+     by AddConstantProperty as read-only, non-deletable data
+     properties on its automatically generated prototype. The default
+     value is false.
+     
+     @discussion When true each constant is evaluated once per global
+     context, when the first JavaScript object of your JSClass is
+     created in it, and reading it afterwards never calls back into
+     C++. When false each constant is a value property whose result is
+     kept in a least-recently-used cache.
+     
+     Constants stay value properties if your JSClass has the
+     'NoAutomaticPrototype' attribute. Since value properties shadow
+     the prototype chain, a constant on the prototype is also hidden
+     by a value property with the same name in a parent class.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& ConstantsOnPrototype(bool constants_on_prototype) HAL_NOEXCEPT {
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      constants_on_prototype__ = constants_on_prototype;
+      return *this;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Return whether the native objects of your JSClass are
+     allocated from a pool.
+     
+     @result true if the native objects of your JSClass are allocated
+     from a pool.
+     */
+    bool PooledAllocation() const HAL_NOEXCEPT {
+      return pooled_allocation__;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Set whether the C++ objects backing your JavaScript
+     objects are allocated from a per-class JSExportPool of fixed-size
+     slots instead of one at a time from the heap. The default value
+     is false.
+     
+     @discussion Pooling pays off for classes of which many short-lived
+     JavaScript objects are created. Your class must not be aligned to
+     more than std::max_align_t.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& PooledAllocation(bool pooled_allocation) HAL_NOEXCEPT {
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      pooled_allocation__ = pooled_allocation;
+      return *this;
+    }
+    
     /*!
      @method
      
@@ -352,6 +425,75 @@ namespace HAL { namespace detail {
       return *this;
     }
     
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     callback takes its arguments as a JSArguments view. Calling such
+     a function allocates nothing for its arguments. The property is
+     enumerable unless you specify otherwise.
+     
+     @discussion For example, given this class definition:
+     
+     class Foo {
+     JSValue Hello(const JSArguments& arguments, JSObject& this_object);
+     };
+     
+     You would call the builer like this:
+     
+     JSExportClassDefinitionBuilder<Foo> builder("Foo");
+     builder.AddFunctionProperty("hello", &Foo::Hello);
+     
+     @throws std::invalid_argument exception under the same
+     preconditions as the std::vector overload.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& AddFunctionProperty(const JSString& function_name, CallNamedFunctionArgumentsCallback<T> function_callback, bool enumerable = true) {
+      std::unordered_set<JSPropertyAttribute> attributes { JSPropertyAttribute::DontDelete, JSPropertyAttribute::ReadOnly };
+      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum).second);
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      AddFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback<T>(function_name, function_callback, attributes));
+      return *this;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object that
+     calls a member function whose signature is deduced at
+     compile-time. The JavaScript arguments are converted directly
+     into the member function's parameter types, and its result back
+     into a JavaScript value. The property is enumerable unless you
+     specify otherwise.
+     
+     @discussion For example, given this class definition:
+     
+     class Foo {
+     double Add(int32_t lhs, double rhs);
+     };
+     
+     You would call AddFunctionProperty like this:
+     
+     builder.AddFunctionProperty<HAL_JSEXPORT_METHOD(&Foo::Add)>("add");
+     
+     See JSNativeBinding.hpp for the supported parameter and result
+     types.
+     
+     @throws std::invalid_argument exception if function_name is
+     empty.
+     
+     @result A reference to the builder for chaining.
+     */
+    template<typename M, M method>
+    JSExportClassDefinitionBuilder<T>& AddFunctionProperty(const JSString& function_name, bool enumerable = true) {
+      std::unordered_set<JSPropertyAttribute> attributes { JSPropertyAttribute::DontDelete, JSPropertyAttribute::ReadOnly };
+      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum).second);
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      AddFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback<T>(function_name, JSExportClass<T>::template CallBoundFunctionCallback<M, method>, attributes));
+      return *this;
+    }
+    
     /*!
      @method
      
@@ -586,6 +728,87 @@ namespace HAL { namespace detail {
       return *this;
     }
     
+    /*!
+     @method
+     
+     @abstract Return the callback to invoke when getting an array
+     index property below the length from your JavaScript object.
+     */
+    GetIndexedPropertyCallback<T> GetIndexedProperty() const HAL_NOEXCEPT {
+      return get_indexed_property_callback__;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Return the callback to invoke when setting an array
+     index property on your JavaScript object.
+     */
+    SetIndexedPropertyCallback<T> SetIndexedProperty() const HAL_NOEXCEPT {
+      return set_indexed_property_callback__;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Return the callback to invoke when getting the number
+     of array index properties of your JavaScript object.
+     */
+    GetLengthCallback<T> GetLength() const HAL_NOEXCEPT {
+      return get_length_callback__;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Set the callbacks to invoke for the array index
+     properties and the length property of your JavaScript object.
+     
+     @discussion Property names that are canonical array indexes are
+     recognized from their UTF-16 characters and passed to these
+     callbacks as integers, without creating a JSString. All other
+     property names go to the GetProperty and SetProperty callbacks
+     (if any).
+     
+     For example, given this class definition:
+     
+     class Foo {
+     JSValue       GetRow(std::uint32_t index);
+     bool          SetRow(std::uint32_t index, const JSValue& value);
+     std::uint32_t GetRowCount() const;
+     };
+     
+     You would call the builer like this:
+     
+     JSClassBuilder<Foo> builder("Foo");
+     builder.IndexedProperty(&Foo::GetRow, &Foo::SetRow, &Foo::GetRowCount);
+     
+     @param get_indexed_property_callback The callback to invoke when
+     getting an array index below the length.
+     
+     @param set_indexed_property_callback The callback to invoke when
+     setting an array index, or nullptr if the array index properties
+     below the length are read-only.
+     
+     @param get_length_callback The callback to invoke when getting
+     the number of array index properties.
+     
+     @throws std::invalid_argument if the get_indexed_property_callback
+     or the get_length_callback is missing.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& IndexedProperty(const GetIndexedPropertyCallback<T>& get_indexed_property_callback, const SetIndexedPropertyCallback<T>& set_indexed_property_callback, const GetLengthCallback<T>& get_length_callback) {
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      if (!get_indexed_property_callback || !get_length_callback) {
+        ThrowInvalidArgument("JSExportClassDefinitionBuilder<" + name__ + ">::IndexedProperty", "The get indexed property and get length callbacks are required");
+      }
+      get_indexed_property_callback__ = get_indexed_property_callback;
+      set_indexed_property_callback__ = set_indexed_property_callback;
+      get_length_callback__           = get_length_callback;
+      return *this;
+    }
+    
     /*!
      @method
      
@@ -593,9 +816,10 @@ namespace HAL { namespace detail {
      object is called as a function.
      
      @result The callback to invoke when your JavaScript object is
-     called as a function.
+     called as a function. A CallAsFunctionCallback is returned
+     wrapped in a CallAsFunctionArgumentsCallback.
      */
-    CallAsFunctionCallback<T> CallAsFunction() const HAL_NOEXCEPT {
+    CallAsFunctionArgumentsCallback<T> CallAsFunction() const HAL_NOEXCEPT {
       return call_as_function_callback__;
     }
     
@@ -628,6 +852,26 @@ namespace HAL { namespace detail {
      @result A reference to the builder for chaining.
      */
     JSExportClassDefinitionBuilder<T>& CallAsFunction(const CallAsFunctionCallback<T>& call_as_function_callback) HAL_NOEXCEPT {
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      call_as_function_callback__ = nullptr;
+      if (call_as_function_callback) {
+        call_as_function_callback__ = [call_as_function_callback](T& native_object, const JSArguments& arguments, JSObject& this_object) {
+          return call_as_function_callback(native_object, arguments.to_vector(), this_object);
+        };
+      }
+      return *this;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Set the callback to invoke when your JavaScript object
+     is called as a function, passing the arguments as a JSArguments
+     view instead of a std::vector of JSValues.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& CallAsFunction(const CallAsFunctionArgumentsCallback<T>& call_as_function_callback) HAL_NOEXCEPT {
       HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
       call_as_function_callback__ = call_as_function_callback;
       return *this;
@@ -703,6 +947,8 @@ namespace HAL { namespace detail {
     ::JSClassDefinition                           js_class_definition__;
     std::string                                   name__;
     JSClass                                       parent__;
+    bool                                          constants_on_prototype__       { false };
+    bool                                          pooled_allocation__            { false };
     std::unordered_set<std::string>               named_constants__;
     JSExportNamedValuePropertyCallbackMap_t<T>    named_value_property_callback_map__;
     JSExportNamedFunctionPropertyCallbackMap_t<T> named_function_property_callback_map__;
@@ -711,7 +957,10 @@ namespace HAL { namespace detail {
     SetPropertyCallback<T>                        set_property_callback__        { nullptr };
     DeletePropertyCallback<T>                     delete_property_callback__     { nullptr };
     GetPropertyNamesCallback<T>                   get_property_names_callback__  { nullptr };
-    CallAsFunctionCallback<T>                     call_as_function_callback__    { nullptr };
+    GetIndexedPropertyCallback<T>                 get_indexed_property_callback__ { nullptr };
+    SetIndexedPropertyCallback<T>                 set_indexed_property_callback__ { nullptr };
+    GetLengthCallback<T>                          get_length_callback__          { nullptr };
+    CallAsFunctionArgumentsCallback<T>            call_as_function_callback__    { nullptr };
     ConvertToTypeCallback<T>                      convert_to_type_callback__     { nullptr };
 
     HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_MUTEX;
@@ -791,11 +1040,15 @@ namespace HAL { namespace detail {
       js_class_definition__.hasProperty = JSExportClass<T>::JSObjectHasPropertyCallback;
     }
     
-    if (get_property_callback__) {
+    // The indexed property callbacks share the getProperty,
+    // setProperty and getPropertyNames callbacks with the named ones.
+    // Without a HasPropertyCallback JavaScriptCore asks getProperty
+    // whether an array index exists.
+    if (get_property_callback__ || get_length_callback__) {
       js_class_definition__.getProperty = JSExportClass<T>::JSObjectGetPropertyCallback;
     }
     
-    if (set_property_callback__) {
+    if (set_property_callback__ || get_length_callback__) {
       js_class_definition__.setProperty = JSExportClass<T>::JSObjectSetPropertyCallback;
     }
     
@@ -803,7 +1056,7 @@ namespace HAL { namespace detail {
       js_class_definition__.deleteProperty = JSExportClass<T>::JSObjectDeletePropertyCallback;
     }
     
-    if (get_property_names_callback__) {
+    if (get_property_names_callback__ || get_length_callback__) {
       js_class_definition__.getPropertyNames = JSExportClass<T>::JSObjectGetPropertyNamesCallback;
     }
     
@@ -821,6 +1074,8 @@ namespace HAL { namespace detail {
   template<typename T>
   JSExportClassDefinition<T>::JSExportClassDefinition(const JSExportClassDefinitionBuilder<T>& builder)
   : JSClassDefinition(builder.js_class_definition__)
+  , constants_on_prototype__(builder.constants_on_prototype__)
+  , pooled_allocation__(builder.pooled_allocation__)
   , named_constants__(builder.named_constants__)
   , named_value_property_callback_map__(builder.named_value_property_callback_map__)
   , named_function_property_callback_map__(builder.named_function_property_callback_map__)
@@ -829,6 +1084,9 @@ namespace HAL { namespace detail {
   , set_property_callback__(builder.set_property_callback__)
   , delete_property_callback__(builder.delete_property_callback__)
   , get_property_names_callback__(builder.get_property_names_callback__)
+  , get_indexed_property_callback__(builder.get_indexed_property_callback__)
+  , set_indexed_property_callback__(builder.set_indexed_property_callback__)
+  , get_length_callback__(builder.get_length_callback__)
   , call_as_function_callback__(builder.call_as_function_callback__)
   , convert_to_type_callback__(builder.convert_to_type_callback__) {
     InitializeNamedPropertyCallbacks();
@@ -0,0 +1,215 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSEXPORTCLASSINFO_HPP_
+#define _HAL_DETAIL_JSEXPORTCLASSINFO_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/detail/JSExportPool.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+
+namespace HAL {
+  class JSExportObject;
+}
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion A JSExportClassInfo describes the C++ class of the
+   native objects that JSExportClass creates for one JSExport class.
+   The JSExportPool header in front of every native object points to
+   it, so the class of a JavaScript object's private data is known
+   without RTTI.
+
+   Each exported class gets a compact id when its JSClass is created,
+   and a link to the JSExportClassInfo of the parent set by
+   JSExport::SetParent if that parent is also an exported class.
+   Whether a native object is an instance of an exported class is then
+   an integer compare for each class in its parent chain.
+
+   A JSExportClassInfo is never destroyed while it has native
+   objects, since they are destroyed through it.
+   */
+  class HAL_EXPORT JSExportClassInfo final {
+
+  public:
+
+    // Destroys a native object without releasing its memory.
+    typedef void (*Destructor_t)(void* object);
+
+    /*!
+     @method
+
+     @abstract Create the class info for the native objects of a
+     JSClass, giving it the next class id. The parent is found among
+     the JSClasses registered this way, and is nullptr if the parent
+     JSClass isn't an exported class.
+     */
+    explicit JSExportClassInfo(Destructor_t destructor, JSClassRef js_class_ref = nullptr, JSClassRef parent_js_class_ref = nullptr, bool js_export_object = false);
+
+    ~JSExportClassInfo() HAL_NOEXCEPT;
+
+    std::uint32_t get_id() const HAL_NOEXCEPT {
+      return id__;
+    }
+
+    const JSExportClassInfo* get_parent() const HAL_NOEXCEPT {
+      return parent__;
+    }
+
+    Destructor_t get_destructor() const HAL_NOEXCEPT {
+      return destructor__;
+    }
+
+    // Return true if the native objects derive from JSExportObject.
+    bool is_js_export_object() const HAL_NOEXCEPT {
+      return js_export_object__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return true if this is the class with the given id, or
+     if that class is in this class' parent chain.
+     */
+    bool IsA(std::uint32_t id) const HAL_NOEXCEPT {
+      for (auto class_info = this; class_info; class_info = class_info->parent__) {
+        if (class_info->id__ == id) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /*!
+     @method
+
+     @abstract Return true if a JavaScript object was created from the
+     JSClass of an exported class, or from a JSClass derived from one,
+     so that its private data is a native object created by
+     JSExportClass.
+
+     @discussion Other JavaScript objects may have private data too,
+     such as the functions created from native callbacks, but without
+     the JSExportPool header that JSExportCast reads. The JSClass
+     given as a hint is checked before all the others.
+     */
+    static bool IsJSExportObject(JSContextRef context_ref, JSObjectRef object_ref, JSClassRef hint_js_class_ref = nullptr) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the class info of a live native object created
+     by JSExportClass, or nullptr if the pointer isn't one.
+
+     @discussion Only the private data of a JavaScript object, or
+     another pointer into allocated memory, may be passed, since the
+     JSExportPool header before it is read. The pointer recorded there
+     is only compared with the registered class infos, never
+     dereferenced.
+     */
+    static const JSExportClassInfo* FindClassInfo(const void* native_object_ptr) HAL_NOEXCEPT;
+
+    JSExportClassInfo(const JSExportClassInfo&)            = delete;
+    JSExportClassInfo& operator=(const JSExportClassInfo&) = delete;
+
+  private:
+
+    Destructor_t             destructor__;
+    std::uint32_t            id__;
+    const JSExportClassInfo* parent__;
+    JSClassRef               js_class_ref__;
+    bool                     js_export_object__;
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    static std::uint32_t next_id__;
+    static std::unordered_map<JSClassRef, const JSExportClassInfo*> js_class_registry__;
+#pragma warning(pop)
+
+#undef  HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC
+#ifdef  HAL_THREAD_SAFE
+    static std::recursive_mutex mutex_static__;
+#define HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC std::lock_guard<std::recursive_mutex> lock_static(JSExportClassInfo::mutex_static__)
+#else
+#define HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC
+#endif  // HAL_THREAD_SAFE
+  };
+
+  /*!
+   @class
+
+   @discussion The class id and JSClass of JSExport class T, or 0 and
+   nullptr until its JSClass has been created.
+   */
+  template<typename T>
+  struct JSExportClassId {
+    static std::uint32_t value;
+    static JSClassRef    js_class_ref;
+  };
+
+  template<typename T>
+  std::uint32_t JSExportClassId<T>::value { 0 };
+
+  template<typename T>
+  JSClassRef JSExportClassId<T>::js_class_ref { nullptr };
+
+  // The private data of a JavaScript object of an exported class is a
+  // native object created by JSExportClass, which derives from
+  // JSExportObject.
+  template<typename T>
+  T* JSExportCast(void* native_object_ptr, std::true_type) HAL_NOEXCEPT {
+    const auto js_export_object_ptr = static_cast<JSExportObject*>(native_object_ptr);
+    if (std::is_same<T, JSExportObject>::value) {
+      return static_cast<T*>(js_export_object_ptr);
+    }
+
+    // A parent chain set with JSExport::SetParent follows the C++
+    // class hierarchy, so a match doesn't need a dynamic_cast.
+    const auto id = JSExportClassId<T>::value;
+    if (id != 0 && JSExportPool::GetClassInfo(native_object_ptr).IsA(id)) {
+      assert(dynamic_cast<T*>(js_export_object_ptr) == static_cast<T*>(js_export_object_ptr));
+      return static_cast<T*>(js_export_object_ptr);
+    }
+
+    // T may still be a C++ base class that isn't in the parent chain.
+    return dynamic_cast<T*>(js_export_object_ptr);
+  }
+
+  template<typename T>
+  T* JSExportCast(void* native_object_ptr, std::false_type) HAL_NOEXCEPT {
+    return dynamic_cast<T*>(static_cast<JSExportObject*>(native_object_ptr));
+  }
+
+  /*!
+   @function
+
+   @abstract Return the private data of a JavaScript object as a T*,
+   or nullptr if it has none, it isn't a native object created by
+   JSExportClass, or it isn't a T.
+   */
+  template<typename T>
+  T* JSExportCast(JSContextRef context_ref, JSObjectRef object_ref) HAL_NOEXCEPT {
+    void* native_object_ptr = JSObjectGetPrivate(object_ref);
+    if (!native_object_ptr || !JSExportClassInfo::IsJSExportObject(context_ref, object_ref, JSExportClassId<T>::js_class_ref)) {
+      return nullptr;
+    }
+    return JSExportCast<T>(native_object_ptr, std::integral_constant<bool, std::is_base_of<JSExportObject, T>::value>());
+  }
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSEXPORTCLASSINFO_HPP_
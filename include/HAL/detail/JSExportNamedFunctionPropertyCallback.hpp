@@ -13,6 +13,7 @@
 #include "HAL/detail/JSPropertyCallback.hpp"
 #include "HAL/detail/JSExportCallbacks.hpp"
 #include "HAL/detail/JSUtil.hpp"
+#include "HAL/JSArguments.hpp"
 
 #ifdef HAL_PERFORMANCE_COUNTER_ENABLE
 #include "HAL/detail/JSPerformanceCounter.hpp"
@@ -73,10 +74,45 @@ namespace HAL { namespace detail {
                                           CallNamedFunctionCallback<T> function_callback,
                                           const std::unordered_set<JSPropertyAttribute>& attributes);
     
-    CallNamedFunctionCallback<T> function_callback() const {
+    /*!
+     @method
+     
+     @abstract Create a callback to invoke when a JavaScript object
+     is called as a function, passing the arguments as a JSArguments
+     view instead of a std::vector of JSValues.
+     
+     @throws std::invalid_argument exception under the same
+     preconditions as the std::vector overload.
+     */
+    JSExportNamedFunctionPropertyCallback(const std::string& function_name,
+                                          CallNamedFunctionArgumentsCallback<T> function_callback,
+                                          const std::unordered_set<JSPropertyAttribute>& attributes);
+    
+    /*!
+     @method
+     
+     @abstract Create a function property implemented directly by a
+     JavaScriptCore C API callback, such as one generated by
+     JSExportClass for a pointer to member function.
+     
+     @throws std::invalid_argument exception under the same
+     preconditions as the std::vector overload.
+     */
+    JSExportNamedFunctionPropertyCallback(const std::string& function_name,
+                                          ::JSObjectCallAsFunctionCallback native_callback,
+                                          const std::unordered_set<JSPropertyAttribute>& attributes);
+    
+    // Callbacks taking a std::vector of JSValues are stored wrapped in
+    // a CallNamedFunctionArgumentsCallback that copies the arguments.
+    // This is nullptr if the property has a native callback.
+    const CallNamedFunctionArgumentsCallback<T>& function_callback() const {
       return function_callback__;
     }
     
+    ::JSObjectCallAsFunctionCallback native_callback() const HAL_NOEXCEPT {
+      return native_callback__;
+    }
+    
     ~JSExportNamedFunctionPropertyCallback()                                                       = default;
     JSExportNamedFunctionPropertyCallback(const JSExportNamedFunctionPropertyCallback&)            HAL_NOEXCEPT;
     JSExportNamedFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback&&)                 HAL_NOEXCEPT;
@@ -89,7 +125,8 @@ namespace HAL { namespace detail {
     template<typename U>
     friend bool operator==(const JSExportNamedFunctionPropertyCallback<U>& lhs, const JSExportNamedFunctionPropertyCallback<U>& rhs) HAL_NOEXCEPT;
     
-    CallNamedFunctionCallback<T> function_callback__ { nullptr };
+    CallNamedFunctionArgumentsCallback<T> function_callback__ { nullptr };
+    ::JSObjectCallAsFunctionCallback      native_callback__   { nullptr };
   };
   
   template<typename T>
@@ -97,6 +134,22 @@ namespace HAL { namespace detail {
                                                                                   const std::string& function_name,
                                                                                   CallNamedFunctionCallback<T> function_callback,
                                                                                   const std::unordered_set<JSPropertyAttribute>& attributes)
+  : JSPropertyCallback(function_name, attributes) {
+    
+    if (!function_callback) {
+      ThrowInvalidArgument("JSExportNamedFunctionPropertyCallback", "function_callback is missing");
+    }
+    
+    function_callback__ = [function_callback](T& native_object, const JSArguments& arguments, JSObject& this_object) {
+      return function_callback(native_object, arguments.to_vector(), this_object);
+    };
+  }
+  
+  template<typename T>
+  JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(
+                                                                                  const std::string& function_name,
+                                                                                  CallNamedFunctionArgumentsCallback<T> function_callback,
+                                                                                  const std::unordered_set<JSPropertyAttribute>& attributes)
   : JSPropertyCallback(function_name, attributes)
   , function_callback__(function_callback) {
     
@@ -105,16 +158,31 @@ namespace HAL { namespace detail {
     }
   }
   
+  template<typename T>
+  JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(
+                                                                                  const std::string& function_name,
+                                                                                  ::JSObjectCallAsFunctionCallback native_callback,
+                                                                                  const std::unordered_set<JSPropertyAttribute>& attributes)
+  : JSPropertyCallback(function_name, attributes)
+  , native_callback__(native_callback) {
+    
+    if (!native_callback) {
+      ThrowInvalidArgument("JSExportNamedFunctionPropertyCallback", "native_callback is missing");
+    }
+  }
+  
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(const JSExportNamedFunctionPropertyCallback& rhs) HAL_NOEXCEPT
   : JSPropertyCallback(rhs)
-  , function_callback__(rhs.function_callback__) {
+  , function_callback__(rhs.function_callback__)
+  , native_callback__(rhs.native_callback__) {
   }
   
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback&& rhs) HAL_NOEXCEPT
   : JSPropertyCallback(rhs)
-  , function_callback__(std::move(rhs.function_callback__)) {
+  , function_callback__(std::move(rhs.function_callback__))
+  , native_callback__(rhs.native_callback__) {
   }
   
   template<typename T>
@@ -122,6 +190,7 @@ namespace HAL { namespace detail {
     HAL_DETAIL_JSPROPERTYCALLBACK_LOCK_GUARD;
     JSPropertyCallback::operator=(rhs);
     function_callback__ = rhs.function_callback__;
+    native_callback__   = rhs.native_callback__;
     return *this;
   }
   
@@ -141,6 +210,7 @@ namespace HAL { namespace detail {
     // By swapping the members of two classes, the two classes are
     // effectively swapped.
     swap(function_callback__, other.function_callback__);
+    swap(native_callback__  , other.native_callback__);
   }
   
   template<typename T>
@@ -160,6 +230,10 @@ namespace HAL { namespace detail {
       return false;
     }
     
+    if (lhs.native_callback__ != rhs.native_callback__) {
+      return false;
+    }
+    
     return static_cast<JSPropertyCallback>(lhs) == static_cast<JSPropertyCallback>(rhs);
   }
   
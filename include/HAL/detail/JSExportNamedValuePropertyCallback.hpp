@@ -66,11 +66,11 @@ namespace HAL { namespace detail {
                                        SetNamedValuePropertyCallback<T> set_callback,
                                        const std::unordered_set<JSPropertyAttribute>& attributes);
     
-    GetNamedValuePropertyCallback<T> get_callback() const HAL_NOEXCEPT {
+    const GetNamedValuePropertyCallback<T>& get_callback() const HAL_NOEXCEPT {
       return get_callback__;
     }
     
-    SetNamedValuePropertyCallback<T> set_callback() const HAL_NOEXCEPT {
+    const SetNamedValuePropertyCallback<T>& set_callback() const HAL_NOEXCEPT {
       return set_callback__;
     }
     
@@ -0,0 +1,197 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSEXPORTPOOL_HPP_
+#define _HAL_DETAIL_JSEXPORTPOOL_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+#include <atomic>
+#endif
+
+// The number of native objects in each slab of a JSExportPool.
+#ifndef HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT
+#define HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT 64
+#endif
+
+namespace HAL { namespace detail {
+
+  class JSExportClassInfo;
+
+  /*!
+   @class
+
+   @discussion A JSExportPool hands out fixed-size slots for the
+   native objects of one JSExport class, carved from slabs that each
+   hold HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT objects, so that creating and
+   finalizing JavaScript objects doesn't allocate and free memory for
+   each one.
+
+   Every native object that JSExportClass creates is preceded by a
+   small header recording its JSExportClassInfo and where its memory
+   came from, whether a pool or the heap (see AllocateUnpooled). This
+   lets Destroy release any native object without knowing its type,
+   which matters because JavaScriptCore runs the initialize callback
+   of every class in a parent chain on the same object.
+
+   A slab is released once all of its objects have been finalized,
+   except for one empty slab that each pool keeps for reuse. Because
+   JavaScriptCore finalizes every object when a context group is torn
+   down, this releases the slabs of a discarded context group in bulk.
+
+   This class is thread safe if HAL_THREAD_SAFE is defined.
+   */
+  class HAL_EXPORT JSExportPool final {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a pool of slots for objects of the given size
+     and alignment. The alignment must be at most that of
+     std::max_align_t.
+     */
+    JSExportPool(std::size_t object_size, std::size_t object_alignment);
+
+    // A pool is never destroyed while it has objects, since it is
+    // found through them.
+    ~JSExportPool() HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return uninitialized memory for one object from this
+     pool, recording the class info whose destructor Destroy should
+     call.
+     */
+    void* Allocate(const JSExportClassInfo& class_info);
+
+    /*!
+     @method
+
+     @abstract Return uninitialized memory for one object from the
+     heap, with the same header as a pooled object so that Destroy can
+     release it.
+     */
+    static void* AllocateUnpooled(std::size_t object_size, const JSExportClassInfo& class_info);
+
+    /*!
+     @method
+
+     @abstract Call the destructor of the recorded class info of an
+     object returned by Allocate or AllocateUnpooled, then release its
+     memory.
+     */
+    static void Destroy(void* object) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the class info recorded for an object returned
+     by Allocate or AllocateUnpooled.
+     */
+    static const JSExportClassInfo& GetClassInfo(const void* object) HAL_NOEXCEPT {
+      return *GetRecordedClassInfo(object);
+    }
+
+    /*!
+     @method
+
+     @abstract Return the class info pointer recorded in the header
+     before an object without dereferencing it, which is nullptr once
+     the object has been released.
+
+     @discussion Please see JSExportClassInfo::FindClassInfo to check
+     whether the result is a class info at all.
+     */
+    static const JSExportClassInfo* GetRecordedClassInfo(const void* object) HAL_NOEXCEPT {
+      return reinterpret_cast<const Header*>(static_cast<const char*>(object) - GetHeaderSize())->class_info;
+    }
+
+    /*!
+     @method
+
+     @abstract Release the memory of an object returned by Allocate or
+     AllocateUnpooled without calling its destructor, for example when
+     its constructor threw.
+     */
+    static void Deallocate(void* object) HAL_NOEXCEPT;
+
+    // The number of objects in this pool, the number of slabs, and
+    // the number of objects they can hold.
+    std::size_t get_slots_in_use() const HAL_NOEXCEPT;
+    std::size_t get_slab_count()   const HAL_NOEXCEPT;
+    std::size_t get_slot_count()   const HAL_NOEXCEPT;
+
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+    // The same totals over all pools.
+    static long get_total_slots_in_use() {
+      return total_slots_in_use__;
+    }
+
+    static long get_total_slab_count() {
+      return total_slab_count__;
+    }
+#endif
+
+    JSExportPool(const JSExportPool&)            = delete;
+    JSExportPool& operator=(const JSExportPool&) = delete;
+
+  private:
+
+    struct Slab;
+
+    // Precedes every object.
+    struct Header {
+      Slab*                    slab;
+      const JSExportClassInfo* class_info;
+    };
+
+    static Header* GetHeader(void* object) HAL_NOEXCEPT;
+
+    // The size of a Header rounded up so that the object after it is
+    // aligned for any type.
+    static std::size_t GetHeaderSize() HAL_NOEXCEPT {
+      return (sizeof(Header) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+    }
+
+    Slab* CreateSlab();
+    void  Release(Header* header) HAL_NOEXCEPT;
+
+    // Slabs with at least one free slot are kept in a doubly-linked
+    // list so that allocating never searches.
+    void LinkAvailable(Slab* slab) HAL_NOEXCEPT;
+    void UnlinkAvailable(Slab* slab) HAL_NOEXCEPT;
+
+    std::size_t slot_size__;
+    Slab*       available_slabs__ { nullptr };
+    std::size_t empty_slab_count__ { 0 };
+    std::size_t slab_count__       { 0 };
+    std::size_t slots_in_use__     { 0 };
+
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+    static std::atomic<long> total_slots_in_use__;
+    static std::atomic<long> total_slab_count__;
+#endif
+
+#undef  HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD
+#ifdef  HAL_THREAD_SAFE
+    mutable std::recursive_mutex mutex__;
+#define HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD std::lock_guard<std::recursive_mutex> lock(mutex__)
+#else
+#define HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD
+#endif  // HAL_THREAD_SAFE
+  };
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSEXPORTPOOL_HPP_
@@ -0,0 +1,142 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSHANDLEREGISTRY_HPP_
+#define _HAL_DETAIL_JSHANDLEREGISTRY_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion A JSHandleRegistry counts the references that HAL
+   wrappers hold to a JavaScriptCore handle, so that the handle is
+   protected from garbage collection exactly once no matter how many
+   wrappers share it. Each handle may also carry the context it was
+   first registered with.
+
+   The registry is an open-addressing hash table with linear probing
+   and backward-shift deletion. Every operation is a single probe
+   sequence over a flat array of cells, and memory is only allocated
+   when the table grows.
+
+   A JSHandleRegistry is not thread safe; callers provide their own
+   locking.
+   */
+  class HAL_EXPORT JSHandleRegistry final {
+
+  public:
+
+    JSHandleRegistry() HAL_NOEXCEPT;
+    ~JSHandleRegistry() HAL_NOEXCEPT;
+
+    JSHandleRegistry(const JSHandleRegistry&)            = delete;
+    JSHandleRegistry& operator=(const JSHandleRegistry&) = delete;
+
+    /*!
+     @method
+
+     @abstract Add a reference to a handle.
+
+     @param handle The handle to add a reference to. Must not be
+     nullptr.
+
+     @param context The context to record if this is the first
+     reference to the handle. Ignored otherwise.
+
+     @result The number of references to the handle after this one
+     was added. A result of 1 means the handle was not registered
+     before and the caller should protect it.
+     */
+    std::size_t Retain(const void* handle, const void* context = nullptr);
+
+    /*!
+     @method
+
+     @abstract Remove a reference to a handle.
+
+     @param handle The handle to remove a reference from.
+
+     @param count Set to the number of references remaining. A count
+     of 0 means the handle is no longer registered and the caller
+     should unprotect it.
+
+     @param context Set to the context recorded when the handle was
+     first registered.
+
+     @result false if the handle was not registered, in which case
+     count and context are left unchanged.
+     */
+    bool Release(const void* handle, std::size_t& count, const void*& context) HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the context recorded when a handle was first
+     registered, or nullptr if the handle is not registered.
+     */
+    const void* FindContext(const void* handle) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the number of references to a handle, or 0 if
+     the handle is not registered.
+     */
+    std::size_t GetCount(const void* handle) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the number of registered handles.
+     */
+    std::size_t size() const HAL_NOEXCEPT {
+      return size__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the number of cells in the table.
+     */
+    std::size_t capacity() const HAL_NOEXCEPT {
+      return mask__ ? mask__ + 1 : 0;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the index of the cell at which the probe
+     sequence for a handle starts. The result depends on capacity()
+     and is only meaningful once the table has been allocated.
+     */
+    std::size_t Hash(const void* handle) const HAL_NOEXCEPT;
+
+  private:
+
+    struct Cell {
+      const void* handle;
+      const void* context;
+      std::size_t count;
+    };
+
+    std::size_t Find(const void* handle) const HAL_NOEXCEPT;
+    void        Grow();
+
+    Cell*       cells__ { nullptr };
+    std::size_t mask__  { 0 };
+    std::size_t size__  { 0 };
+  };
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSHANDLEREGISTRY_HPP_
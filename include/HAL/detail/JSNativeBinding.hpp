@@ -0,0 +1,358 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSNATIVEBINDING_HPP_
+#define _HAL_DETAIL_JSNATIVEBINDING_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
+#include "HAL/detail/JSNativeCallable.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/JSArguments.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace HAL { namespace detail {
+
+  /*!
+   @discussion The templates in this file convert the raw JSValueRef
+   arguments of a JavaScriptCore callback directly into the parameter
+   types of a C++ function, and its result back into a JSValueRef, so
+   that a function whose signature is known at compile-time can be
+   called from JavaScript without a std::function or a std::vector of
+   JSValues in between.
+
+   The supported parameter types are bool, the arithmetic types of at
+   most 32 bits, float, double, std::string, JSString, JSValue and
+   JSObject, passed by value or by const reference. The same types,
+   any type derived from JSValue or JSObject, and void are supported
+   as return types.
+
+   JSPreparedCall uses the same conversions in the other direction,
+   to pass C++ values as the arguments of a JavaScript function. A
+   string literal can be passed there as well.
+   */
+
+  // C++11 lacks std::index_sequence.
+  template<std::size_t... I>
+  struct JSNativeIndexSequence {
+  };
+
+  template<std::size_t N, std::size_t... I>
+  struct JSNativeMakeIndexSequence : JSNativeMakeIndexSequence<N - 1, N - 1, I...> {
+  };
+
+  template<std::size_t... I>
+  struct JSNativeMakeIndexSequence<0, I...> {
+    typedef JSNativeIndexSequence<I...> type;
+  };
+
+  template<typename U, typename Enable = void>
+  struct JSNativeConverter;
+
+  template<>
+  struct JSNativeConverter<bool> {
+    static bool FromJS(const JSArguments& arguments, std::size_t index) {
+      return arguments.GetBoolean(index);
+    }
+
+    static JSValueRef ToJS(JSContextRef js_context_ref, bool value) HAL_NOEXCEPT {
+      return JSValueMakeBoolean(js_context_ref, value);
+    }
+  };
+
+  template<typename U>
+  struct JSNativeConverter<U, typename std::enable_if<std::is_floating_point<U>::value>::type> {
+    static U FromJS(const JSArguments& arguments, std::size_t index) {
+      return static_cast<U>(arguments.GetNumber(index));
+    }
+
+    static JSValueRef ToJS(JSContextRef js_context_ref, U value) HAL_NOEXCEPT {
+      return JSValueMakeNumber(js_context_ref, static_cast<double>(value));
+    }
+  };
+
+  // Integers are converted with the JavaScript ToInt32 operation, so
+  // wider integers would silently lose their upper bits.
+  template<typename U>
+  struct JSNativeConverter<U, typename std::enable_if<std::is_integral<U>::value && !std::is_same<U, bool>::value>::type> {
+    static_assert(sizeof(U) <= sizeof(std::int32_t), "HAL: integers wider than 32 bits can't be converted from a JavaScript number without loss");
+
+    static U FromJS(const JSArguments& arguments, std::size_t index) {
+      return static_cast<U>(arguments.GetInt32(index));
+    }
+
+    static JSValueRef ToJS(JSContextRef js_context_ref, U value) HAL_NOEXCEPT {
+      return JSValueMakeNumber(js_context_ref, static_cast<double>(value));
+    }
+  };
+
+  template<>
+  struct JSNativeConverter<std::string> {
+    static std::string FromJS(const JSArguments& arguments, std::size_t index) {
+      return arguments.GetString(index);
+    }
+
+    static JSValueRef ToJS(JSContextRef js_context_ref, const std::string& value) HAL_NOEXCEPT {
+      JSStringRef js_string_ref = JSStringCreateWithUTF8(value.data(), value.size());
+      JSValueRef  js_value_ref  = JSValueMakeString(js_context_ref, js_string_ref);
+      JSStringRelease(js_string_ref);
+      return js_value_ref;
+    }
+  };
+
+  template<>
+  struct JSNativeConverter<JSString> {
+    static JSString FromJS(const JSArguments& arguments, std::size_t index) {
+      return arguments.GetJSString(index);
+    }
+
+    static JSValueRef ToJS(JSContextRef js_context_ref, const JSString& value) HAL_NOEXCEPT {
+      return JSValueMakeString(js_context_ref, static_cast<JSStringRef>(value));
+    }
+  };
+
+  // JSValue and JSObject are also the converters for the classes
+  // derived from them, which are returned as the JSValueRef or
+  // JSObjectRef they wrap.
+  template<>
+  struct JSNativeConverter<JSValue> {
+    static JSValue FromJS(const JSArguments& arguments, std::size_t index) HAL_NOEXCEPT {
+      return arguments[index];
+    }
+
+    static JSValueRef ToJS(JSContextRef, const JSValue& value) HAL_NOEXCEPT {
+      return static_cast<JSValueRef>(value);
+    }
+  };
+
+  template<>
+  struct JSNativeConverter<JSObject> {
+    static JSObject FromJS(const JSArguments& arguments, std::size_t index) {
+      return arguments.GetObject(index);
+    }
+
+    static JSValueRef ToJS(JSContextRef, const JSObject& value) HAL_NOEXCEPT {
+      return static_cast<JSObjectRef>(value);
+    }
+  };
+
+  // Only for passing a string literal to JavaScript.
+  template<>
+  struct JSNativeConverter<const char*> {
+    static JSValueRef ToJS(JSContextRef js_context_ref, const char* value) HAL_NOEXCEPT {
+      JSStringRef js_string_ref = JSStringCreateWithUTF8CString(value);
+      JSValueRef  js_value_ref  = JSValueMakeString(js_context_ref, js_string_ref);
+      JSStringRelease(js_string_ref);
+      return js_value_ref;
+    }
+  };
+  
+  template<typename U>
+  struct JSNativeArgument {
+    typedef typename std::decay<U>::type type;
+  };
+  
+  // The converter of a C++ value of type U to JavaScript.
+  template<typename U>
+  struct JSNativeToJS {
+    typedef typename std::decay<U>::type value_type;
+    typedef typename std::conditional<std::is_base_of<JSValue, value_type>::value,
+                                      JSNativeConverter<JSValue>,
+                                      typename std::conditional<std::is_base_of<JSObject, value_type>::value,
+                                                                JSNativeConverter<JSObject>,
+                                                                JSNativeConverter<value_type>>::type>::type type;
+  };
+
+  // Convert the result of calling a native function, or undefined if
+  // it returns void.
+  template<typename R>
+  struct JSNativeResult {
+    template<typename F, typename... A>
+    static JSValueRef Call(JSContextRef js_context_ref, F& function, A&... arguments) {
+      return JSNativeToJS<R>::type::ToJS(js_context_ref, function(arguments...));
+    }
+  };
+
+  template<>
+  struct JSNativeResult<void> {
+    template<typename F, typename... A>
+    static JSValueRef Call(JSContextRef js_context_ref, F& function, A&... arguments) {
+      function(arguments...);
+      return JSValueMakeUndefined(js_context_ref);
+    }
+  };
+
+  /*!
+   @class
+
+   @discussion A JSNativeSignature calls a C++ function whose result
+   type is R and whose parameter types are Args with the arguments of
+   a JavaScriptCore callback. Missing arguments are converted from
+   undefined. The arguments are converted from left to right, before
+   the function is called.
+   */
+  template<typename R, typename... Args>
+  struct JSNativeSignature {
+    template<typename F>
+    static JSValueRef Call(F& function, const JSArguments& arguments) {
+      return Call(function, arguments, typename JSNativeMakeIndexSequence<sizeof...(Args)>::type());
+    }
+
+  private:
+
+    template<typename F, std::size_t... I>
+    static JSValueRef Call(F& function, const JSArguments& arguments, JSNativeIndexSequence<I...>) {
+      static_cast<void>(arguments);
+      // The elements of a braced initializer list are evaluated in
+      // order, unlike the arguments of a function call.
+      std::tuple<typename JSNativeArgument<Args>::type...> native_arguments { JSNativeConverter<typename JSNativeArgument<Args>::type>::FromJS(arguments, I)... };
+      return JSNativeResult<R>::Call(static_cast<JSContextRef>(arguments.get_context()), function, std::get<I>(native_arguments)...);
+    }
+  };
+
+  // Calls a pointer to member function on an object.
+  template<typename C, typename M, typename R>
+  struct JSNativeBoundMethod {
+    C& object;
+    M  method;
+
+    template<typename... A>
+    R operator()(A&... arguments) const {
+      return (object.*method)(arguments...);
+    }
+  };
+
+  /*!
+   @class
+
+   @discussion JSNativeMethod deduces the class, result and parameter
+   types of a pointer to member function of type M.
+   */
+  template<typename M>
+  struct JSNativeMethod;
+
+  template<typename C, typename R, typename... Args>
+  struct JSNativeMethod<R (C::*)(Args...)> {
+    typedef C class_type;
+
+    static JSValueRef Call(C& object, R (C::*method)(Args...), const JSArguments& arguments) {
+      JSNativeBoundMethod<C, R (C::*)(Args...), R> function { object, method };
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+
+  template<typename C, typename R, typename... Args>
+  struct JSNativeMethod<R (C::*)(Args...) const> {
+    typedef C class_type;
+
+    static JSValueRef Call(const C& object, R (C::*method)(Args...) const, const JSArguments& arguments) {
+      JSNativeBoundMethod<const C, R (C::*)(Args...) const, R> function { object, method };
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+
+#ifdef __cpp_noexcept_function_type
+  // Since C++17 noexcept is part of a function's type.
+  template<typename C, typename R, typename... Args>
+  struct JSNativeMethod<R (C::*)(Args...) noexcept> {
+    typedef C class_type;
+
+    static JSValueRef Call(C& object, R (C::*method)(Args...) noexcept, const JSArguments& arguments) {
+      JSNativeBoundMethod<C, R (C::*)(Args...) noexcept, R> function { object, method };
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+
+  template<typename C, typename R, typename... Args>
+  struct JSNativeMethod<R (C::*)(Args...) const noexcept> {
+    typedef C class_type;
+
+    static JSValueRef Call(const C& object, R (C::*method)(Args...) const noexcept, const JSArguments& arguments) {
+      JSNativeBoundMethod<const C, R (C::*)(Args...) const noexcept, R> function { object, method };
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+#endif
+
+  /*!
+   @class
+
+   @discussion JSNativeCallable calls a function pointer, or a
+   function object such as a lambda, for which IsJSNativeCallable is
+   true.
+   */
+  template<typename F>
+  struct JSNativeCallable {
+    static JSValueRef Call(F& function, const JSArguments& arguments) {
+      return JSNativeMethod<decltype(&F::operator())>::Call(function, &F::operator(), arguments);
+    }
+  };
+
+  template<typename R, typename... Args>
+  struct JSNativeCallable<R (*)(Args...)> {
+    static JSValueRef Call(R (*function)(Args...), const JSArguments& arguments) {
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+
+#ifdef __cpp_noexcept_function_type
+  template<typename R, typename... Args>
+  struct JSNativeCallable<R (*)(Args...) noexcept> {
+    static JSValueRef Call(R (*function)(Args...) noexcept, const JSArguments& arguments) {
+      return JSNativeSignature<R, Args...>::Call(function, arguments);
+    }
+  };
+#endif
+
+  // Convert the value returned by a JavaScript function to R.
+  template<typename R>
+  struct JSNativeFromJS {
+    static R Convert(const JSContext& js_context, JSValueRef js_value_ref) {
+      const JSArguments result(js_context, 1, &js_value_ref);
+      return JSNativeConverter<typename std::decay<R>::type>::FromJS(result, 0);
+    }
+  };
+
+  template<>
+  struct JSNativeFromJS<void> {
+    static void Convert(const JSContext&, JSValueRef) HAL_NOEXCEPT {
+    }
+  };
+
+}} // namespace HAL { namespace detail {
+
+namespace HAL {
+
+  template<typename R, typename... Args>
+  R JSObject::Call(const JSObject& this_object, Args&&... arguments) {
+    const auto js_context_ref = static_cast<JSContextRef>(js_context__);
+    // The extra element keeps the array non-empty when there are no
+    // arguments.
+    const JSValueRef arguments_array[] = { detail::JSNativeToJS<Args>::type::ToJS(js_context_ref, arguments)..., nullptr };
+    const auto js_value_ref = CallWithArray(static_cast<JSObjectRef>(this_object), sizeof...(Args), arguments_array);
+    return detail::JSNativeFromJS<R>::Convert(js_context__, js_value_ref);
+  }
+
+  template<typename... Args>
+  JSObject JSObject::Construct(Args&&... arguments) {
+    const auto js_context_ref = static_cast<JSContextRef>(js_context__);
+    const JSValueRef arguments_array[] = { detail::JSNativeToJS<Args>::type::ToJS(js_context_ref, arguments)..., nullptr };
+    return JSObject(js_context__, ConstructWithArray(sizeof...(Args), arguments_array));
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_DETAIL_JSNATIVEBINDING_HPP_
@@ -0,0 +1,54 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSNATIVECALLABLE_HPP_
+#define _HAL_DETAIL_JSNATIVECALLABLE_HPP_
+
+#include <functional>
+#include <type_traits>
+
+namespace HAL { namespace detail {
+
+  template<typename F>
+  struct IsStdFunction : std::false_type {
+  };
+
+  template<typename S>
+  struct IsStdFunction<std::function<S>> : std::true_type {
+  };
+
+  /*!
+   @class
+
+   @discussion IsJSNativeCallable is true for a function pointer, or
+   for a function object such as a lambda with a single, non-template
+   function call operator, whose signature can therefore be deduced.
+   It is false for any other type, including std::function, whose
+   signature is erased.
+   */
+  template<typename F, typename Enable = void>
+  struct IsJSNativeCallable : std::false_type {
+  };
+
+  template<typename R, typename... Args>
+  struct IsJSNativeCallable<R (*)(Args...)> : std::true_type {
+  };
+
+#ifdef __cpp_noexcept_function_type
+  template<typename R, typename... Args>
+  struct IsJSNativeCallable<R (*)(Args...) noexcept> : std::true_type {
+  };
+#endif
+
+  template<typename F>
+  struct IsJSNativeCallable<F, typename std::enable_if<std::is_class<F>::value && !IsStdFunction<F>::value && std::is_member_function_pointer<decltype(&F::operator())>::value>::type> : std::true_type {
+  };
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSNATIVECALLABLE_HPP_
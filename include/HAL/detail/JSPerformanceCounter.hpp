@@ -49,6 +49,24 @@ namespace HAL { namespace detail {
       return objects_move_assigned_;
     }
     
+    static long get_references_retained() {
+      return references_retained_;
+    }
+    
+    static long get_references_released() {
+      return references_released_;
+    }
+    
+    // Called by the wrappers each time they retain or release their
+    // underlying JavaScriptCore reference.
+    static void reference_retained() {
+      ++references_retained_;
+    }
+    
+    static void reference_released() {
+      ++references_released_;
+    }
+    
     JSPerformanceCounter() {
       ++objects_alive_;
       ++objects_created_;
@@ -98,6 +116,8 @@ namespace HAL { namespace detail {
     static std::atomic<long> objects_move_constructed_;
     static std::atomic<long> objects_copy_assigned_;
     static std::atomic<long> objects_move_assigned_;
+    static std::atomic<long> references_retained_;
+    static std::atomic<long> references_released_;
   };
   
   template<typename T>
@@ -121,14 +141,24 @@ namespace HAL { namespace detail {
   template<typename T>
   std::atomic<long> JSPerformanceCounter<T>::objects_move_assigned_;
   
+  template<typename T>
+  std::atomic<long> JSPerformanceCounter<T>::references_retained_;
+  
+  template<typename T>
+  std::atomic<long> JSPerformanceCounter<T>::references_released_;
+  
   
 }} // namespace HAL { namespace detail {
 
 #define HAL_PERFORMANCE_COUNTER1(class_name) : public detail::JSPerformanceCounter<class_name>
 #define HAL_PERFORMANCE_COUNTER2(class_name) , public detail::JSPerformanceCounter<class_name>
+#define HAL_PERFORMANCE_COUNTER_RETAIN(class_name) detail::JSPerformanceCounter<class_name>::reference_retained()
+#define HAL_PERFORMANCE_COUNTER_RELEASE(class_name) detail::JSPerformanceCounter<class_name>::reference_released()
 #else
 #define HAL_PERFORMANCE_COUNTER1(class_name)
 #define HAL_PERFORMANCE_COUNTER2(class_name)
+#define HAL_PERFORMANCE_COUNTER_RETAIN(class_name)
+#define HAL_PERFORMANCE_COUNTER_RELEASE(class_name)
 #endif // HAL_PERFORMANCE_COUNTER_ENABLE
 
 #endif // _HAL_DETAIL_JSPERFORMANCECOUNTER_HPP_
@@ -120,6 +120,15 @@ namespace HAL { namespace detail {
       std::clog << "JSArray:                   objects_copy_assigned    = " << JSPerformanceCounter<JSArray>::get_objects_copy_assigned()    << std::endl;
       std::clog << "JSArray:                   objects_move_assigned    = " << JSPerformanceCounter<JSArray>::get_objects_move_assigned()    << std::endl;
       
+      std::clog << std::endl;
+      std::clog << "JSArrayBuffer:             objects_alive            = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_alive()            << std::endl;
+      std::clog << "JSArrayBuffer:             objects_created          = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_created()          << std::endl;
+      std::clog << "JSArrayBuffer:             objects_destroyed        = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_destroyed()        << std::endl;
+      std::clog << "JSArrayBuffer:             objects_copy_constructed = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_copy_constructed() << std::endl;
+      std::clog << "JSArrayBuffer:             objects_move_constructed = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_move_constructed() << std::endl;
+      std::clog << "JSArrayBuffer:             objects_copy_assigned    = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_copy_assigned()    << std::endl;
+      std::clog << "JSArrayBuffer:             objects_move_assigned    = " << JSPerformanceCounter<JSArrayBuffer>::get_objects_move_assigned()    << std::endl;
+      
       std::clog << std::endl;
       std::clog << "JSDate:                    objects_alive            = " << JSPerformanceCounter<JSDate>::get_objects_alive()            << std::endl;
       std::clog << "JSDate:                    objects_created          = " << JSPerformanceCounter<JSDate>::get_objects_created()          << std::endl;
@@ -173,6 +182,10 @@ namespace HAL { namespace detail {
       std::clog << "JSPropertyNameAccumulator: objects_move_constructed = " << JSPerformanceCounter<JSPropertyNameAccumulator>::get_objects_move_constructed() << std::endl;
       std::clog << "JSPropertyNameAccumulator: objects_copy_assigned    = " << JSPerformanceCounter<JSPropertyNameAccumulator>::get_objects_copy_assigned()    << std::endl;
       std::clog << "JSPropertyNameAccumulator: objects_move_assigned    = " << JSPerformanceCounter<JSPropertyNameAccumulator>::get_objects_move_assigned()    << std::endl;
+      
+      std::clog << std::endl;
+      std::clog << "JSExportPool:              slots_in_use             = " << JSExportPool::get_total_slots_in_use() << std::endl;
+      std::clog << "JSExportPool:              slab_count               = " << JSExportPool::get_total_slab_count()   << std::endl;
     }
   };
   
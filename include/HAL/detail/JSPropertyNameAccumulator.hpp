@@ -34,7 +34,7 @@ namespace HAL {
    an ordered set used to collect the names of a JavaScript object's
    properties
    */
-  class JSPropertyNameAccumulator HAL_PERFORMANCE_COUNTER2(JSPropertyNameAccumulator) {
+  class JSPropertyNameAccumulator HAL_PERFORMANCE_COUNTER1(JSPropertyNameAccumulator) {
       
     public:
       
@@ -0,0 +1,114 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSPROPERTYNAMETABLE_HPP_
+#define _HAL_DETAIL_JSPROPERTYNAMETABLE_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion A JSPropertyNameTable maps a fixed set of property
+   names to their positions in the list it was built from, so that a
+   JavaScriptCore callback can find its property from the JSStringRef
+   it is given without creating a JSString or a std::string.
+
+   The names are stored as UTF-8 in one contiguous buffer, indexed by
+   an open-addressing hash table with linear probing that is at most
+   half full. A lookup reads the name as UTF-8 into a stack buffer,
+   hashes it once and usually compares a single candidate. Names
+   longer than the longest name in the table are rejected from their
+   length alone.
+
+   UTF-8 is used rather than UTF-16 because JavaScriptCore stores most
+   property names as 8-bit strings. The C API can't tell whether a
+   string is 8-bit, and JSStringGetCharactersPtr upconverts such a
+   string into a new UTF-16 buffer, whereas JSStringGetUTF8CString
+   reads either representation directly.
+
+   A JSPropertyNameTable is immutable once built, and therefore safe
+   to share between threads.
+   */
+  class HAL_EXPORT JSPropertyNameTable final {
+
+  public:
+
+    // The result of Find when the name is not in the table.
+    static const std::size_t npos = static_cast<std::size_t>(-1);
+
+    JSPropertyNameTable() HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Build a table of the given UTF-8 names. Find returns
+     the position of a name in this vector. The names must be unique.
+     */
+    explicit JSPropertyNameTable(const std::vector<std::string>& names);
+
+    /*!
+     @method
+
+     @abstract Return the position of a name in the vector the table
+     was built from, or npos if it isn't in the table.
+     */
+    std::size_t Find(JSStringRef name_ref) const HAL_NOEXCEPT;
+
+    std::size_t size() const HAL_NOEXCEPT {
+      return entries__.size();
+    }
+
+    bool empty() const HAL_NOEXCEPT {
+      return entries__.empty();
+    }
+
+    void swap(JSPropertyNameTable&) HAL_NOEXCEPT;
+
+  private:
+
+    static std::uint32_t Hash(const char* bytes, std::size_t size) HAL_NOEXCEPT;
+
+    // The offset and size in bytes of a name's UTF-8 in bytes__, and
+    // its length in UTF-16 code units.
+    struct Entry {
+      std::uint32_t hash;
+      std::uint32_t offset;
+      std::uint32_t size;
+      std::uint32_t length;
+    };
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    std::vector<char>          bytes__;
+    std::vector<Entry>         entries__;
+    // Each bucket holds an index into entries__ plus one, or 0 if the
+    // bucket is empty.
+    std::vector<std::uint32_t> buckets__;
+#pragma warning(pop)
+    std::size_t                mask__       { 0 };
+    std::size_t                max_length__ { 0 };
+  };
+
+  inline
+  void swap(JSPropertyNameTable& first, JSPropertyNameTable& second) HAL_NOEXCEPT {
+    first.swap(second);
+  }
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSPROPERTYNAMETABLE_HPP_
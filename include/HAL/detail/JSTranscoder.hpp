@@ -0,0 +1,54 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSTRANSCODER_HPP_
+#define _HAL_DETAIL_JSTRANSCODER_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <string>
+#include <cstddef>
+
+namespace HAL { namespace detail {
+  
+  // UTF-8 <-> UTF-16 transcoding used by JSString. Runs of ASCII are
+  // checked, widened and narrowed with the widest vector instructions
+  // the CPU supports (AVX2 or SSE2, chosen at runtime), and everything
+  // else goes through a scalar transcoder.
+  
+  // Return the name of the vector instruction set selected at runtime,
+  // which is one of "avx2", "sse2" or "scalar".
+  HAL_EXPORT const char* GetTranscoderName() HAL_NOEXCEPT;
+  
+  // Transcode length bytes of UTF-8 into destination, which must have
+  // room for length UTF-16 code units. Return false if source is not
+  // valid UTF-8, otherwise set destination_length to the number of
+  // UTF-16 code units written.
+  HAL_EXPORT bool UTF8ToUTF16(const char* source, std::size_t length, char16_t* destination, std::size_t& destination_length) HAL_NOEXCEPT;
+  
+  // Transcode length UTF-16 code units into destination, which must
+  // have room for 3 * length bytes. Unpaired surrogates are replaced
+  // with U+FFFD. Return the number of bytes written.
+  HAL_EXPORT std::size_t UTF16ToUTF8(const char16_t* source, std::size_t length, char* destination) HAL_NOEXCEPT;
+  
+  // Return a new JSStringRef containing length bytes of UTF-8, which
+  // the caller must release. ASCII and Latin-1 are passed on to
+  // JSStringCreateWithUTF8CString so that they can stay 8-bit strings,
+  // while anything else, including embedded NULs, is transcoded to
+  // UTF-16. Invalid UTF-8 creates an empty string, just like
+  // JSStringCreateWithUTF8CString.
+  HAL_EXPORT JSStringRef JSStringCreateWithUTF8(const char* source, std::size_t length) HAL_NOEXCEPT;
+  
+  // Return the contents of a JSStringRef as a UTF-8 encoded
+  // std::string, without upconverting an 8-bit string to UTF-16.
+  // Unpaired surrogates are replaced with U+FFFD.
+  HAL_EXPORT std::string JSStringToUTF8(JSStringRef js_string_ref) HAL_NOEXCEPT;
+  
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSTRANSCODER_HPP_
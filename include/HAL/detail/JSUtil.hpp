@@ -89,6 +89,22 @@ namespace HAL { namespace detail {
   HAL_EXPORT std::string to_string(const std::unordered_set<JSClassAttribute>& attributes)                       HAL_NOEXCEPT;
   HAL_EXPORT std::string to_string_JSClassAttributes(::JSClassAttributes attributes)                             HAL_NOEXCEPT;
 
+  // Return true if the property name is a canonical array index, that
+  // is the decimal form of an integer below 2^32 - 1 without leading
+  // zeros, and set index to it.
+  //
+  // JavaScriptCore stores most property names as 8-bit strings, which
+  // JSStringGetCharactersPtr would upconvert to a new UTF-16 buffer on
+  // every callback. The C API can't tell whether a string is 8-bit, so
+  // this function and IsPropertyName read the name as UTF-8 into a
+  // small stack buffer instead, which JavaScriptCore fills directly
+  // from either representation.
+  HAL_EXPORT bool ToArrayIndex(JSStringRef property_name_ref, std::uint32_t& index)                              HAL_NOEXCEPT;
+  
+  // Return true if the property name is equal to the given ASCII
+  // name.
+  HAL_EXPORT bool IsPropertyName(JSStringRef property_name_ref, const char* ascii_name)                          HAL_NOEXCEPT;
+
   // This in the ToInt32 operation as defined in section 9.5 of the
   // ECMA-262 spec. Note that this operation is identical to ToUInt32
   // other than to interpretation of the resulting bit-pattern (as
@@ -0,0 +1,72 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/HandleScope.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+
+namespace HAL {
+  
+  HandleScope::HandleScope(const JSContext& js_context) HAL_NOEXCEPT
+  : js_context__(js_context)
+  , js_context_ref__(static_cast<JSContextRef>(js_context)) {
+    HAL_LOG_TRACE("HandleScope:: ctor ", this);
+  }
+  
+  HandleScope::~HandleScope() HAL_NOEXCEPT {
+    HAL_LOG_TRACE("HandleScope:: dtor ", this);
+  }
+  
+  Local<JSValue> HandleScope::CreateUndefined() const HAL_NOEXCEPT {
+    return Local<JSValue>(*this, JSValueMakeUndefined(js_context_ref__));
+  }
+  
+  Local<JSValue> HandleScope::CreateNull() const HAL_NOEXCEPT {
+    return Local<JSValue>(*this, JSValueMakeNull(js_context_ref__));
+  }
+  
+  Local<JSValue> HandleScope::CreateBoolean(bool boolean) const HAL_NOEXCEPT {
+    return Local<JSValue>(*this, JSValueMakeBoolean(js_context_ref__, boolean));
+  }
+  
+  Local<JSValue> HandleScope::CreateNumber(double number) const HAL_NOEXCEPT {
+    return Local<JSValue>(*this, JSValueMakeNumber(js_context_ref__, number));
+  }
+  
+  Local<JSValue> HandleScope::CreateNumber(int32_t number) const HAL_NOEXCEPT {
+    return CreateNumber(static_cast<double>(number));
+  }
+  
+  Local<JSValue> HandleScope::CreateNumber(uint32_t number) const HAL_NOEXCEPT {
+    return CreateNumber(static_cast<double>(number));
+  }
+  
+  Local<JSValue> HandleScope::CreateString(const JSString& js_string) const HAL_NOEXCEPT {
+    return Local<JSValue>(*this, JSValueMakeString(js_context_ref__, static_cast<JSStringRef>(js_string)));
+  }
+  
+  Local<JSObject> HandleScope::CreateObject() const HAL_NOEXCEPT {
+    return Local<JSObject>(*this, JSObjectMake(js_context_ref__, nullptr, nullptr));
+  }
+  
+  Local<JSObject> HandleScope::CreateArray() const {
+    JSValueRef exception { nullptr };
+    JSObjectRef js_object_ref = JSObjectMakeArray(js_context_ref__, 0, nullptr, &exception);
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_object_ref.
+      assert(!js_object_ref);
+      detail::ThrowRuntimeError("HandleScope", JSValue(js_context__, exception));
+    }
+    
+    return Local<JSObject>(*this, js_object_ref);
+  }
+  
+} // namespace HAL {
@@ -0,0 +1,157 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace HAL {
+
+  JSArguments::JSArguments(const JSContext& js_context, std::size_t argument_count, const JSValueRef arguments_array[]) HAL_NOEXCEPT
+  : js_context__(&js_context)
+  , js_context_ref__(static_cast<JSContextRef>(js_context))
+  , argument_count__(argument_count)
+  , arguments_array__(arguments_array) {
+  }
+
+  JSValue JSArguments::operator[](std::size_t index) const HAL_NOEXCEPT {
+    return JSValue(*js_context__, GetJSValueRef(index));
+  }
+
+  JSValue JSArguments::at(std::size_t index) const {
+    if (index >= argument_count__) {
+      throw std::out_of_range("JSArguments: index " + std::to_string(index) + " is out of range for " + std::to_string(argument_count__) + " arguments");
+    }
+    return JSValue(*js_context__, arguments_array__[index]);
+  }
+
+  JSValue::Type JSArguments::GetType(std::size_t index) const HAL_NOEXCEPT {
+    switch (JSValueGetType(js_context_ref__, GetJSValueRef(index))) {
+      case kJSTypeUndefined:
+        return JSValue::Type::Undefined;
+      case kJSTypeNull:
+        return JSValue::Type::Null;
+      case kJSTypeBoolean:
+        return JSValue::Type::Boolean;
+      case kJSTypeNumber:
+        return JSValue::Type::Number;
+      case kJSTypeString:
+        return JSValue::Type::String;
+      case kJSTypeObject:
+        return JSValue::Type::Object;
+      default:
+        return JSValue::Type::Undefined;
+    }
+  }
+
+  bool JSArguments::IsUndefined(std::size_t index) const HAL_NOEXCEPT {
+    return index >= argument_count__ || JSValueIsUndefined(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::IsNull(std::size_t index) const HAL_NOEXCEPT {
+    return index < argument_count__ && JSValueIsNull(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::IsBoolean(std::size_t index) const HAL_NOEXCEPT {
+    return index < argument_count__ && JSValueIsBoolean(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::IsNumber(std::size_t index) const HAL_NOEXCEPT {
+    return index < argument_count__ && JSValueIsNumber(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::IsString(std::size_t index) const HAL_NOEXCEPT {
+    return index < argument_count__ && JSValueIsString(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::IsObject(std::size_t index) const HAL_NOEXCEPT {
+    return index < argument_count__ && JSValueIsObject(js_context_ref__, arguments_array__[index]);
+  }
+
+  bool JSArguments::GetBoolean(std::size_t index) const HAL_NOEXCEPT {
+    return JSValueToBoolean(js_context_ref__, GetJSValueRef(index));
+  }
+
+  double JSArguments::GetNumber(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    const double result = JSValueToNumber(js_context_ref__, GetJSValueRef(index), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("JSArguments", JSValue(*js_context__, exception));
+    }
+
+    return result;
+  }
+
+  int32_t JSArguments::GetInt32(std::size_t index) const {
+    return detail::to_int32_t(GetNumber(index));
+  }
+
+  uint32_t JSArguments::GetUInt32(std::size_t index) const {
+    // ToInt32 and ToUint32 only differ in how the result is
+    // interpreted.
+    return GetInt32(index);
+  }
+
+  std::string JSArguments::GetString(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(js_context_ref__, GetJSValueRef(index), &exception);
+    if (exception) {
+      // If this assert fails then we need to JSStringRelease
+      // js_string_ref.
+      assert(!js_string_ref);
+      detail::ThrowRuntimeError("JSArguments", JSValue(*js_context__, exception));
+    }
+
+    assert(js_string_ref);
+    std::string string = detail::JSStringToUTF8(js_string_ref);
+    JSStringRelease(js_string_ref);
+
+    return string;
+  }
+
+  JSString JSArguments::GetJSString(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(js_context_ref__, GetJSValueRef(index), &exception);
+    if (exception) {
+      // If this assert fails then we need to JSStringRelease
+      // js_string_ref.
+      assert(!js_string_ref);
+      detail::ThrowRuntimeError("JSArguments", JSValue(*js_context__, exception));
+    }
+
+    assert(js_string_ref);
+    JSString js_string(js_string_ref);
+    JSStringRelease(js_string_ref);
+
+    return js_string;
+  }
+
+  JSObject JSArguments::GetObject(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    JSObjectRef js_object_ref = JSValueToObject(js_context_ref__, GetJSValueRef(index), &exception);
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_object_ref.
+      assert(!js_object_ref);
+      detail::ThrowRuntimeError("JSArguments", JSValue(*js_context__, exception));
+    }
+
+    assert(js_object_ref);
+    return JSObject(*js_context__, js_object_ref);
+  }
+
+  std::vector<JSValue> JSArguments::to_vector() const {
+    return detail::to_vector(*js_context__, argument_count__, arguments_array__);
+  }
+
+} // namespace HAL {
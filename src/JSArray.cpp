@@ -9,18 +9,114 @@
 #include "HAL/JSArray.hpp"
 #include "HAL/JSValue.hpp"
 #include "HAL/JSString.hpp"
+#include "HAL/JSNumber.hpp"
 #include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSBuiltins.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <cassert>
+#include <cstring>
 
 namespace HAL {
 
+namespace {
+
+// Convert the first length elements of an array into a new typed array
+// of the given type with one call of an ArrayHelper, and copy them to
+// destination. Return false without converting any element if typed
+// arrays aren't available.
+template<typename T>
+bool CopyElements(const JSContext& js_context, JSObjectRef array_ref, JSTypedArrayType type, detail::JSBuiltins::ArrayHelper helper, uint32_t length, T* destination) {
+	const auto js_context_ref = static_cast<JSContextRef>(js_context);
+	const auto copy_elements = detail::JSBuiltins::Get(js_context).GetArrayHelper(helper);
+	if (!copy_elements) {
+		return false;
+	}
+
+	JSValueRef exception { nullptr };
+	JSObjectRef typed_array_ref = JSObjectMakeTypedArray(js_context_ref, type, length, &exception);
+	if (!typed_array_ref || exception) {
+		return false;
+	}
+
+	const JSValueRef arguments[] = { typed_array_ref, array_ref };
+	JSObjectCallAsFunction(js_context_ref, copy_elements, nullptr, 2, arguments, &exception);
+	if (exception) {
+		detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+	}
+
+	const void* bytes = JSObjectGetTypedArrayBytesPtr(js_context_ref, typed_array_ref, &exception);
+	if (!bytes || exception) {
+		return false;
+	}
+
+	if (length > 0) {
+		std::memcpy(destination, bytes, length * sizeof(T));
+	}
+	return true;
+}
+
+// Convert the first length elements of an array to strings and join
+// them in JavaScript, then split the joined string into items using
+// the length of each string. Return false without converting any
+// element if typed arrays aren't available.
+bool JoinStrings(const JSContext& js_context, JSObjectRef array_ref, uint32_t length, std::vector<std::string>& items) {
+	const auto js_context_ref = static_cast<JSContextRef>(js_context);
+	const auto join_strings = detail::JSBuiltins::Get(js_context).GetArrayHelper(detail::JSBuiltins::ArrayHelper::JoinStrings);
+	if (!join_strings) {
+		return false;
+	}
+
+	JSValueRef exception { nullptr };
+	JSObjectRef lengths_ref = JSObjectMakeTypedArray(js_context_ref, kJSTypedArrayTypeUint32Array, length, &exception);
+	if (!lengths_ref || exception) {
+		return false;
+	}
+
+	const JSValueRef arguments[] = { lengths_ref, array_ref };
+	JSValueRef joined_ref = JSObjectCallAsFunction(js_context_ref, join_strings, nullptr, 2, arguments, &exception);
+	if (exception) {
+		detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+	}
+
+	const auto lengths = static_cast<const uint32_t*>(JSObjectGetTypedArrayBytesPtr(js_context_ref, lengths_ref, &exception));
+	if ((!lengths && length > 0) || exception) {
+		return false;
+	}
+
+	JSStringRef joined_string_ref = JSValueToStringCopy(js_context_ref, joined_ref, nullptr);
+	if (!joined_string_ref) {
+		return false;
+	}
+
+	auto characters = reinterpret_cast<const char16_t*>(JSStringGetCharactersPtr(joined_string_ref));
+	const auto end  = characters + JSStringGetLength(joined_string_ref);
+	items.reserve(length);
+	std::string buffer;
+	for (uint32_t i = 0; i < length; i++) {
+		const std::size_t count = std::min<std::size_t>(lengths[i], end - characters);
+		buffer.resize(3 * count);
+		buffer.resize(count > 0 ? detail::UTF16ToUTF8(characters, count, &buffer[0]) : 0);
+		items.push_back(buffer);
+		characters += count;
+	}
+
+	JSStringRelease(joined_string_ref);
+	return true;
+}
+
+} // namespace {
+
 JSArray::JSArray(const JSContext& js_context, const std::vector<JSValue>& arguments)
 		: JSObject(js_context, MakeArray(js_context, arguments)) {
 }
 
+JSArray::JSArray(const JSContext& js_context, const double* values, std::size_t count)
+		: JSObject(js_context, MakeArray(js_context, values, count)) {
+}
+
 JSArray::JSArray(const JSContext& js_context, JSObjectRef js_object_ref)
 		: JSObject(js_context, js_object_ref) {
 }
@@ -45,11 +141,43 @@ JSObjectRef JSArray::MakeArray(const JSContext& js_context, const std::vector<JS
 	return js_object_ref;
 }
 
-uint32_t JSArray::GetLength() const HAL_NOEXCEPT {
-	if (!HasProperty("length")) {
-		return 0;
+JSObjectRef JSArray::MakeArray(const JSContext& js_context, const double* values, std::size_t count) {
+	const auto js_context_ref = static_cast<JSContextRef>(js_context);
+	const auto from_typed_array = detail::JSBuiltins::Get(js_context).GetArrayHelper(detail::JSBuiltins::ArrayHelper::FromTypedArray);
+
+	JSValueRef exception { nullptr };
+	JSObjectRef typed_array_ref = from_typed_array ? JSObjectMakeTypedArray(js_context_ref, kJSTypedArrayTypeFloat64Array, count, &exception) : nullptr;
+	void* bytes = typed_array_ref && !exception ? JSObjectGetTypedArrayBytesPtr(js_context_ref, typed_array_ref, &exception) : nullptr;
+	if (!bytes || exception) {
+		// Without typed arrays, create the array from JSValues.
+		std::vector<JSValue> arguments;
+		arguments.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			arguments.push_back(js_context.CreateNumber(values[i]));
+		}
+		return MakeArray(js_context, arguments);
 	}
-	const auto length = GetProperty("length");
+
+	if (count > 0) {
+		std::memcpy(bytes, values, count * sizeof(double));
+	}
+
+	JSValueRef argument = typed_array_ref;
+	JSValueRef js_value_ref = JSObjectCallAsFunction(js_context_ref, from_typed_array, nullptr, 1, &argument, &exception);
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_value_ref.
+		assert(!js_value_ref);
+		detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+	}
+
+	assert(js_value_ref && JSValueIsObject(js_context_ref, js_value_ref));
+	return JSValueToObject(js_context_ref, js_value_ref, nullptr);
+}
+
+uint32_t JSArray::GetLength() const HAL_NOEXCEPT {
+	// A missing length is undefined, so this needs no HasProperty.
+	const auto length = GetProperty(JSPropertyKey::Length());
 	if (!length.IsNumber()) {
 		return 0;
 	}
@@ -68,6 +196,11 @@ JSArray::operator std::vector<JSValue>() const {
 
 JSArray::operator std::vector<bool>() const {
 	const auto length = GetLength();
+	std::vector<uint8_t> booleans(length);
+	if (CopyElements(get_context(), static_cast<JSObjectRef>(*this), kJSTypedArrayTypeUint8Array, detail::JSBuiltins::ArrayHelper::CopyBooleans, length, booleans.data())) {
+		return std::vector<bool>(booleans.begin(), booleans.end());
+	}
+
 	std::vector<bool> items;
 	items.reserve(length);
 	for (uint32_t i = 0; i < length; i++) {
@@ -79,6 +212,10 @@ JSArray::operator std::vector<bool>() const {
 JSArray::operator std::vector<std::string>() const {
 	const auto length = GetLength();
 	std::vector<std::string> items;
+	if (JoinStrings(get_context(), static_cast<JSObjectRef>(*this), length, items)) {
+		return items;
+	}
+
 	items.reserve(length);
 	for (uint32_t i = 0; i < length; i++) {
 		items.push_back(static_cast<std::string>(GetProperty(i)));
@@ -88,30 +225,39 @@ JSArray::operator std::vector<std::string>() const {
 
 JSArray::operator std::vector<double>() const {
 	const auto length = GetLength();
-	std::vector<double> items;
-	items.reserve(length);
+	std::vector<double> items(length);
+	if (CopyElements(get_context(), static_cast<JSObjectRef>(*this), kJSTypedArrayTypeFloat64Array, detail::JSBuiltins::ArrayHelper::CopyElements, length, items.data())) {
+		return items;
+	}
+
 	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<double>(GetProperty(i)));
+		items[i] = static_cast<double>(GetProperty(i));
 	}
 	return items;
 }
 
 JSArray::operator std::vector<int32_t>() const {
 	const auto length = GetLength();
-	std::vector<int32_t> items;
-	items.reserve(length);
+	std::vector<int32_t> items(length);
+	if (CopyElements(get_context(), static_cast<JSObjectRef>(*this), kJSTypedArrayTypeInt32Array, detail::JSBuiltins::ArrayHelper::CopyElements, length, items.data())) {
+		return items;
+	}
+
 	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<int32_t>(GetProperty(i)));
+		items[i] = static_cast<int32_t>(GetProperty(i));
 	}
 	return items;
 }
 
 JSArray::operator std::vector<uint32_t>() const {
 	const auto length = GetLength();
-	std::vector<uint32_t> items;
-	items.reserve(length);
+	std::vector<uint32_t> items(length);
+	if (CopyElements(get_context(), static_cast<JSObjectRef>(*this), kJSTypedArrayTypeUint32Array, detail::JSBuiltins::ArrayHelper::CopyElements, length, items.data())) {
+		return items;
+	}
+
 	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<uint32_t>(GetProperty(i)));
+		items[i] = static_cast<uint32_t>(GetProperty(i));
 	}
 	return items;
 }
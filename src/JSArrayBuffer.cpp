@@ -0,0 +1,251 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HAL {
+
+namespace {
+
+// Map length bytes of a file starting at offset, or the rest of the
+// file if length is 0, and return the first byte. The mapping is
+// copy-on-write, so JavaScript may write to the ArrayBuffer without
+// changing the file. Set length to the mapped length and deallocator
+// to the function that unmaps it.
+void* MapFile(const std::string& path, std::uint64_t offset, std::size_t& length, JSBytesDeallocator& deallocator) {
+	static const std::string internal_component_name = "JSArrayBuffer";
+	const auto system_error = [&path](const char* operation) {
+		detail::ThrowRuntimeError(internal_component_name, std::string(operation) + " failed for " + path + ": " + std::strerror(errno));
+	};
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		detail::ThrowRuntimeError(internal_component_name, "CreateFile failed for " + path + ": error " + std::to_string(GetLastError()));
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		const auto error = GetLastError();
+		CloseHandle(file);
+		detail::ThrowRuntimeError(internal_component_name, "GetFileSizeEx failed for " + path + ": error " + std::to_string(error));
+	}
+	const std::uint64_t size = static_cast<std::uint64_t>(file_size.QuadPart);
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		system_error("open");
+	}
+
+	struct stat file_status;
+	if (fstat(file, &file_status) != 0) {
+		const int error = errno;
+		close(file);
+		errno = error;
+		system_error("fstat");
+	}
+	const std::uint64_t size = static_cast<std::uint64_t>(file_status.st_size);
+#endif
+
+	const auto close_file = [file]() {
+#ifdef _WIN32
+		CloseHandle(file);
+#else
+		close(file);
+#endif
+	};
+
+	if (offset > size || (length > 0 && length > size - offset)) {
+		close_file();
+		detail::ThrowInvalidArgument(internal_component_name, "The range to map is outside of " + path + ".");
+	}
+
+	if (length == 0) {
+		if (size - offset > std::numeric_limits<std::size_t>::max()) {
+			close_file();
+			detail::ThrowInvalidArgument(internal_component_name, "The rest of " + path + " is too large to map.");
+		}
+		length = static_cast<std::size_t>(size - offset);
+	}
+
+	if (length == 0) {
+		close_file();
+		return nullptr;
+	}
+
+	// Mappings must start at a multiple of the page size (the
+	// allocation granularity on Windows).
+#ifdef _WIN32
+	SYSTEM_INFO system_info;
+	GetSystemInfo(&system_info);
+	const std::uint64_t granularity = system_info.dwAllocationGranularity;
+#else
+	const std::uint64_t granularity = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+	const std::uint64_t map_offset = offset - offset % granularity;
+	const std::size_t   delta      = static_cast<std::size_t>(offset - map_offset);
+	const std::size_t   map_length = length + delta;
+
+#ifdef _WIN32
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	const auto error = GetLastError();
+	close_file();
+	if (!mapping) {
+		detail::ThrowRuntimeError(internal_component_name, "CreateFileMapping failed for " + path + ": error " + std::to_string(error));
+	}
+
+	void* base = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(map_offset >> 32), static_cast<DWORD>(map_offset), map_length);
+	const auto map_error = GetLastError();
+	// The view keeps the mapping alive.
+	CloseHandle(mapping);
+	if (!base) {
+		detail::ThrowRuntimeError(internal_component_name, "MapViewOfFile failed for " + path + ": error " + std::to_string(map_error));
+	}
+
+	deallocator = [base](void*) {
+		UnmapViewOfFile(base);
+	};
+#else
+	if (map_offset > static_cast<std::uint64_t>(std::numeric_limits<off_t>::max())) {
+		close_file();
+		detail::ThrowInvalidArgument(internal_component_name, "The offset is too large to map " + path + ".");
+	}
+
+	void* base = mmap(nullptr, map_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, static_cast<off_t>(map_offset));
+	const int error = errno;
+	// The mapping keeps the file open.
+	close_file();
+	if (base == MAP_FAILED) {
+		errno = error;
+		system_error("mmap");
+	}
+
+	deallocator = [base, map_length](void*) {
+		munmap(base, map_length);
+	};
+#endif
+
+	return static_cast<std::uint8_t*>(base) + delta;
+}
+
+} // namespace {
+
+JSArrayBuffer::JSArrayBuffer(const JSObject& js_object)
+		: JSObject(js_object) {
+	if (!IsArrayBuffer(js_object)) {
+		detail::ThrowInvalidArgument("JSArrayBuffer", "This JavaScript object is not an ArrayBuffer.");
+	}
+}
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, std::size_t byte_length)
+		: JSObject(js_context, MakeArrayBuffer(js_context, byte_length)) {
+}
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator)
+		: JSObject(js_context, MakeArrayBuffer(js_context, bytes, byte_length, deallocator)) {
+}
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, const std::string& path, std::uint64_t offset, std::size_t length)
+		: JSObject(js_context, MakeArrayBuffer(js_context, path, offset, length)) {
+}
+
+JSObjectRef JSArrayBuffer::MakeArrayBuffer(const JSContext& js_context, std::size_t byte_length) {
+	// The C API can't make an ArrayBuffer on its own, so make a
+	// Uint8Array that owns one.
+	const auto js_context_ref = static_cast<JSContextRef>(js_context);
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeTypedArray(js_context_ref, kJSTypedArrayTypeUint8Array, byte_length, &exception);
+	if (!exception) {
+		js_object_ref = JSObjectGetTypedArrayBuffer(js_context_ref, js_object_ref, &exception);
+	}
+
+	if (exception) {
+		detail::ThrowRuntimeError("JSArrayBuffer", JSValue(js_context, exception));
+	}
+
+	assert(js_object_ref);
+	return js_object_ref;
+}
+
+JSObjectRef JSArrayBuffer::MakeArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator) {
+	JSValueRef exception { nullptr };
+	void* deallocator_context = detail::MakeBytesDeallocatorContext(deallocator);
+	JSObjectRef js_object_ref = JSObjectMakeArrayBufferWithBytesNoCopy(static_cast<JSContextRef>(js_context), bytes, byte_length, deallocator_context ? detail::DeallocateBytes : nullptr, deallocator_context, &exception);
+
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_object_ref.
+		assert(!js_object_ref);
+		detail::ThrowRuntimeError("JSArrayBuffer", JSValue(js_context, exception));
+	}
+
+	return js_object_ref;
+}
+
+JSObjectRef JSArrayBuffer::MakeArrayBuffer(const JSContext& js_context, const std::string& path, std::uint64_t offset, std::size_t length) {
+	JSBytesDeallocator deallocator;
+	void* bytes = MapFile(path, offset, length, deallocator);
+	if (!bytes) {
+		// There is nothing to map in an empty range.
+		return MakeArrayBuffer(js_context, 0);
+	}
+
+	// If making the ArrayBuffer fails JavaScriptCore still calls the
+	// deallocator, which unmaps the file.
+	return MakeArrayBuffer(js_context, bytes, length, deallocator);
+}
+
+std::size_t JSArrayBuffer::GetByteLength() const HAL_NOEXCEPT {
+	return JSObjectGetArrayBufferByteLength(static_cast<JSContextRef>(get_context()), static_cast<JSObjectRef>(*this), nullptr);
+}
+
+JSSpan<std::uint8_t> JSArrayBuffer::GetBytes() const HAL_NOEXCEPT {
+	const auto js_context_ref = static_cast<JSContextRef>(get_context());
+	const auto js_object_ref  = static_cast<JSObjectRef>(*this);
+	const auto bytes = static_cast<std::uint8_t*>(JSObjectGetArrayBufferBytesPtr(js_context_ref, js_object_ref, nullptr));
+	return JSSpan<std::uint8_t>(bytes, JSObjectGetArrayBufferByteLength(js_context_ref, js_object_ref, nullptr));
+}
+
+bool JSArrayBuffer::IsArrayBuffer(const JSObject& js_object) HAL_NOEXCEPT {
+	return JSValueGetTypedArrayType(static_cast<JSContextRef>(js_object.get_context()), static_cast<JSObjectRef>(js_object), nullptr) == kJSTypedArrayTypeArrayBuffer;
+}
+
+namespace detail {
+
+void* MakeBytesDeallocatorContext(const JSBytesDeallocator& deallocator) {
+	return deallocator ? new JSBytesDeallocator(deallocator) : nullptr;
+}
+
+void DeallocateBytes(void* bytes, void* deallocator_context) {
+	// JavaScriptCore calls this even if making the ArrayBuffer failed,
+	// so this is the only place the context is deleted.
+	std::unique_ptr<JSBytesDeallocator> deallocator(static_cast<JSBytesDeallocator*>(deallocator_context));
+	(*deallocator)(bytes);
+}
+
+} // namespace detail {
+
+} // namespace HAL {
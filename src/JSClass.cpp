@@ -31,24 +31,29 @@ namespace HAL {
   
   JSClass::~JSClass() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSClass:: dtor ", this);
-    HAL_LOG_TRACE("JSClass:: release ", js_class_ref__, " for ", this);
-    JSClassRelease(js_class_ref__);
+    if (js_class_ref__) {
+      HAL_LOG_TRACE("JSClass:: release ", js_class_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RELEASE(JSClass);
+      JSClassRelease(js_class_ref__);
+    }
   }
   
   JSClass::JSClass(const JSClass& rhs) HAL_NOEXCEPT
   : name__(rhs.name__)
   , js_class_ref__(rhs.js_class_ref__) {
     HAL_LOG_TRACE("JSClass:: copy ctor ", this);
-    HAL_LOG_TRACE("JSClass:: retain ", js_class_ref__, " for ", this);
-    JSClassRetain(js_class_ref__);
+    if (js_class_ref__) {
+      HAL_LOG_TRACE("JSClass:: retain ", js_class_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RETAIN(JSClass);
+      JSClassRetain(js_class_ref__);
+    }
   }
   
   JSClass::JSClass(JSClass&& rhs) HAL_NOEXCEPT
   : name__(std::move(rhs.name__))
   , js_class_ref__(rhs.js_class_ref__) {
     HAL_LOG_TRACE("JSClass:: move ctor ", this);
-    HAL_LOG_TRACE("JSClass:: retain ", js_class_ref__, " for ", this);
-    JSClassRetain(js_class_ref__);
+    rhs.js_class_ref__ = nullptr;
   }
   
   JSClass& JSClass::operator=(JSClass rhs) HAL_NOEXCEPT {
@@ -19,10 +19,12 @@
 
 #include "HAL/JSObject.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArrayBuffer.hpp"
 #include "HAL/JSDate.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSFunction.hpp"
 #include "HAL/JSRegExp.hpp"
+#include "HAL/JSArguments.hpp"
 
 #include "HAL/detail/JSUtil.hpp"
 
@@ -129,6 +131,30 @@ namespace HAL {
     return JSArray(JSContext(js_global_context_ref__), arguments);
   }
   
+  JSArray JSContext::CreateArray(const double* values, std::size_t count) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArray(JSContext(js_global_context_ref__), values, count);
+  }
+  
+  JSArray JSContext::CreateArray(const std::vector<double>& values) const {
+    return CreateArray(values.data(), values.size());
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBuffer(std::size_t byte_length) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer(JSContext(js_global_context_ref__), byte_length);
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBuffer(void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer(JSContext(js_global_context_ref__), bytes, byte_length, deallocator);
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBufferFromFile(const std::string& path, std::uint64_t offset, std::size_t length) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer(JSContext(js_global_context_ref__), path, offset, length);
+  }
+  
   JSDate JSContext::CreateDate() const HAL_NOEXCEPT {
     HAL_JSCONTEXT_LOCK_GUARD;
     return JSDate(JSContext(js_global_context_ref__));
@@ -177,7 +203,7 @@ namespace HAL {
   }
 
   JSFunction JSContext::CreateFunction() const {
-    JSFunctionCallback noop = [](const std::vector<JSValue>, JSObject& this_object){ return this_object.get_context().CreateUndefined(); };
+    JSFunctionArgumentsCallback noop = [](const JSArguments&, JSObject& this_object){ return this_object.get_context().CreateUndefined(); };
     return CreateFunction(noop);
   }
 
@@ -189,14 +215,24 @@ namespace HAL {
     HAL_JSCONTEXT_LOCK_GUARD;
     return JSFunction(JSContext(js_global_context_ref__), function_name, callback);
   }
+
+  JSFunction JSContext::CreateFunction(JSFunctionArgumentsCallback& callback) const {
+    return CreateFunction(JSString(), callback);
+  }
+
+  JSFunction JSContext::CreateFunction(const JSString& function_name, JSFunctionArgumentsCallback& callback) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSFunction(JSContext(js_global_context_ref__), function_name, callback);
+  }
   
   JSValue JSContext::JSEvaluateScript(const JSString& script) const {
-    return JSEvaluateScript(script, get_global_object(), JSString());
+    return JSEvaluateScript(script, JSString());
   }
   
   JSValue JSContext::JSEvaluateScript(const JSString& script, const JSString& source_url, int starting_line_number) const {
-    HAL_JSCONTEXT_LOCK_GUARD;
-    return JSEvaluateScript(script, get_global_object(), source_url, starting_line_number);
+    // A null 'this' object evaluates the script with the global
+    // object as 'this', without wrapping it in a JSObject.
+    return JSEvaluateScript(script, nullptr, source_url, starting_line_number);
   }
   
   JSValue JSContext::JSEvaluateScript(const JSString& script, JSObject this_object) const {
@@ -204,11 +240,15 @@ namespace HAL {
   }
   
   JSValue JSContext::JSEvaluateScript(const JSString& script, JSObject this_object, const JSString& source_url, int starting_line_number) const {
+    return JSEvaluateScript(script, static_cast<JSObjectRef>(this_object), source_url, starting_line_number);
+  }
+  
+  JSValue JSContext::JSEvaluateScript(const JSString& script, JSObjectRef this_object_ref, const JSString& source_url, int starting_line_number) const {
     HAL_JSCONTEXT_LOCK_GUARD;
     JSValueRef js_value_ref { nullptr };
     const JSStringRef source_url_ref = (source_url.length() > 0) ? static_cast<JSStringRef>(source_url) : nullptr;
     JSValueRef exception { nullptr };
-    js_value_ref = ::JSEvaluateScript(js_global_context_ref__, static_cast<JSStringRef>(script), static_cast<JSObjectRef>(this_object), source_url_ref, starting_line_number, &exception);
+    js_value_ref = ::JSEvaluateScript(js_global_context_ref__, static_cast<JSStringRef>(script), this_object_ref, source_url_ref, starting_line_number, &exception);
     
     if (exception) {
       // If this assert fails then we need to JSValueUnprotect
@@ -260,8 +300,11 @@ namespace HAL {
   JSContext::~JSContext() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSContext:: dtor ", this);
 #ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContext:: release ", js_global_context_ref__, " for ", this);
-    JSGlobalContextRelease(js_global_context_ref__);
+    if (js_global_context_ref__) {
+      HAL_LOG_TRACE("JSContext:: release ", js_global_context_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RELEASE(JSContext);
+      JSGlobalContextRelease(js_global_context_ref__);
+    }
 #endif
   }
   
@@ -270,8 +313,11 @@ namespace HAL {
   , js_global_context_ref__(rhs.js_global_context_ref__) {
     HAL_LOG_TRACE("JSContext:: copy ctor ", this);
 #ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContext:: retain ", js_global_context_ref__, " for ", this);
-    JSGlobalContextRetain(js_global_context_ref__);
+    if (js_global_context_ref__) {
+      HAL_LOG_TRACE("JSContext:: retain ", js_global_context_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RETAIN(JSContext);
+      JSGlobalContextRetain(js_global_context_ref__);
+    }
 #endif
   }
   
@@ -279,10 +325,7 @@ namespace HAL {
   : js_context_group__(std::move(rhs.js_context_group__))
   , js_global_context_ref__(rhs.js_global_context_ref__) {
     HAL_LOG_TRACE("JSContext:: move ctor ", this);
-#ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContext:: retain ", js_global_context_ref__, " for ", this);
-    JSGlobalContextRetain(js_global_context_ref__);
-#endif
+    rhs.js_global_context_ref__ = nullptr;
   }
   
   JSContext& JSContext::operator=(JSContext rhs) HAL_NOEXCEPT {
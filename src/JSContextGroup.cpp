@@ -42,8 +42,9 @@ namespace HAL {
   JSContextGroup::~JSContextGroup() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSContextGroup:: dtor ", this);
 #ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContextGroup:: release ", js_context_group_ref__, " for ", this);
-    if (managed__) {
+    if (managed__ && js_context_group_ref__) {
+      HAL_LOG_TRACE("JSContextGroup:: release ", js_context_group_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RELEASE(JSContextGroup);
       JSContextGroupRelease(js_context_group_ref__);
     }
 #endif
@@ -53,20 +54,21 @@ namespace HAL {
   : js_context_group_ref__(rhs.js_context_group_ref__) {
     HAL_LOG_TRACE("JSContextGroup:: copy ctor ", this);
 #ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContextGroup:: retain ", js_context_group_ref__, " for ", this);
-    JSContextGroupRetain(js_context_group_ref__);
-    managed__ = true;
+    if (js_context_group_ref__) {
+      HAL_LOG_TRACE("JSContextGroup:: retain ", js_context_group_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RETAIN(JSContextGroup);
+      JSContextGroupRetain(js_context_group_ref__);
+      managed__ = true;
+    }
 #endif
   }
   
   JSContextGroup::JSContextGroup(JSContextGroup&& rhs) HAL_NOEXCEPT
-  : js_context_group_ref__(rhs.js_context_group_ref__) {
+  : managed__(rhs.managed__)
+  , js_context_group_ref__(rhs.js_context_group_ref__) {
     HAL_LOG_TRACE("JSContextGroup:: move ctor ", this);
-#ifndef HAL_USE_SINGLE_CONTEXT
-    HAL_LOG_TRACE("JSContextGroup:: retain ", js_context_group_ref__, " for ", this);
-    JSContextGroupRetain(js_context_group_ref__);
-    managed__ = true;
-#endif
+    rhs.js_context_group_ref__ = nullptr;
+    rhs.managed__              = false;
   }
   
   JSContextGroup& JSContextGroup::operator=(JSContextGroup rhs) HAL_NOEXCEPT {
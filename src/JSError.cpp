@@ -28,36 +28,36 @@ JSError::JSError(const JSContext& js_context, JSObjectRef js_object_ref)
 }
 
 std::string JSError::message() const {
-	if (HasProperty("message")) {
-		return static_cast<std::string>(GetProperty("message"));
+	if (HasProperty(JSPropertyKey::Message())) {
+		return static_cast<std::string>(GetProperty(JSPropertyKey::Message()));
 	}
 	return "";
 }
 
 std::string JSError::name() const {
-	if (HasProperty("name")) {
-		return static_cast<std::string>(GetProperty("name"));
+	if (HasProperty(JSPropertyKey::Name())) {
+		return static_cast<std::string>(GetProperty(JSPropertyKey::Name()));
 	}
 	return "";
 }
 
 std::string JSError::filename() const {
-	if (HasProperty("fileName")) {
-		return static_cast<std::string>(GetProperty("fileName"));
+	if (HasProperty(JSPropertyKey::FileName())) {
+		return static_cast<std::string>(GetProperty(JSPropertyKey::FileName()));
 	}
 	return "";
 }
 
 std::uint32_t JSError::linenumber() const {
-	if (HasProperty("lineNumber")) {
-		return static_cast<std::uint32_t>(GetProperty("lineNumber"));
+	if (HasProperty(JSPropertyKey::LineNumber())) {
+		return static_cast<std::uint32_t>(GetProperty(JSPropertyKey::LineNumber()));
 	}
 	return 0;
 }
 
 std::vector<JSValue> JSError::stack() const {
-	if (HasProperty("native_stack") && GetProperty("native_stack").IsObject()) {
-		const auto js_stack = static_cast<JSObject>(GetProperty("native_stack"));
+	if (HasProperty(JSPropertyKey::NativeStack()) && GetProperty(JSPropertyKey::NativeStack()).IsObject()) {
+		const auto js_stack = static_cast<JSObject>(GetProperty(JSPropertyKey::NativeStack()));
 		if (js_stack.IsArray()) {
 			return static_cast<std::vector<JSValue>>(static_cast<JSArray>(js_stack));
 		}
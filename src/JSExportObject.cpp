@@ -30,7 +30,14 @@ namespace HAL {
   }
   
   JSObject JSExportObject::get_object() HAL_NOEXCEPT {
-    return JSObject::FindJSObjectFromPrivateData(get_context(), this);
+    // This could happen when owner object is gargabe collected while
+    // executing async operation. This Error object will be only used
+    // internally to see if object is found or not.
+    if (!js_object_ref__) {
+      return js_context__.CreateError();
+    }
+    
+    return JSObject(js_context__, js_object_ref__);
   }
   
   JSExportObject::JSExportObject(const JSContext& js_context) HAL_NOEXCEPT
@@ -40,7 +47,17 @@ namespace HAL {
   
   JSExportObject::~JSExportObject() HAL_NOEXCEPT {
     HAL_LOG_DEBUG("JSExportObject:: dtor ", this);
-    JSObject::UnRegisterPrivateData(this);
+  }
+  
+  // A copy isn't the private data of the original's JavaScript
+  // object, so the pointer back to it isn't copied.
+  JSExportObject::JSExportObject(const JSExportObject& rhs) HAL_NOEXCEPT
+  : js_context__(rhs.js_context__) {
+  }
+  
+  JSExportObject& JSExportObject::operator=(const JSExportObject& rhs) HAL_NOEXCEPT {
+    js_context__ = rhs.js_context__;
+    return *this;
   }
   
   void JSExportObject::swap(JSExportObject& other) HAL_NOEXCEPT {
@@ -8,9 +8,13 @@
 
 #include "HAL/JSFunction.hpp"
 #include "HAL/JSString.hpp"
+#include "HAL/JSPropertyKey.hpp"
 #include "HAL/JSValue.hpp"
 #include "HAL/JSUndefined.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSError.hpp"
 #include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSBuiltins.hpp"
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
@@ -18,48 +22,31 @@
 
 namespace HAL {
 
-JSFunction::JSFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number)
-        : JSObject(js_context, MakeFunction(js_context, body, parameter_names, function_name, source_url, starting_line_number)) {
-}
+namespace {
 
-JSFunction::JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback)
-        : JSObject(js_context, MakeFunction(js_context, function_name, callback)) {
-}
+// The private data of a JavaScript function created from a native
+// callback.
+struct CallbackData {
+    JSFunctionArgumentsCallback callback;
+    JSString                    name;
+};
 
-JSFunction::JSFunction(const JSFunction& rhs) : JSObject(rhs) {
-    RetainCallbackAfterCopy();
-}
+} // namespace {
 
-JSFunction::JSFunction(JSFunction&& rhs) : JSObject(std::move(rhs)) {
-    RetainCallbackAfterCopy();
+JSFunction::JSFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number)
+        : JSObject(js_context, MakeFunction(js_context, body, parameter_names, function_name, source_url, starting_line_number)) {
 }
 
-JSFunction& JSFunction::operator=(const JSFunction& rhs) {
-    JSObject::operator=(rhs);
-    RetainCallbackAfterCopy();
-    return *this;
+JSFunction::JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback)
+        : JSObject(js_context, MakeFunction(js_context, function_name, ToArgumentsCallback(callback))) {
 }
 
-JSFunction& JSFunction::operator=(JSFunction&& rhs) {
-    JSObject::operator=(std::move(rhs));
-    RetainCallbackAfterCopy();
-    return *this;
+JSFunction::JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionArgumentsCallback& callback)
+        : JSObject(js_context, MakeFunction(js_context, function_name, callback)) {
 }
 
-/**
- * To keep the callback valid after the destruction of rhs,
- * we must obtain a new JSObjectRef and register the callback with it.
- * The rhs will unregister the callback with the original js_object_ref__ in destructor.
- */
-void JSFunction::RetainCallbackAfterCopy() {
-    const auto &callback = FindJSFunctionCallback(js_object_ref__);
-    if (callback) {
-        JSValue name(js_context__, JSObjectGetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(JSString("name")), nullptr));
-        std::string name_string = static_cast<std::string>(name);
-        UnRegisterJSContext(js_object_ref__);
-        js_object_ref__ = MakeFunction(js_context__, static_cast<JSString>(name), callback);
-        JSFunction::RegisterJSFunctionCallback(js_object_ref__, callback);
-    }
+JSFunction::JSFunction(const JSContext& js_context, JSObjectRef js_object_ref)
+        : JSObject(js_context, js_object_ref) {
 }
 
 JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& func_name, const JSString& source_url, int starting_line_number) {
@@ -89,67 +76,85 @@ JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString
     return js_object_ref;
 }
 
-std::unordered_map<std::intptr_t, JSFunctionCallback> JSFunction::js_object_ref_to_js_function__;
-
-void JSFunction::RegisterJSFunctionCallback(JSObjectRef js_object_ref, JSFunctionCallback callback) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key   = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto value = callback;
-    const auto position = js_object_ref_to_js_function__.find(key);
-    const bool found    = position != js_object_ref_to_js_function__.end();
-    
-    if (found) {
-      HAL_LOG_DEBUG("JSFunction::RegisterJSFunctionCallback: JSObjectRef ", js_object_ref, " already registered");
-    } else {
-      const auto insert_result = js_object_ref_to_js_function__.emplace(key, value);
-      const bool inserted      = insert_result.second;
-      
-      assert(inserted);
+JSFunctionArgumentsCallback JSFunction::ToArgumentsCallback(const JSFunctionCallback& callback) {
+    if (!callback) {
+        return nullptr;
     }
+    return [callback](const JSArguments& arguments, JSObject& this_object) {
+        return callback(arguments.to_vector(), this_object);
+    };
 }
 
-void JSFunction::UnRegisterJSFunctionCallback(JSObjectRef js_object_ref) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key = reinterpret_cast<std::intptr_t>(js_object_ref);
-    js_object_ref_to_js_function__.erase(key);
+JSClassRef JSFunction::MakeCallbackClass(const JSStaticValue* static_values, ::JSObjectFinalizeCallback finalize, ::JSObjectCallAsFunctionCallback call_as_function) {
+    // The prototype is set to Function.prototype by MakeFunction.
+    JSClassDefinition js_class_definition = kJSClassDefinitionEmpty;
+    js_class_definition.attributes     = kJSClassAttributeNoAutomaticPrototype;
+    js_class_definition.className      = "Function";
+    js_class_definition.staticValues   = static_values;
+    js_class_definition.finalize       = finalize;
+    js_class_definition.callAsFunction = call_as_function;
+    return JSClassCreate(&js_class_definition);
 }
 
-JSFunctionCallback JSFunction::FindJSFunctionCallback(JSObjectRef js_object_ref) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key      = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto position = js_object_ref_to_js_function__.find(key);
-    const bool found    = position != js_object_ref_to_js_function__.end();
-    
-    if (found) {
-      return position->second;
-    } else {
-        return nullptr;
+JSClassRef JSFunction::GetCallbackClass() {
+    static const JSStaticValue static_values[] = {
+        { "name", JSFunction::JSObjectGetNameCallback, nullptr, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontEnum | kJSPropertyAttributeDontDelete },
+        { nullptr, nullptr, nullptr, 0 }
+    };
+    static const JSClassRef js_class_ref = MakeCallbackClass(static_values, JSFunction::JSObjectFinalizeCallback, JSFunction::JSObjectCallAsFunctionCallback);
+    return js_class_ref;
+}
+
+JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionArgumentsCallback& callback) {
+    return MakeFunction(js_context, GetCallbackClass(), new CallbackData { callback, function_name });
+}
+
+JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, JSClassRef js_class_ref, void* private_data) {
+    const auto  ctx           = static_cast<JSContextRef>(js_context);
+    JSObjectRef js_object_ref = JSObjectMake(ctx, js_class_ref, private_data);
+
+    const auto function_prototype_ref = detail::JSBuiltins::Get(js_context).get_function_prototype();
+    if (function_prototype_ref) {
+        JSObjectSetPrototype(ctx, js_object_ref, function_prototype_ref);
     }
+
+    return js_object_ref;
 }
 
-JSValueRef JSFunction::JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) {
-    const auto callback = FindJSFunctionCallback(function_ref);
-    if (callback == nullptr) {
+void JSFunction::SetException(JSContextRef context_ref, JSValueRef* exception, const std::string& what) {
+    HAL_LOG_ERROR("JSFunction: ", what);
+    const JSContext js_context(context_ref);
+    auto js_error = js_context.CreateError();
+    js_error.SetProperty(JSPropertyKey::Message(), js_context.CreateString(what));
+    *exception = static_cast<JSObjectRef>(js_error);
+}
+
+void JSFunction::JSObjectFinalizeCallback(JSObjectRef object_ref) {
+    delete static_cast<CallbackData*>(JSObjectGetPrivate(object_ref));
+}
+
+JSValueRef JSFunction::JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) try {
+    const auto callback_data = static_cast<CallbackData*>(JSObjectGetPrivate(function_ref));
+    if (!callback_data || !callback_data->callback) {
         return JSValueMakeUndefined(context_ref);
     }
     const auto ctx = JSContext(context_ref);
-    std::vector<JSValue> arguments;
-    arguments.reserve(argument_count);
-    for (size_t i = 0; i < argument_count; i++) {
-        arguments.push_back(JSValue(ctx, arguments_array[i]));
-    }
     auto this_object = JSObject(ctx, this_object_ref);
-    return static_cast<JSValueRef>(callback(arguments, this_object));
+    return static_cast<JSValueRef>(callback_data->callback(JSArguments(ctx, argument_count, arguments_array), this_object));
+} catch (const std::exception& e) {
+    SetException(context_ref, exception, e.what());
+    return nullptr;
+} catch (...) {
+    SetException(context_ref, exception, "unknown exception");
+    return nullptr;
 }
 
-JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback) {
-    JSObjectRef js_object_ref = JSObjectMakeFunctionWithCallback(static_cast<JSContextRef>(js_context), static_cast<JSStringRef>(function_name), JSFunction::JSObjectCallAsFunctionCallback);
-    JSFunction::RegisterJSFunctionCallback(js_object_ref, callback);
-    return js_object_ref;
-}
-
-JSFunction::~JSFunction() HAL_NOEXCEPT {
-    JSFunction::UnRegisterJSFunctionCallback(js_object_ref__);
+JSValueRef JSFunction::JSObjectGetNameCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef, JSValueRef*) {
+    const auto callback_data = static_cast<CallbackData*>(JSObjectGetPrivate(object_ref));
+    if (!callback_data) {
+        return nullptr;
+    }
+    return JSValueMakeString(context_ref, static_cast<JSStringRef>(callback_data->name));
 }
     
 } // namespace HAL {
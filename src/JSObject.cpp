@@ -17,9 +17,11 @@
 #include "HAL/JSNumber.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSExportObject.hpp"
 
 #include "HAL/detail/JSPropertyNameAccumulator.hpp"
 #include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSBuiltins.hpp"
 
 #include <algorithm>
 #include <type_traits>
@@ -32,6 +34,10 @@ namespace HAL {
     return JSObjectHasProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_name));
   }
   
+  bool JSObject::HasProperty(const JSPropertyKey& property_key) const HAL_NOEXCEPT {
+    return JSObjectHasProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_key));
+  }
+  
   JSValue JSObject::GetProperty(const JSString& property_name) const {
     HAL_JSOBJECT_LOCK_GUARD;
     JSValueRef exception { nullptr };
@@ -47,6 +53,21 @@ namespace HAL {
     return JSValue(js_context__, js_value_ref);
   }
   
+  JSValue JSObject::GetProperty(const JSPropertyKey& property_key) const {
+    HAL_JSOBJECT_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectGetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_key), &exception);
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_value_ref.
+      assert(!js_value_ref);
+      detail::ThrowRuntimeError("JSObject", JSValue(js_context__, exception));
+    }
+    
+    assert(js_value_ref);
+    return JSValue(js_context__, js_value_ref);
+  }
+  
   JSValue JSObject::GetProperty(unsigned property_index) const {
     HAL_JSOBJECT_LOCK_GUARD;
     JSValueRef exception { nullptr };
@@ -72,6 +93,16 @@ namespace HAL {
     }
   }
   
+  void JSObject::SetProperty(const JSPropertyKey& property_key, const JSValue& property_value, const std::unordered_set<JSPropertyAttribute>& attributes) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    
+    JSValueRef exception { nullptr };
+    JSObjectSetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_key), static_cast<JSValueRef>(property_value), detail::ToJSPropertyAttributes(attributes), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("JSObject", JSValue(js_context__, exception));
+    }
+  }
+  
   void JSObject::SetProperty(unsigned property_index, const JSValue& property_value) {
     HAL_JSOBJECT_LOCK_GUARD;
     
@@ -94,6 +125,18 @@ namespace HAL {
     return result;
   }
   
+  bool JSObject::DeleteProperty(const JSPropertyKey& property_key) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    
+    JSValueRef exception { nullptr };
+    const bool result = JSObjectDeleteProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_key), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("JSObject", JSValue(js_context__, exception));
+    }
+    
+    return result;
+  }
+  
   JSPropertyNameArray JSObject::GetPropertyNames() const HAL_NOEXCEPT {
     HAL_JSOBJECT_LOCK_GUARD;
     return JSPropertyNameArray(*this);
@@ -114,42 +157,12 @@ namespace HAL {
 
   bool JSObject::IsArray() const HAL_NOEXCEPT {
     HAL_JSOBJECT_LOCK_GUARD;
-
-    JSObject global_object = js_context__.get_global_object();
-    JSValue array_value = global_object.GetProperty("Array");
-    if (!array_value.IsObject()) {
-      return false;
-    }
-    
-    JSObject array = static_cast<JSObject>(array_value);
-    JSValue isArray_value = array.GetProperty("isArray");
-    if (!isArray_value.IsObject()) {
-      return false;
-    }
-    JSObject isArray = static_cast<JSObject>(isArray_value);
-    if (!isArray.IsFunction()) {
-      return false;
-    }
-
-    JSValue self = static_cast<JSValue>(*this);
-    JSValue result = isArray(self, global_object);
-    if (result.IsBoolean()) {
-        return static_cast<bool>(result);
-    }
-    
-    return false;
+    return detail::JSBuiltins::Get(js_context__).IsArray(js_object_ref__);
   }
   
   bool JSObject::IsError() const HAL_NOEXCEPT {
     HAL_JSOBJECT_LOCK_GUARD;
-    const auto global_object = js_context__.get_global_object();
-    const auto error_value = global_object.GetProperty("Error");
-    if (!error_value.IsObject()) {
-      return false;
-    }
-    const auto error = static_cast<JSObject>(error_value);
-    const auto self  = static_cast<JSValue>(*this);
-    return static_cast<std::string>(self) == "[object Error]" || self.IsInstanceOfConstructor(error);
+    return detail::JSBuiltins::Get(js_context__).IsError(js_object_ref__);
   }
   
   JSValue JSObject::operator()(                                        JSObject this_object) { return CallAsFunction(std::vector<JSValue>()                      , this_object); }
@@ -167,6 +180,11 @@ namespace HAL {
   JSObject JSObject::CallAsConstructor(const JSString&              argument ) { return CallAsConstructor(std::vector<JSString> {argument}); }
   JSObject JSObject::CallAsConstructor(const std::vector<JSString>& arguments) { return CallAsConstructor(detail::to_vector(js_context__, arguments)); }
   JSObject JSObject::CallAsConstructor(const std::vector<JSValue>&  arguments) {
+    const auto arguments_array = detail::to_vector(arguments);
+    return JSObject(js_context__, ConstructWithArray(arguments_array.size(), arguments_array.data()));
+  }
+  
+  JSObjectRef JSObject::ConstructWithArray(std::size_t argument_count, const JSValueRef arguments_array[]) {
     HAL_JSOBJECT_LOCK_GUARD;
     
     if (!IsConstructor()) {
@@ -174,13 +192,7 @@ namespace HAL {
     }
     
     JSValueRef exception { nullptr };
-    JSObjectRef js_object_ref = nullptr;
-    if (!arguments.empty()) {
-      const auto arguments_array = detail::to_vector(arguments);
-      js_object_ref = JSObjectCallAsConstructor(static_cast<JSContextRef>(js_context__), js_object_ref__, arguments_array.size(), &arguments_array[0], &exception);
-    } else {
-      js_object_ref = JSObjectCallAsConstructor(static_cast<JSContextRef>(js_context__), js_object_ref__, 0, nullptr, &exception);
-    }
+    JSObjectRef js_object_ref = JSObjectCallAsConstructor(static_cast<JSContextRef>(js_context__), js_object_ref__, argument_count, argument_count > 0 ? arguments_array : nullptr, &exception);
     
     if (exception) {
       // If this assert fails then we need to JSValueUnprotect
@@ -191,7 +203,7 @@ namespace HAL {
     
     // postcondition
     assert(js_object_ref);
-    return JSObject(js_context__, js_object_ref);
+    return js_object_ref;
   }
   
   JSValue JSObject::GetPrototype() const HAL_NOEXCEPT {
@@ -207,31 +219,32 @@ namespace HAL {
   }
   
   bool JSObject::SetPrivate(void* data) const HAL_NOEXCEPT {
-    UnRegisterPrivateData(GetPrivate());
-    RegisterPrivateData(js_object_ref__, data);
     return JSObjectSetPrivate(js_object_ref__, data);
   }
   
   JSObject::~JSObject() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSObject:: dtor ", this);
-    HAL_LOG_TRACE("JSObject:: release ", js_object_ref__, " for ", this);
-    UnRegisterJSContext(js_object_ref__);
+    if (js_object_ref__) {
+      HAL_LOG_TRACE("JSObject:: release ", js_object_ref__, " for ", this);
+      UnRegisterJSContext(js_object_ref__);
+    }
   }
   
   JSObject::JSObject(const JSObject& rhs) HAL_NOEXCEPT
   : js_context__(rhs.js_context__)
   , js_object_ref__(rhs.js_object_ref__) {
     HAL_LOG_TRACE("JSObject:: copy ctor ", this);
-    HAL_LOG_TRACE("JSObject:: retain ", js_object_ref__, " for ", this);
-    RegisterJSContext(static_cast<JSContextRef>(js_context__), js_object_ref__);
+    if (js_object_ref__) {
+      HAL_LOG_TRACE("JSObject:: retain ", js_object_ref__, " for ", this);
+      RegisterJSContext(static_cast<JSContextRef>(js_context__), js_object_ref__);
+    }
   }
   
   JSObject::JSObject(JSObject&& rhs) HAL_NOEXCEPT
   : js_context__(std::move(rhs.js_context__))
   , js_object_ref__(rhs.js_object_ref__) {
     HAL_LOG_TRACE("JSObject:: move ctor ", this);
-    HAL_LOG_TRACE("JSObject:: retain ", js_object_ref__, " for ", this);
-    RegisterJSContext(static_cast<JSContextRef>(js_context__), js_object_ref__);
+    rhs.js_object_ref__ = nullptr;
   }
   
   JSObject& JSObject::operator=(JSObject rhs) {
@@ -239,7 +252,7 @@ namespace HAL {
     HAL_LOG_TRACE("JSObject:: assignment ", this);
     // JSValues can only be copied between contexts within the same
     // context group.
-    if (js_context__.get_context_group() != rhs.js_context__.get_context_group()) {
+    if (js_object_ref__ && rhs.js_object_ref__ && js_context__.get_context_group() != rhs.js_context__.get_context_group()) {
       detail::ThrowRuntimeError("JSObject", "JSObjects must belong to JSContexts within the same JSContextGroup to be shared and exchanged.");
     }
     
@@ -288,6 +301,11 @@ namespace HAL {
   }
   
   JSValue JSObject::CallAsFunction(const std::vector<JSValue>&  arguments, JSObject this_object) {
+    const auto arguments_array = detail::to_vector(arguments);
+    return JSValue(js_context__, CallWithArray(static_cast<JSObjectRef>(this_object), arguments_array.size(), arguments_array.data()));
+  }
+  
+  JSValueRef JSObject::CallWithArray(JSObjectRef this_object_ref, std::size_t argument_count, const JSValueRef arguments_array[]) {
     HAL_JSOBJECT_LOCK_GUARD;
     
     if (!IsFunction()) {
@@ -295,13 +313,7 @@ namespace HAL {
     }
     
     JSValueRef exception { nullptr };
-    JSValueRef js_value_ref { nullptr };
-    if (!arguments.empty()) {
-      const auto arguments_array = detail::to_vector(arguments);
-      js_value_ref = JSObjectCallAsFunction(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSObjectRef>(this_object), arguments_array.size(), &arguments_array[0], &exception);
-    } else {
-      js_value_ref = JSObjectCallAsFunction(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSObjectRef>(this_object), 0, nullptr, &exception);
-    }
+    JSValueRef js_value_ref = JSObjectCallAsFunction(static_cast<JSContextRef>(js_context__), js_object_ref__, this_object_ref, argument_count, argument_count > 0 ? arguments_array : nullptr, &exception);
     
     if (exception) {
       // If this assert fails then we need to JSValueUnprotect
@@ -311,7 +323,7 @@ namespace HAL {
     }
     
     assert(js_value_ref);
-    return JSValue(js_context__, js_value_ref);
+    return js_value_ref;
   }
   
   void JSObject::GetPropertyNames(const JSPropertyNameAccumulator& accumulator) const HAL_NOEXCEPT {
@@ -321,66 +333,49 @@ namespace HAL {
     }
   }
   
-  std::unordered_map<std::intptr_t, std::tuple<std::intptr_t, std::size_t>> JSObject::js_object_ref_to_js_context_ref_map__;
+  detail::JSHandleRegistry JSObject::js_object_handle_registry__;
   
   void JSObject::RegisterJSContext(JSContextRef js_context_ref, JSObjectRef js_object_ref) {
     HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key   = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto value = reinterpret_cast<std::intptr_t>(js_context_ref);
-    
-    const auto position = js_object_ref_to_js_context_ref_map__.find(key);
-    const bool found    = position != js_object_ref_to_js_context_ref_map__.end();
-    
-    if (found) {
-      auto tuple = position -> second;
-      ++std::get<1>(tuple);
-      js_object_ref_to_js_context_ref_map__[key] = tuple;
-      
-      HAL_LOG_DEBUG("JSObject::RegisterJSContext: JSObjectRef = ", js_object_ref, ", JSContextRef = ", js_context_ref, " count = ", std::get<1>(tuple));
-    } else {
-      const auto insert_result = js_object_ref_to_js_context_ref_map__.emplace(key, std::make_tuple(value, 1));
-      const bool inserted      = insert_result.second;
-      
-      if (inserted) {
-        JSValueProtect(static_cast<JSContextRef>(js_context_ref), js_object_ref);
-        HAL_LOG_DEBUG("JSObject::RegisterJSContext: JSObjectRef = ", js_object_ref, ", JSContextRef = ", js_context_ref, " count = 1");
-      }
+    HAL_PERFORMANCE_COUNTER_RETAIN(JSObject);
+    const auto count = js_object_handle_registry__.Retain(js_object_ref, js_context_ref);
+    if (count == 1) {
+      JSValueProtect(static_cast<JSContextRef>(js_context_ref), js_object_ref);
     }
+    HAL_LOG_DEBUG("JSObject::RegisterJSContext: JSObjectRef = ", js_object_ref, ", JSContextRef = ", js_context_ref, " count = ", count);
   }
   
   void JSObject::UnRegisterJSContext(JSObjectRef js_object_ref) {
     HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key      = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto position = js_object_ref_to_js_context_ref_map__.find(key);
-    const bool found    = position != js_object_ref_to_js_context_ref_map__.end();
+    HAL_PERFORMANCE_COUNTER_RELEASE(JSObject);
+    std::size_t count { 0 };
+    const void* context { nullptr };
     
     // precondition
-    if (found) {
-      auto tuple = position -> second;
-      JSContextRef js_context_ref = reinterpret_cast<JSContextRef>(std::get<0>(tuple));
-      static_cast<void>(js_context_ref); // just meant to suppress "unused" compiler warning
-      --std::get<1>(tuple);
-      if (std::get<1>(tuple) == 0) {
-        JSValueUnprotect(static_cast<JSContextRef>(js_context_ref), js_object_ref);
-        js_object_ref_to_js_context_ref_map__.erase(key);
-      } else {
-        js_object_ref_to_js_context_ref_map__[key] = tuple;
+    if (js_object_handle_registry__.Release(js_object_ref, count, context)) {
+      JSContextRef js_context_ref = static_cast<JSContextRef>(context);
+      if (count == 0) {
+        JSValueUnprotect(js_context_ref, js_object_ref);
       }
-      HAL_LOG_DEBUG("JSObject::UnRegisterJSContext: JSObjectRef = ", js_object_ref, ", JSContextRef = ", js_context_ref, " count = ", std::get<1>(tuple));
+      HAL_LOG_DEBUG("JSObject::UnRegisterJSContext: JSObjectRef = ", js_object_ref, ", JSContextRef = ", js_context_ref, " count = ", count);
     } else {
       HAL_LOG_DEBUG("JSObject::UnRegisterJSContext: JSObjectRef = ", js_object_ref, " not registered");
     }
   }
 
+  std::size_t JSObject::GetReferenceCount(JSObjectRef js_object_ref) HAL_NOEXCEPT {
+    HAL_JSOBJECT_LOCK_GUARD_STATIC;
+    return js_object_handle_registry__.GetCount(js_object_ref);
+  }
+
   JSObject JSObject::FindJSObject(JSContextRef js_context_ref, JSObjectRef js_object_ref) {
     HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key      = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto position = js_object_ref_to_js_context_ref_map__.find(key);
-    const bool found    = position != js_object_ref_to_js_context_ref_map__.end();
+    const auto context = js_object_handle_registry__.FindContext(js_object_ref);
+    const bool found   = context != nullptr;
     
     // precondition
     if (found) {
-      js_context_ref = reinterpret_cast<JSContextRef>(std::get<0>(position -> second));
+      js_context_ref = static_cast<JSContextRef>(context);
     }
     
     HAL_LOG_TRACE("JSObject::FindJSObject: found = ", found, " for JSObjectRef ", js_object_ref, ", JSContextRef = ", js_context_ref);
@@ -388,70 +383,18 @@ namespace HAL {
     return JSObject(JSContext(js_context_ref), js_object_ref);
   }
 
-  std::unordered_map<std::intptr_t, std::intptr_t> JSObject::js_private_data_to_js_object_ref_map__;
-  
-  void JSObject::RegisterPrivateData(JSObjectRef js_object_ref, void* private_data) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    // we won't store nullptr
-    if (private_data == nullptr) {
-      return;
-    }
-    const auto key   = reinterpret_cast<std::intptr_t>(private_data);
-    const auto value = reinterpret_cast<std::intptr_t>(js_object_ref);
-    
-    const auto position = js_private_data_to_js_object_ref_map__.find(key);
-    const bool found    = position != js_private_data_to_js_object_ref_map__.end();
-    
-    if (found) {
-      // private data should not be shared by multiple JSObjectRef
-      assert((reinterpret_cast<JSObjectRef>(position -> second) == js_object_ref));
-    } else {
-      const auto insert_result = js_private_data_to_js_object_ref_map__.emplace(key, value);
-      const bool inserted      = insert_result.second;
-      
-      // postcondition
-      assert(inserted);
-      
-      HAL_LOG_DEBUG("JSObject::RegisterPrivateData: JSObjectRef = ", js_object_ref, ", data = ", private_data);
-    }
-  }
-  
-  void JSObject::UnRegisterPrivateData(void* private_data) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    // we won't store nullptr
-    if (private_data == nullptr) {
-      return;
-    }
-    const auto key      = reinterpret_cast<std::intptr_t>(private_data);
-    const auto position = js_private_data_to_js_object_ref_map__.find(key);
-    const bool found    = position != js_private_data_to_js_object_ref_map__.end();
-    
-    if (found) {
-      JSObjectRef js_object_ref = reinterpret_cast<JSObjectRef>(position -> second);
-      static_cast<void>(js_object_ref); // just meant to suppress "unused" compiler warning
-      js_private_data_to_js_object_ref_map__.erase(key);
-      HAL_LOG_DEBUG("JSObject::UnRegisterPrivateData: data = ", private_data, ", JSObjectRef = ", js_object_ref);
-    } else {
-      HAL_LOG_DEBUG("JSObject::UnRegisterPrivateData: data = ", private_data, " not registered");
-    }
-  }
-
   JSObject JSObject::FindJSObjectFromPrivateData(JSContext js_context, void* private_data) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key      = reinterpret_cast<std::intptr_t>(private_data);
-    const auto position = js_private_data_to_js_object_ref_map__.find(key);
-    const bool found    = position != js_private_data_to_js_object_ref_map__.end();
-
-    // This could happen when owner object is gargabe collected while executing async operation.
-    // This Error object will be only used internally to see if object is found or not.
-    if (!found) {
+    // The private data of a JavaScript object created by JSExport is
+    // a JSExportObject that points back to it, until it is finalized.
+    // Other private data, such as that of the functions created from
+    // native callbacks, has no JSExportPool header with a registered
+    // class info.
+    const auto class_info = detail::JSExportClassInfo::FindClassInfo(private_data);
+    if (!class_info || !class_info->is_js_export_object()) {
       return js_context.CreateError();
     }
 
-    JSObjectRef js_object_ref = reinterpret_cast<JSObjectRef>(position -> second);
-    HAL_LOG_TRACE("JSObject::FindJSObjectFromPrivateData: found = ", found, " for data = ", key, ", JSObjectRef = ", js_object_ref);
-
-    return FindJSObject(static_cast<JSContextRef>(js_context), js_object_ref);
+    return static_cast<JSExportObject*>(private_data)->get_object();
   }
 
 } // namespace HAL {
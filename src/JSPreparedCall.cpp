@@ -0,0 +1,55 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSPreparedCall.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+
+namespace HAL {
+
+  JSPreparedCall::JSPreparedCall(const JSObject& function, const JSObject& this_object, std::size_t arity)
+  : js_context__(function.get_context())
+  , function__(function)
+  , this_object__(this_object)
+  , function_ref__(static_cast<JSObjectRef>(function))
+  , this_object_ref__(static_cast<JSObjectRef>(this_object)) {
+    if (!function__.IsFunction()) {
+      detail::ThrowInvalidArgument("JSPreparedCall", "This JavaScript object is not a function.");
+    }
+    arguments__.reserve(arity);
+  }
+
+  JSPreparedCall::JSPreparedCall(const JSObject& function, std::size_t arity)
+  : JSPreparedCall(function, function.get_context().get_global_object(), arity) {
+  }
+
+  JSValue JSPreparedCall::Apply(const std::vector<JSValue>& arguments) {
+    arguments__.clear();
+    for (const auto& argument : arguments) {
+      arguments__.push_back(static_cast<JSValueRef>(argument));
+    }
+    return JSValue(js_context__, CallWithArray(arguments__.size(), arguments__.data()));
+  }
+
+  JSValueRef JSPreparedCall::CallWithArray(std::size_t argument_count, const JSValueRef arguments_array[]) {
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectCallAsFunction(static_cast<JSContextRef>(js_context__), function_ref__, this_object_ref__, argument_count, argument_count > 0 ? arguments_array : nullptr, &exception);
+
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_value_ref.
+      assert(!js_value_ref);
+      detail::ThrowRuntimeError("JSPreparedCall", JSValue(js_context__, exception));
+    }
+
+    assert(js_value_ref);
+    return js_value_ref;
+  }
+
+} // namespace HAL {
@@ -0,0 +1,91 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSPropertyKey.hpp"
+
+#include <unordered_map>
+#include <mutex>
+#include <cassert>
+
+namespace HAL { namespace detail {
+  
+  // The process-wide atom table. Interned JSStringRefs are retained
+  // by the table and never released.
+  class JSPropertyKeyTable final {
+    
+  public:
+    
+    static JSPropertyKeyTable& Instance() {
+      static JSPropertyKeyTable instance;
+      return instance;
+    }
+    
+    JSStringRef Intern(const JSString& name) {
+      std::lock_guard<std::mutex> lock(mutex__);
+      const auto position = atoms__.find(name);
+      if (position != atoms__.end()) {
+        return position -> second;
+      }
+      
+      const auto js_string_ref = JSStringRetain(static_cast<JSStringRef>(name));
+      atoms__.emplace(name, js_string_ref);
+      return js_string_ref;
+    }
+    
+  private:
+    
+    JSPropertyKeyTable() {
+      // Pre-intern the well-known property names.
+      for (const auto name : { "Array", "constructor", "Error", "fileName", "isArray", "length", "lineNumber", "message", "name", "native_stack", "prototype", "stack" }) {
+        Intern(name);
+      }
+    }
+    
+    std::mutex                                 mutex__;
+    std::unordered_map<JSString, JSStringRef> atoms__;
+  };
+  
+}} // namespace HAL { namespace detail {
+
+namespace HAL {
+  
+  JSPropertyKey::JSPropertyKey(const char* name) HAL_NOEXCEPT
+  : JSPropertyKey(JSString(name)) {
+  }
+  
+  JSPropertyKey::JSPropertyKey(const std::string& name) HAL_NOEXCEPT
+  : JSPropertyKey(JSString(name)) {
+  }
+  
+  JSPropertyKey::JSPropertyKey(const JSString& name) HAL_NOEXCEPT
+  : js_string_ref__(detail::JSPropertyKeyTable::Instance().Intern(name)) {
+    assert(js_string_ref__);
+  }
+  
+#define HAL_JSPROPERTYKEY_WELL_KNOWN(method_name, property_name) \
+  const JSPropertyKey& JSPropertyKey::method_name() HAL_NOEXCEPT { \
+    static const JSPropertyKey js_property_key(property_name);     \
+    return js_property_key;                                        \
+  }
+  
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Array      , "Array")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Constructor, "constructor")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Error      , "Error")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(FileName   , "fileName")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(IsArray    , "isArray")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Length     , "length")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(LineNumber , "lineNumber")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Message    , "message")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Name       , "name")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(NativeStack, "native_stack")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Prototype  , "prototype")
+  HAL_JSPROPERTYKEY_WELL_KNOWN(Stack      , "stack")
+  
+#undef HAL_JSPROPERTYKEY_WELL_KNOWN
+  
+} // namespace HAL {
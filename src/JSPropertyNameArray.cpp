@@ -38,22 +38,27 @@ namespace HAL {
   
   JSPropertyNameArray::~JSPropertyNameArray() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSPropertyNameArray:: dtor ", this);
-    HAL_LOG_TRACE("JSPropertyNameArray:: release ", js_property_name_array_ref__, " for ", this);
-    JSPropertyNameArrayRelease(js_property_name_array_ref__);
+    if (js_property_name_array_ref__) {
+      HAL_LOG_TRACE("JSPropertyNameArray:: release ", js_property_name_array_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RELEASE(JSPropertyNameArray);
+      JSPropertyNameArrayRelease(js_property_name_array_ref__);
+    }
   }
   
   JSPropertyNameArray::JSPropertyNameArray(const JSPropertyNameArray& rhs) HAL_NOEXCEPT
   : js_property_name_array_ref__(rhs.js_property_name_array_ref__) {
     HAL_LOG_TRACE("JSPropertyNameArray:: copy ctor ", this);
-    HAL_LOG_TRACE("JSPropertyNameArray:: retain ", js_property_name_array_ref__, " for ", this);
-    JSPropertyNameArrayRetain(js_property_name_array_ref__);
+    if (js_property_name_array_ref__) {
+      HAL_LOG_TRACE("JSPropertyNameArray:: retain ", js_property_name_array_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RETAIN(JSPropertyNameArray);
+      JSPropertyNameArrayRetain(js_property_name_array_ref__);
+    }
   }
   
   JSPropertyNameArray::JSPropertyNameArray(JSPropertyNameArray&& rhs) HAL_NOEXCEPT
   : js_property_name_array_ref__(rhs.js_property_name_array_ref__) {
-    HAL_LOG_TRACE("JSValue:: move ctor ", this);
-    HAL_LOG_TRACE("JSPropertyNameArray:: retain ", js_property_name_array_ref__, " for ", this);
-    JSPropertyNameArrayRetain(js_property_name_array_ref__);
+    HAL_LOG_TRACE("JSPropertyNameArray:: move ctor ", this);
+    rhs.js_property_name_array_ref__ = nullptr;
   }
   
   JSPropertyNameArray& JSPropertyNameArray::operator=(JSPropertyNameArray rhs) HAL_NOEXCEPT {
@@ -7,38 +7,56 @@
  */
 
 #include "HAL/JSString.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <vector>
 
 namespace HAL {
   
+  struct JSString::Cache {
+    std::once_flag string_once_flag;
+    std::string    string;
+    std::once_flag hash_value_once_flag;
+    std::size_t    hash_value { 0 };
+  };
+  
+
   JSString::JSString() HAL_NOEXCEPT
   : JSString("") {
     //HAL_LOG_TRACE("JSString::JSString()");
   }
   
   JSString::JSString(const char* string) HAL_NOEXCEPT
-  : js_string_ref__(JSStringCreateWithUTF8CString(string))
-  , string__(string) {
+  : js_string_ref__(detail::JSStringCreateWithUTF8(string, std::strlen(string))) {
     HAL_LOG_TRACE("JSString:: ctor 1 ", this);
     HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " (implicit) for ", this);
-    
-    std::hash<std::string> hash_function = std::hash<std::string>();
-    hash_value__ = hash_function(static_cast<std::string>(string__));
     //HAL_LOG_TRACE("JSString::JSString(const char*)");
   }
   
   JSString::JSString(const std::string& string) HAL_NOEXCEPT
-  : js_string_ref__(JSStringCreateWithUTF8CString(string.c_str()))
-  , string__(string) {
+  : js_string_ref__(detail::JSStringCreateWithUTF8(string.data(), string.size())) {
     HAL_LOG_TRACE("JSString:: ctor 2 ", this);
     HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " (implicit) for ", this);
-
-    std::hash<std::string> hash_function = std::hash<std::string>();
-    hash_value__ = hash_function(static_cast<std::string>(string__));
     //HAL_LOG_TRACE("JSString::JSString(const std::string&)");
   }
   
+  JSString::JSString(const char16_t* string, std::size_t length) HAL_NOEXCEPT
+  : js_string_ref__(JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(string), length)) {
+    HAL_LOG_TRACE("JSString:: ctor 4 ", this);
+    HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " (implicit) for ", this);
+  }
+  
+  JSString::JSString(const char16_t* string) HAL_NOEXCEPT
+  : JSString(string, std::char_traits<char16_t>::length(string)) {
+  }
+  
+  JSString::JSString(const std::u16string& string) HAL_NOEXCEPT
+  : JSString(string.data(), string.size()) {
+  }
+  
   const std::size_t JSString::length() const  HAL_NOEXCEPT{
     HAL_JSSTRING_LOCK_GUARD;
     return JSStringGetLength(js_string_ref__);
@@ -53,35 +71,84 @@ namespace HAL {
   }
   
   JSString::operator std::string() const HAL_NOEXCEPT {
-    return string__;
+    return utf8();
+  }
+  
+  JSString::operator std::u16string() const HAL_NOEXCEPT {
+    return std::u16string(u16data(), length());
+  }
+  
+  const char16_t* JSString::u16data() const HAL_NOEXCEPT {
+    static_assert(sizeof(JSChar) == sizeof(char16_t), "JSChar must be a UTF-16 code unit");
+    return reinterpret_cast<const char16_t*>(JSStringGetCharactersPtr(js_string_ref__));
+  }
+  
+  const std::string& JSString::utf8() const HAL_NOEXCEPT {
+    auto& cache = get_cache();
+    const auto js_string_ref = js_string_ref__;
+    std::call_once(cache.string_once_flag, [&cache, js_string_ref]() {
+      cache.string = detail::JSStringToUTF8(js_string_ref);
+    });
+    return cache.string;
   }
   
   std::size_t JSString::hash_value() const {
-    return hash_value__;
+    auto& cache = get_cache();
+    std::call_once(cache.hash_value_once_flag, [this, &cache]() {
+      // FNV-1a over the bytes of the cached UTF-8 string. Reading the
+      // UTF-16 code units instead would upconvert an 8-bit string and
+      // keep the copy for the lifetime of the string.
+      std::uint64_t hash_value = 14695981039346656037ULL;
+      for (const char byte : utf8()) {
+        hash_value ^= static_cast<unsigned char>(byte);
+        hash_value *= 1099511628211ULL;
+      }
+      cache.hash_value = static_cast<std::size_t>(hash_value);
+    });
+    return cache.hash_value;
+  }
+  
+  JSString::Cache& JSString::get_cache() const HAL_NOEXCEPT {
+    // The cache is created on first use by a const member function,
+    // possibly from several threads at once, so it is published with
+    // a compare-exchange instead of a plain store. The thread that
+    // loses the race uses the winner's cache.
+    auto self  = const_cast<JSString*>(this);
+    auto cache = std::atomic_load(&self -> cache__);
+    if (!cache) {
+      auto new_cache = std::make_shared<Cache>();
+      if (std::atomic_compare_exchange_strong(&self -> cache__, &cache, new_cache)) {
+        cache = new_cache;
+      }
+    }
+    return *cache;
   }
   
   JSString::~JSString() HAL_NOEXCEPT {
     HAL_LOG_TRACE("JSString:: dtor ", this);
-    HAL_LOG_TRACE("JSString:: release ", js_string_ref__, " for ", this);
-    JSStringRelease(js_string_ref__);
+    if (js_string_ref__) {
+      HAL_LOG_TRACE("JSString:: release ", js_string_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RELEASE(JSString);
+      JSStringRelease(js_string_ref__);
+    }
   }
   
   JSString::JSString(const JSString& rhs) HAL_NOEXCEPT
   : js_string_ref__(rhs.js_string_ref__)
-  , string__(rhs.string__)
-  , hash_value__(rhs.hash_value__) {
+  , cache__(std::atomic_load(&rhs.cache__)) {
     HAL_LOG_TRACE("JSString:: copy ctor ", this);
-    HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " for ", this);
-    JSStringRetain(js_string_ref__);
+    if (js_string_ref__) {
+      HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " for ", this);
+      HAL_PERFORMANCE_COUNTER_RETAIN(JSString);
+      JSStringRetain(js_string_ref__);
+    }
   }
   
   JSString::JSString(JSString&& rhs) HAL_NOEXCEPT
   : js_string_ref__(rhs.js_string_ref__)
-  , string__(std::move(rhs.string__))
-  , hash_value__(std::move(rhs.hash_value__)) {
+  , cache__(std::move(rhs.cache__)) {
     HAL_LOG_TRACE("JSString:: move ctor ", this);
-    HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " for ", this);
-    JSStringRetain(js_string_ref__);
+    rhs.js_string_ref__ = nullptr;
   }
   
   JSString& JSString::operator=(JSString rhs) HAL_NOEXCEPT {
@@ -99,8 +166,7 @@ namespace HAL {
     // By swapping the members of two classes, the two classes are
     // effectively swapped.
     swap(js_string_ref__, other.js_string_ref__);
-    swap(string__       , other.string__);
-    swap(hash_value__   , other.hash_value__);
+    swap(cache__        , other.cache__);
   }
   
   // For interoperability with the JavaScriptCore C API.
@@ -110,15 +176,6 @@ namespace HAL {
     JSStringRetain(js_string_ref__);
     HAL_LOG_TRACE("JSString:: ctor 3 ", this);
     HAL_LOG_TRACE("JSString:: retain ", js_string_ref__, " for ", this);
-
-    const auto size = JSStringGetMaximumUTF8CStringSize(js_string_ref__);
-    auto buffer = new char[size];
-    JSStringGetUTF8CString(js_string_ref__, buffer, size);
-    string__ = std::string(buffer);
-    delete[] buffer;
-    
-    std::hash<std::string> hash_function = std::hash<std::string>();
-    hash_value__ = hash_function(static_cast<std::string>(string__));
   }
   
   bool operator==(const JSString& lhs, const JSString& rhs) {
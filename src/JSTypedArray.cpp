@@ -0,0 +1,88 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSTypedArray.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include <cassert>
+
+namespace HAL { namespace detail {
+
+namespace {
+
+JSObjectRef CheckMadeTypedArray(const JSContext& js_context, JSObjectRef js_object_ref, JSValueRef exception) {
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_object_ref.
+		assert(!js_object_ref);
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+
+	assert(js_object_ref);
+	return js_object_ref;
+}
+
+} // namespace {
+
+JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, std::size_t length) {
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeTypedArray(static_cast<JSContextRef>(js_context), type, length, &exception);
+	return CheckMadeTypedArray(js_context, js_object_ref, exception);
+}
+
+JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, void* bytes, std::size_t byte_length, const JSBytesDeallocator& deallocator) {
+	JSValueRef exception { nullptr };
+	void* deallocator_context = MakeBytesDeallocatorContext(deallocator);
+	JSObjectRef js_object_ref = JSObjectMakeTypedArrayWithBytesNoCopy(static_cast<JSContextRef>(js_context), type, bytes, byte_length, deallocator_context ? DeallocateBytes : nullptr, deallocator_context, &exception);
+	return CheckMadeTypedArray(js_context, js_object_ref, exception);
+}
+
+JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length) {
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeTypedArrayWithArrayBufferAndOffset(static_cast<JSContextRef>(js_context), type, static_cast<JSObjectRef>(array_buffer), byte_offset, length, &exception);
+	return CheckMadeTypedArray(js_context, js_object_ref, exception);
+}
+
+void CheckTypedArrayType(const JSObject& js_object, JSTypedArrayType type) {
+	if (JSValueGetTypedArrayType(static_cast<JSContextRef>(js_object.get_context()), static_cast<JSObjectRef>(js_object), nullptr) != type) {
+		ThrowInvalidArgument("JSTypedArray", "This JavaScript object is not a typed array of the requested type.");
+	}
+}
+
+void* GetTypedArrayBytes(const JSObject& js_object) HAL_NOEXCEPT {
+	// Derive the elements from the ArrayBuffer's bytes and the typed
+	// array's offset, rather than relying on whether
+	// JSObjectGetTypedArrayBytesPtr applies the offset in this
+	// JavaScriptCore release.
+	const auto js_context_ref = static_cast<JSContextRef>(js_object.get_context());
+	const auto js_object_ref  = static_cast<JSObjectRef>(js_object);
+	JSObjectRef array_buffer_ref = JSObjectGetTypedArrayBuffer(js_context_ref, js_object_ref, nullptr);
+	if (!array_buffer_ref) {
+		return nullptr;
+	}
+
+	const auto bytes = static_cast<std::uint8_t*>(JSObjectGetArrayBufferBytesPtr(js_context_ref, array_buffer_ref, nullptr));
+	return bytes ? bytes + JSObjectGetTypedArrayByteOffset(js_context_ref, js_object_ref, nullptr) : nullptr;
+}
+
+std::size_t GetTypedArrayLength(const JSObject& js_object) HAL_NOEXCEPT {
+	return JSObjectGetTypedArrayLength(static_cast<JSContextRef>(js_object.get_context()), static_cast<JSObjectRef>(js_object), nullptr);
+}
+
+std::size_t GetTypedArrayByteOffset(const JSObject& js_object) HAL_NOEXCEPT {
+	return JSObjectGetTypedArrayByteOffset(static_cast<JSContextRef>(js_object.get_context()), static_cast<JSObjectRef>(js_object), nullptr);
+}
+
+JSObject GetTypedArrayBuffer(const JSObject& js_object) {
+	const auto js_context = js_object.get_context();
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectGetTypedArrayBuffer(static_cast<JSContextRef>(js_context), static_cast<JSObjectRef>(js_object), &exception);
+	return JSObject(js_context, CheckMadeTypedArray(js_context, js_object_ref, exception));
+}
+
+}} // namespace HAL { namespace detail {
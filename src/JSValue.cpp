@@ -26,40 +26,46 @@
 #include "HAL/JSClass.hpp"
 
 #include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
 
 #include <sstream>
 #include <cassert>
 
 namespace HAL {
   
-  std::unordered_map<std::intptr_t, std::size_t> JSValue::js_value_retain_count_map__;
+  detail::JSHandleRegistry JSValue::js_value_handle_registry__;
   
   void JSValue::Protect()
   {
-    const auto ptr = reinterpret_cast<std::intptr_t>(js_value_ref__);
-    const auto iter = js_value_retain_count_map__.find(ptr);
-    if (iter == js_value_retain_count_map__.end()) {
+    // A moved-from JSValue holds no reference.
+    if (!js_value_ref__) {
+      return;
+    }
+    HAL_PERFORMANCE_COUNTER_RETAIN(JSValue);
+    if (js_value_handle_registry__.Retain(js_value_ref__) == 1) {
       JSValueProtect(static_cast<JSContextRef>(js_context__), js_value_ref__);
-      js_value_retain_count_map__.emplace(ptr, 1);
-    } else {
-      js_value_retain_count_map__[ptr] = ++iter->second;
     }
   }
 
   void JSValue::Unprotect()
   {
-    const auto ptr = reinterpret_cast<std::intptr_t>(js_value_ref__);
-    const auto iter = js_value_retain_count_map__.find(ptr);
-    assert(iter != js_value_retain_count_map__.end());
-    const auto count = --iter->second;
-    if (count == 0) {
+    if (!js_value_ref__) {
+      return;
+    }
+    HAL_PERFORMANCE_COUNTER_RELEASE(JSValue);
+    std::size_t count { 0 };
+    const void* context { nullptr };
+    const bool found = js_value_handle_registry__.Release(js_value_ref__, count, context);
+    assert(found);
+    if (found && count == 0) {
       JSValueUnprotect(static_cast<JSContextRef>(js_context__), js_value_ref__);
-      js_value_retain_count_map__.erase(ptr);
-    } else {
-      js_value_retain_count_map__[ptr] = count;
     }
   }
 
+  std::size_t JSValue::GetReferenceCount(JSValueRef js_value_ref) HAL_NOEXCEPT {
+    return js_value_handle_registry__.GetCount(js_value_ref);
+  }
+
   JSString JSValue::ToJSONString(unsigned indent) const {
     HAL_JSVALUE_LOCK_GUARD;
     JSValueRef exception { nullptr };
@@ -99,7 +105,23 @@ namespace HAL {
   }
   
   JSValue::operator std::string() const {
-    return operator JSString();
+    HAL_JSVALUE_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(static_cast<JSContextRef>(js_context__), js_value_ref__, &exception);
+    if (exception) {
+      // If this assert fails then we need to JSStringRelease
+      // js_string_ref.
+      assert(!js_string_ref);
+      detail::ThrowRuntimeError("JSValue", JSValue(js_context__, exception));
+    }
+    
+    // Transcode straight from the JavaScriptCore string instead of
+    // going through a JSString and its lazily created cache.
+    assert(js_string_ref);
+    std::string string = detail::JSStringToUTF8(js_string_ref);
+    JSStringRelease(js_string_ref);
+    
+    return string;
   }
   
   JSValue::operator bool() const HAL_NOEXCEPT {
@@ -258,8 +280,7 @@ namespace HAL {
   , js_value_ref__(rhs.js_value_ref__)
   , is_native_nullptr__(rhs.is_native_nullptr__){
     HAL_LOG_TRACE("JSValue:: move ctor ", this);
-    HAL_LOG_TRACE("JSValue:: retain ", js_value_ref__, " for ", this);
-    Protect();
+    rhs.js_value_ref__ = nullptr;
   }
   
   JSValue& JSValue::operator=(JSValue rhs) {
@@ -267,7 +288,7 @@ namespace HAL {
     HAL_LOG_TRACE("JSValue:: copy assignment ", this);
     // JSValues can only be copied between contexts within the same
     // context group.
-    if (js_context__.get_context_group() != rhs.js_context__.get_context_group()) {
+    if (js_value_ref__ && rhs.js_value_ref__ && js_context__.get_context_group() != rhs.js_context__.get_context_group()) {
       detail::ThrowRuntimeError("JSValue", "JSValues must belong to JSContexts within the same JSContextGroup to be shared and exchanged.");
     }
     
@@ -0,0 +1,242 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/Local.hpp"
+#include "HAL/HandleScope.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSPropertyKey.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
+
+#include <cassert>
+
+namespace HAL {
+  
+  Local<JSValue>::Local(const HandleScope& handle_scope, JSValueRef js_value_ref) HAL_NOEXCEPT
+  : handle_scope__(&handle_scope)
+  , js_value_ref__(js_value_ref) {
+    assert(js_value_ref__);
+  }
+  
+  Local<JSValue>::Local(const HandleScope& handle_scope, const JSValue& js_value) HAL_NOEXCEPT
+  : handle_scope__(&handle_scope)
+  , js_value_ref__(static_cast<JSValueRef>(js_value)) {
+    // A native nullptr JSValue is passed to JavaScript as null.
+    if (!js_value_ref__) {
+      js_value_ref__ = JSValueMakeNull(static_cast<JSContextRef>(handle_scope));
+    }
+  }
+  
+  JSValue Local<JSValue>::Escape() const HAL_NOEXCEPT {
+    return JSValue(handle_scope__ -> get_context(), js_value_ref__);
+  }
+  
+  Local<JSValue>::operator Local<JSObject>() const {
+    const auto js_context_ref = static_cast<JSContextRef>(*handle_scope__);
+    JSValueRef exception { nullptr };
+    JSObjectRef js_object_ref = JSValueToObject(js_context_ref, js_value_ref__, &exception);
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_object_ref.
+      assert(!js_object_ref);
+      detail::ThrowRuntimeError("Local<JSValue>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_object_ref);
+    return Local<JSObject>(*handle_scope__, js_object_ref);
+  }
+  
+  Local<JSValue>::operator JSString() const {
+    const auto js_context_ref = static_cast<JSContextRef>(*handle_scope__);
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(js_context_ref, js_value_ref__, &exception);
+    if (exception) {
+      // If this assert fails then we need to JSStringRelease
+      // js_string_ref.
+      assert(!js_string_ref);
+      detail::ThrowRuntimeError("Local<JSValue>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_string_ref);
+    JSString js_string(js_string_ref);
+    JSStringRelease(js_string_ref);
+    
+    return js_string;
+  }
+  
+  Local<JSValue>::operator std::string() const {
+    const auto js_context_ref = static_cast<JSContextRef>(*handle_scope__);
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(js_context_ref, js_value_ref__, &exception);
+    if (exception) {
+      // If this assert fails then we need to JSStringRelease
+      // js_string_ref.
+      assert(!js_string_ref);
+      detail::ThrowRuntimeError("Local<JSValue>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_string_ref);
+    std::string string = detail::JSStringToUTF8(js_string_ref);
+    JSStringRelease(js_string_ref);
+    
+    return string;
+  }
+  
+  Local<JSValue>::operator bool() const HAL_NOEXCEPT {
+    return JSValueToBoolean(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  Local<JSValue>::operator double() const {
+    JSValueRef exception { nullptr };
+    const double result = JSValueToNumber(static_cast<JSContextRef>(*handle_scope__), js_value_ref__, &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSValue>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    return result;
+  }
+  
+  Local<JSValue>::operator int32_t() const {
+    return detail::to_int32_t(operator double());
+  }
+  
+  Local<JSValue>::operator uint32_t() const {
+    // ToInt32 and ToUint32 only differ in how the result is
+    // interpreted.
+    return operator int32_t();
+  }
+  
+  JSValue::Type Local<JSValue>::GetType() const HAL_NOEXCEPT {
+    switch (JSValueGetType(static_cast<JSContextRef>(*handle_scope__), js_value_ref__)) {
+      case kJSTypeUndefined:
+        return JSValue::Type::Undefined;
+      case kJSTypeNull:
+        return JSValue::Type::Null;
+      case kJSTypeBoolean:
+        return JSValue::Type::Boolean;
+      case kJSTypeNumber:
+        return JSValue::Type::Number;
+      case kJSTypeString:
+        return JSValue::Type::String;
+      case kJSTypeObject:
+        return JSValue::Type::Object;
+      default:
+        return JSValue::Type::Undefined;
+    }
+  }
+  
+  bool Local<JSValue>::IsUndefined() const HAL_NOEXCEPT {
+    return JSValueIsUndefined(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  bool Local<JSValue>::IsNull() const HAL_NOEXCEPT {
+    return JSValueIsNull(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  bool Local<JSValue>::IsBoolean() const HAL_NOEXCEPT {
+    return JSValueIsBoolean(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  bool Local<JSValue>::IsNumber() const HAL_NOEXCEPT {
+    return JSValueIsNumber(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  bool Local<JSValue>::IsString() const HAL_NOEXCEPT {
+    return JSValueIsString(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  bool Local<JSValue>::IsObject() const HAL_NOEXCEPT {
+    return JSValueIsObject(static_cast<JSContextRef>(*handle_scope__), js_value_ref__);
+  }
+  
+  Local<JSObject>::Local(const HandleScope& handle_scope, JSObjectRef js_object_ref) HAL_NOEXCEPT
+  : handle_scope__(&handle_scope)
+  , js_object_ref__(js_object_ref) {
+    assert(js_object_ref__);
+  }
+  
+  Local<JSObject>::Local(const HandleScope& handle_scope, const JSObject& js_object) HAL_NOEXCEPT
+  : handle_scope__(&handle_scope)
+  , js_object_ref__(static_cast<JSObjectRef>(js_object)) {
+    assert(js_object_ref__);
+  }
+  
+  JSObject Local<JSObject>::Escape() const {
+    return JSObject(handle_scope__ -> get_context(), js_object_ref__);
+  }
+  
+  bool Local<JSObject>::HasProperty(const JSPropertyKey& property_key) const HAL_NOEXCEPT {
+    return JSObjectHasProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_key));
+  }
+  
+  bool Local<JSObject>::HasProperty(const JSString& property_name) const HAL_NOEXCEPT {
+    return JSObjectHasProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_name));
+  }
+  
+  Local<JSValue> Local<JSObject>::GetProperty(const JSPropertyKey& property_key) const {
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectGetProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_key), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_value_ref);
+    return Local<JSValue>(*handle_scope__, js_value_ref);
+  }
+  
+  Local<JSValue> Local<JSObject>::GetProperty(const JSString& property_name) const {
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectGetProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_name), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_value_ref);
+    return Local<JSValue>(*handle_scope__, js_value_ref);
+  }
+  
+  Local<JSValue> Local<JSObject>::GetProperty(unsigned property_index) const {
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectGetPropertyAtIndex(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, property_index, &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+    
+    assert(js_value_ref);
+    return Local<JSValue>(*handle_scope__, js_value_ref);
+  }
+  
+  void Local<JSObject>::SetProperty(const JSPropertyKey& property_key, const Local<JSValue>& property_value) {
+    JSValueRef exception { nullptr };
+    JSObjectSetProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_key), static_cast<JSValueRef>(property_value), kJSPropertyAttributeNone, &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+  }
+  
+  void Local<JSObject>::SetProperty(const JSString& property_name, const Local<JSValue>& property_value) {
+    JSValueRef exception { nullptr };
+    JSObjectSetProperty(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, static_cast<JSStringRef>(property_name), static_cast<JSValueRef>(property_value), kJSPropertyAttributeNone, &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+  }
+  
+  void Local<JSObject>::SetProperty(unsigned property_index, const Local<JSValue>& property_value) {
+    JSValueRef exception { nullptr };
+    JSObjectSetPropertyAtIndex(static_cast<JSContextRef>(*handle_scope__), js_object_ref__, property_index, static_cast<JSValueRef>(property_value), &exception);
+    if (exception) {
+      detail::ThrowRuntimeError("Local<JSObject>", JSValue(handle_scope__ -> get_context(), exception));
+    }
+  }
+  
+  bool Local<JSObject>::IsFunction() const HAL_NOEXCEPT {
+    return JSObjectIsFunction(static_cast<JSContextRef>(*handle_scope__), js_object_ref__);
+  }
+  
+} // namespace HAL {
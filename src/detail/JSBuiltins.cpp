@@ -0,0 +1,333 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSBuiltins.hpp"
+#include "HAL/JSContext.hpp"
+
+#include <string>
+
+namespace HAL { namespace detail {
+
+  namespace {
+
+    // Return object[name] if it is an object, otherwise nullptr. The
+    // result is not protected.
+    JSObjectRef GetObjectProperty(JSContextRef js_context_ref, JSObjectRef js_object_ref, const char* name) HAL_NOEXCEPT {
+      if (!js_object_ref) {
+        return nullptr;
+      }
+
+      JSStringRef name_ref = JSStringCreateWithUTF8CString(name);
+      JSValueRef  exception { nullptr };
+      JSValueRef  js_value_ref = JSObjectGetProperty(js_context_ref, js_object_ref, name_ref, &exception);
+      JSStringRelease(name_ref);
+
+      if (exception || !js_value_ref || !JSValueIsObject(js_context_ref, js_value_ref)) {
+        return nullptr;
+      }
+
+      return JSValueToObject(js_context_ref, js_value_ref, nullptr);
+    }
+
+    // The name of the hidden object on the global object. It is
+    // created once and never released.
+    JSStringRef GetHolderName() {
+      static const JSStringRef holder_name = JSStringCreateWithUTF8CString("__HAL_builtins__");
+      return holder_name;
+    }
+
+    struct ArrayHelperSource {
+      const char* name;
+      const char* parameters;
+      const char* body;
+    };
+
+    // Indexed by JSBuiltins::ArrayHelper. The element assignments
+    // convert just like JSValue's conversion operators: a Float64Array
+    // applies ToNumber, an Int32Array or Uint32Array ToInt32 or
+    // ToUint32.
+    //
+    // String and Array in the bodies are the cached builtins that
+    // MakeArrayHelper binds them to, not the current globals.
+    const ArrayHelperSource array_helper_sources[] = {
+      { "copyElements"  , "t, a", "for (var i = 0, n = t.length; i < n; ++i) t[i] = a[i];" },
+      { "copyBooleans"  , "t, a", "for (var i = 0, n = t.length; i < n; ++i) t[i] = a[i] ? 1 : 0;" },
+      { "joinStrings"   , "l, a", "var n = l.length, s = new Array(n); for (var i = 0; i < n; ++i) { s[i] = String(a[i]); l[i] = s[i].length; } return s.join('');" },
+      { "fromTypedArray", "t"   , "var n = t.length, a = new Array(n); for (var i = 0; i < n; ++i) a[i] = t[i]; return a;" }
+    };
+
+    static_assert(sizeof(array_helper_sources) / sizeof(array_helper_sources[0]) == static_cast<std::size_t>(JSBuiltins::ArrayHelper::Count), "There must be one source for each ArrayHelper");
+
+    // Compile a function of String and Array that returns the helper,
+    // and call it once with the builtin constructors, so that the
+    // helper doesn't resolve them through the global object.
+    JSObjectRef MakeArrayHelper(JSContextRef js_context_ref, const ArrayHelperSource& source, JSObjectRef string_constructor_ref, JSObjectRef array_constructor_ref) HAL_NOEXCEPT {
+      if (!string_constructor_ref || !array_constructor_ref) {
+        return nullptr;
+      }
+
+      const std::string body = std::string("return function ") + source.name + "(" + source.parameters + ") { " + source.body + " };";
+      JSStringRef body_ref = JSStringCreateWithUTF8CString(body.c_str());
+      JSStringRef parameter_name_refs[2] { JSStringCreateWithUTF8CString("String"), JSStringCreateWithUTF8CString("Array") };
+
+      JSValueRef  exception { nullptr };
+      JSObjectRef factory_ref = JSObjectMakeFunction(js_context_ref, nullptr, 2, parameter_name_refs, body_ref, nullptr, 1, &exception);
+
+      JSStringRelease(parameter_name_refs[0]);
+      JSStringRelease(parameter_name_refs[1]);
+      JSStringRelease(body_ref);
+
+      if (exception || !factory_ref) {
+        return nullptr;
+      }
+
+      const JSValueRef arguments[] = { string_constructor_ref, array_constructor_ref };
+      JSValueRef result = JSObjectCallAsFunction(js_context_ref, factory_ref, nullptr, 2, arguments, &exception);
+      if (exception || !result || !JSValueIsObject(js_context_ref, result)) {
+        return nullptr;
+      }
+
+      return JSValueToObject(js_context_ref, result, nullptr);
+    }
+
+  } // namespace {
+
+#ifdef HAL_THREAD_SAFE
+  std::recursive_mutex JSBuiltins::mutex_static__;
+#endif
+
+  const JSBuiltins& JSBuiltins::Get(const JSContext& js_context) {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    const auto ctx           = static_cast<JSContextRef>(js_context);
+    const auto global_object = JSContextGetGlobalObject(ctx);
+    const auto holder        = JSObjectGetProperty(ctx, global_object, GetHolderName(), nullptr);
+    if (holder && JSValueIsObjectOfClass(ctx, holder, GetHolderClass())) {
+      return *static_cast<const JSBuiltins*>(JSObjectGetPrivate(JSValueToObject(ctx, holder, nullptr)));
+    }
+
+    // The hidden object owns the new JSBuiltins.
+    return *new JSBuiltins(ctx);
+  }
+
+  JSClassRef JSBuiltins::GetHolderClass() {
+    static JSClassRef holder_class = []() {
+      JSClassDefinition definition = kJSClassDefinitionEmpty;
+      definition.className = "HALBuiltins";
+      definition.finalize  = JSBuiltins::JSObjectFinalizeCallback;
+      return JSClassCreate(&definition);
+    }();
+    return holder_class;
+  }
+
+  void JSBuiltins::JSObjectFinalizeCallback(JSObjectRef object_ref) {
+    // The global context is being destroyed, so the destructor must
+    // not call into JavaScriptCore.
+    delete static_cast<JSBuiltins*>(JSObjectGetPrivate(object_ref));
+  }
+
+  JSBuiltins::JSBuiltins(JSContextRef js_global_context_ref)
+  : js_global_context_ref__(js_global_context_ref) {
+    const auto ctx = js_global_context_ref__;
+
+    // The global object lives as long as its context, and keeps the
+    // hidden object alive, which in turn keeps the builtins alive.
+    global_object__ = JSContextGetGlobalObject(ctx);
+    holder__        = JSObjectMake(ctx, GetHolderClass(), this);
+    JSObjectSetProperty(ctx, global_object__, GetHolderName(), holder__, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontEnum | kJSPropertyAttributeDontDelete, nullptr);
+
+    const auto keep = [this](JSObjectRef js_object_ref) {
+      if (js_object_ref) {
+        Keep(js_object_ref);
+      }
+      return js_object_ref;
+    };
+
+    object_constructor__   = keep(GetObjectProperty(ctx, global_object__, "Object"));
+    function_constructor__ = keep(GetObjectProperty(ctx, global_object__, "Function"));
+    array_constructor__    = keep(GetObjectProperty(ctx, global_object__, "Array"));
+    string_constructor__   = keep(GetObjectProperty(ctx, global_object__, "String"));
+    error_constructor__    = keep(GetObjectProperty(ctx, global_object__, "Error"));
+    date_constructor__     = keep(GetObjectProperty(ctx, global_object__, "Date"));
+    regexp_constructor__   = keep(GetObjectProperty(ctx, global_object__, "RegExp"));
+    promise_constructor__  = keep(GetObjectProperty(ctx, global_object__, "Promise"));
+    json_object__          = keep(GetObjectProperty(ctx, global_object__, "JSON"));
+
+    function_prototype__ = keep(GetObjectProperty(ctx, function_constructor__, "prototype"));
+    array_is_array__   = keep(GetObjectProperty(ctx, array_constructor__, "isArray"));
+    object_to_string__ = keep(GetObjectProperty(ctx, GetObjectProperty(ctx, object_constructor__, "prototype"), "toString"));
+    object_define_property__ = keep(GetObjectProperty(ctx, object_constructor__, "defineProperty"));
+
+    // WeakRef is only available in newer JavaScriptCore releases.
+    weak_ref_deref__ = keep(GetObjectProperty(ctx, GetObjectProperty(ctx, GetObjectProperty(ctx, global_object__, "WeakRef"), "prototype"), "deref"));
+    if (weak_ref_deref__) {
+      weak_ref_constructor__ = keep(GetObjectProperty(ctx, global_object__, "WeakRef"));
+    }
+  }
+
+  JSBuiltins::~JSBuiltins() HAL_NOEXCEPT {
+  }
+
+  unsigned JSBuiltins::Keep(JSObjectRef js_object_ref) const {
+    unsigned slot = slot_count__;
+    if (free_slots__.empty()) {
+      ++slot_count__;
+    } else {
+      slot = free_slots__.back();
+      free_slots__.pop_back();
+    }
+
+    JSObjectSetPropertyAtIndex(js_global_context_ref__, holder__, slot, js_object_ref, nullptr);
+    return slot;
+  }
+
+  void JSBuiltins::Drop(unsigned slot) const {
+    JSObjectSetPropertyAtIndex(js_global_context_ref__, holder__, slot, JSValueMakeUndefined(js_global_context_ref__), nullptr);
+    free_slots__.push_back(slot);
+  }
+
+  bool JSBuiltins::IsArray(JSObjectRef js_object_ref) const HAL_NOEXCEPT {
+    if (!array_is_array__) {
+      return false;
+    }
+
+    const auto ctx = js_global_context_ref__;
+    JSValueRef argument = js_object_ref;
+    JSValueRef exception { nullptr };
+    JSValueRef result = JSObjectCallAsFunction(ctx, array_is_array__, array_constructor__, 1, &argument, &exception);
+
+    return !exception && result && JSValueIsBoolean(ctx, result) && JSValueToBoolean(ctx, result);
+  }
+
+  bool JSBuiltins::IsError(JSObjectRef js_object_ref) const HAL_NOEXCEPT {
+    const auto ctx = js_global_context_ref__;
+    JSValueRef exception { nullptr };
+    if (error_constructor__ && JSValueIsInstanceOfConstructor(ctx, js_object_ref, error_constructor__, &exception) && !exception) {
+      return true;
+    }
+
+    // Errors from another global context aren't instances of this
+    // context's Error, but are still tagged as errors.
+    if (!object_to_string__) {
+      return false;
+    }
+
+    exception = nullptr;
+    JSValueRef tag = JSObjectCallAsFunction(ctx, object_to_string__, js_object_ref, 0, nullptr, &exception);
+    if (exception || !tag || !JSValueIsString(ctx, tag)) {
+      return false;
+    }
+
+    JSStringRef tag_ref = JSValueToStringCopy(ctx, tag, nullptr);
+    const bool  result  = tag_ref && JSStringIsEqualToUTF8CString(tag_ref, "[object Error]");
+    if (tag_ref) {
+      JSStringRelease(tag_ref);
+    }
+
+    return result;
+  }
+
+  bool JSBuiltins::DefineConstantProperty(JSObjectRef js_object_ref, JSStringRef property_name_ref, JSValueRef js_value_ref, bool enumerable) const HAL_NOEXCEPT {
+    if (!object_define_property__) {
+      return false;
+    }
+
+    const auto ctx = js_global_context_ref__;
+
+    // Properties that a descriptor leaves out default to false, so
+    // the property is neither writable nor configurable.
+    JSObjectRef descriptor_ref = JSObjectMake(ctx, nullptr, nullptr);
+    JSStringRef value_ref      = JSStringCreateWithUTF8CString("value");
+    JSStringRef enumerable_ref = JSStringCreateWithUTF8CString("enumerable");
+    JSObjectSetProperty(ctx, descriptor_ref, value_ref, js_value_ref, kJSPropertyAttributeNone, nullptr);
+    JSObjectSetProperty(ctx, descriptor_ref, enumerable_ref, JSValueMakeBoolean(ctx, enumerable), kJSPropertyAttributeNone, nullptr);
+    JSStringRelease(value_ref);
+    JSStringRelease(enumerable_ref);
+
+    const JSValueRef arguments[] = { js_object_ref, JSValueMakeString(ctx, property_name_ref), descriptor_ref };
+    JSValueRef exception { nullptr };
+    JSObjectCallAsFunction(ctx, object_define_property__, object_constructor__, 3, arguments, &exception);
+
+    return !exception;
+  }
+
+  bool JSBuiltins::MarkClassInitialized(JSClassRef js_class_ref) const {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    return initialized_classes__.insert(js_class_ref).second;
+  }
+
+  JSObjectRef JSBuiltins::FindWrapper(JSClassRef js_class_ref, const void* key) const {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    const auto position = wrappers__.find(WrapperKey_t(js_class_ref, key));
+    if (position == wrappers__.end()) {
+      return nullptr;
+    }
+
+    const auto& wrapper = position->second;
+    if (!wrapper.weak) {
+      return wrapper.js_object_ref;
+    }
+
+    // deref returns undefined once the object has been garbage
+    // collected, and the entry is of no further use.
+    const auto ctx = js_global_context_ref__;
+    JSValueRef exception { nullptr };
+    JSValueRef result = JSObjectCallAsFunction(ctx, weak_ref_deref__, wrapper.js_object_ref, 0, nullptr, &exception);
+    if (!exception && result && JSValueIsObject(ctx, result)) {
+      return JSValueToObject(ctx, result, nullptr);
+    }
+
+    Drop(wrapper.slot);
+    wrappers__.erase(position);
+    return nullptr;
+  }
+
+  void JSBuiltins::SetWrapper(JSClassRef js_class_ref, const void* key, JSObjectRef js_object_ref) const {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    Wrapper wrapper { js_object_ref, 0, false };
+    if (weak_ref_constructor__) {
+      JSValueRef  argument = js_object_ref;
+      JSValueRef  exception { nullptr };
+      JSObjectRef weak_ref = JSObjectCallAsConstructor(js_global_context_ref__, weak_ref_constructor__, 1, &argument, &exception);
+      if (!exception && weak_ref) {
+        wrapper.js_object_ref = weak_ref;
+        wrapper.weak          = true;
+      }
+    }
+
+    wrapper.slot = Keep(wrapper.js_object_ref);
+    const auto result = wrappers__.emplace(WrapperKey_t(js_class_ref, key), wrapper);
+    if (!result.second) {
+      Drop(result.first->second.slot);
+      result.first->second = wrapper;
+    }
+  }
+
+  void JSBuiltins::ForgetWrapper(JSClassRef js_class_ref, const void* key) const {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    const auto position = wrappers__.find(WrapperKey_t(js_class_ref, key));
+    if (position != wrappers__.end()) {
+      Drop(position->second.slot);
+      wrappers__.erase(position);
+    }
+  }
+
+  JSObjectRef JSBuiltins::GetArrayHelper(ArrayHelper helper) const HAL_NOEXCEPT {
+    HAL_DETAIL_JSBUILTINS_LOCK_GUARD_STATIC;
+    const auto index = static_cast<std::size_t>(helper);
+    auto& array_helper = array_helpers__[index];
+    if (!array_helper) {
+      array_helper = MakeArrayHelper(js_global_context_ref__, array_helper_sources[index], string_constructor__, array_constructor__);
+      if (array_helper) {
+        Keep(array_helper);
+      }
+    }
+
+    return array_helper;
+  }
+
+}} // namespace HAL { namespace detail {
@@ -0,0 +1,81 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSExportClassInfo.hpp"
+
+namespace HAL { namespace detail {
+
+  // Class id 0 means that a class has no JSClass yet.
+  std::uint32_t JSExportClassInfo::next_id__ { 1 };
+  std::unordered_map<JSClassRef, const JSExportClassInfo*> JSExportClassInfo::js_class_registry__;
+#ifdef HAL_THREAD_SAFE
+  std::recursive_mutex JSExportClassInfo::mutex_static__;
+#endif
+
+  JSExportClassInfo::JSExportClassInfo(Destructor_t destructor, JSClassRef js_class_ref, JSClassRef parent_js_class_ref, bool js_export_object)
+  : destructor__(destructor)
+  , parent__(nullptr)
+  , js_class_ref__(js_class_ref)
+  , js_export_object__(js_export_object) {
+    HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC;
+    id__ = next_id__++;
+
+    if (parent_js_class_ref) {
+      const auto position = js_class_registry__.find(parent_js_class_ref);
+      if (position != js_class_registry__.end()) {
+        parent__ = position->second;
+      }
+    }
+
+    if (js_class_ref__) {
+      js_class_registry__[js_class_ref__] = this;
+    }
+  }
+
+  JSExportClassInfo::~JSExportClassInfo() HAL_NOEXCEPT {
+    HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC;
+    if (js_class_ref__) {
+      const auto position = js_class_registry__.find(js_class_ref__);
+      if (position != js_class_registry__.end() && position->second == this) {
+        js_class_registry__.erase(position);
+      }
+    }
+  }
+
+  bool JSExportClassInfo::IsJSExportObject(JSContextRef context_ref, JSObjectRef object_ref, JSClassRef hint_js_class_ref) HAL_NOEXCEPT {
+    if (hint_js_class_ref && JSValueIsObjectOfClass(context_ref, object_ref, hint_js_class_ref)) {
+      return true;
+    }
+
+    HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC;
+    for (const auto& entry : js_class_registry__) {
+      if (entry.first != hint_js_class_ref && JSValueIsObjectOfClass(context_ref, object_ref, entry.first)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  const JSExportClassInfo* JSExportClassInfo::FindClassInfo(const void* native_object_ptr) HAL_NOEXCEPT {
+    const auto class_info = native_object_ptr ? JSExportPool::GetRecordedClassInfo(native_object_ptr) : nullptr;
+    if (!class_info) {
+      return nullptr;
+    }
+
+    HAL_DETAIL_JSEXPORTCLASSINFO_LOCK_GUARD_STATIC;
+    for (const auto& entry : js_class_registry__) {
+      if (entry.second == class_info) {
+        return class_info;
+      }
+    }
+
+    return nullptr;
+  }
+
+}} // namespace HAL { namespace detail {
@@ -0,0 +1,223 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSExportPool.hpp"
+#include "HAL/detail/JSExportClassInfo.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+#include <new>
+
+namespace HAL { namespace detail {
+
+  namespace {
+
+    const std::size_t alignment = alignof(std::max_align_t);
+
+    std::size_t RoundUp(std::size_t size) HAL_NOEXCEPT {
+      return (size + alignment - 1) & ~(alignment - 1);
+    }
+
+  } // namespace {
+
+  // A slab's slots follow it in the same allocation. The object
+  // storage of a free slot holds the next free slot.
+  struct JSExportPool::Slab {
+    JSExportPool* pool;
+    Slab*         previous;
+    Slab*         next;
+    Header*       free_slots;
+    std::size_t   slots_in_use;
+  };
+
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+  std::atomic<long> JSExportPool::total_slots_in_use__;
+  std::atomic<long> JSExportPool::total_slab_count__;
+#endif
+
+  JSExportPool::JSExportPool(std::size_t object_size, std::size_t object_alignment)
+  : slot_size__(GetHeaderSize() + RoundUp(object_size < sizeof(Header*) ? sizeof(Header*) : object_size)) {
+    if (object_alignment > alignment) {
+      ThrowInvalidArgument("JSExportPool", "objects can't be aligned to more than std::max_align_t");
+    }
+  }
+
+  JSExportPool::~JSExportPool() HAL_NOEXCEPT {
+    // precondition
+    assert(slots_in_use__ == 0);
+
+    while (available_slabs__) {
+      Slab* slab = available_slabs__;
+      UnlinkAvailable(slab);
+      ::operator delete(slab);
+      --slab_count__;
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+      --total_slab_count__;
+#endif
+    }
+  }
+
+  JSExportPool::Header* JSExportPool::GetHeader(void* object) HAL_NOEXCEPT {
+    return reinterpret_cast<Header*>(static_cast<char*>(object) - GetHeaderSize());
+  }
+
+  void* JSExportPool::Allocate(const JSExportClassInfo& class_info) {
+    HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD;
+    Slab* slab = available_slabs__ ? available_slabs__ : CreateSlab();
+
+    Header* header   = slab->free_slots;
+    void*   object   = reinterpret_cast<char*>(header) + GetHeaderSize();
+    slab->free_slots = *static_cast<Header**>(object);
+
+    if (slab->slots_in_use++ == 0) {
+      --empty_slab_count__;
+    }
+
+    if (!slab->free_slots) {
+      UnlinkAvailable(slab);
+    }
+
+    ++slots_in_use__;
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+    ++total_slots_in_use__;
+#endif
+
+    header->slab       = slab;
+    header->class_info = &class_info;
+    return object;
+  }
+
+  void* JSExportPool::AllocateUnpooled(std::size_t object_size, const JSExportClassInfo& class_info) {
+    auto header = static_cast<Header*>(::operator new(GetHeaderSize() + object_size));
+    header->slab       = nullptr;
+    header->class_info = &class_info;
+    return reinterpret_cast<char*>(header) + GetHeaderSize();
+  }
+
+  void JSExportPool::Destroy(void* object) HAL_NOEXCEPT {
+    GetHeader(object)->class_info->get_destructor()(object);
+    Deallocate(object);
+  }
+
+  void JSExportPool::Deallocate(void* object) HAL_NOEXCEPT {
+    Header* header = GetHeader(object);
+
+    // A released slot has no class info, so that
+    // JSExportClassInfo::FindClassInfo doesn't find one for a stale
+    // pointer to it.
+    header->class_info = nullptr;
+    if (header->slab) {
+      header->slab->pool->Release(header);
+    } else {
+      ::operator delete(header);
+    }
+  }
+
+  void JSExportPool::Release(Header* header) HAL_NOEXCEPT {
+    HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD;
+    Slab* slab = header->slab;
+    void* object = reinterpret_cast<char*>(header) + GetHeaderSize();
+    *static_cast<Header**>(object) = slab->free_slots;
+
+    const bool was_full = !slab->free_slots;
+    slab->free_slots = header;
+
+    if (was_full) {
+      LinkAvailable(slab);
+    }
+
+    --slots_in_use__;
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+    --total_slots_in_use__;
+#endif
+
+    // Keep one empty slab so that a pool which repeatedly creates and
+    // finalizes a few objects doesn't allocate a slab each time.
+    if (--slab->slots_in_use == 0) {
+      if (empty_slab_count__ > 0) {
+        UnlinkAvailable(slab);
+        ::operator delete(slab);
+        --slab_count__;
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+        --total_slab_count__;
+#endif
+      } else {
+        ++empty_slab_count__;
+      }
+    }
+  }
+
+  JSExportPool::Slab* JSExportPool::CreateSlab() {
+    const std::size_t slab_header_size = RoundUp(sizeof(Slab));
+    auto  slab    = static_cast<Slab*>(::operator new(slab_header_size + slot_size__ * HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT));
+    char* storage = reinterpret_cast<char*>(slab) + slab_header_size;
+
+    slab->pool         = this;
+    slab->previous     = nullptr;
+    slab->next         = nullptr;
+    slab->free_slots   = nullptr;
+    slab->slots_in_use = 0;
+
+    // Thread the free list through the slots in address order.
+    for (std::size_t i = HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT; i > 0; --i) {
+      auto header = reinterpret_cast<Header*>(storage + slot_size__ * (i - 1));
+      header->slab = slab;
+      *reinterpret_cast<Header**>(reinterpret_cast<char*>(header) + GetHeaderSize()) = slab->free_slots;
+      slab->free_slots = header;
+    }
+
+    LinkAvailable(slab);
+    ++empty_slab_count__;
+    ++slab_count__;
+#ifdef HAL_PERFORMANCE_COUNTER_ENABLE
+    ++total_slab_count__;
+#endif
+
+    return slab;
+  }
+
+  void JSExportPool::LinkAvailable(Slab* slab) HAL_NOEXCEPT {
+    slab->previous = nullptr;
+    slab->next     = available_slabs__;
+    if (available_slabs__) {
+      available_slabs__->previous = slab;
+    }
+    available_slabs__ = slab;
+  }
+
+  void JSExportPool::UnlinkAvailable(Slab* slab) HAL_NOEXCEPT {
+    if (slab->previous) {
+      slab->previous->next = slab->next;
+    } else {
+      available_slabs__ = slab->next;
+    }
+
+    if (slab->next) {
+      slab->next->previous = slab->previous;
+    }
+
+    slab->previous = nullptr;
+    slab->next     = nullptr;
+  }
+
+  std::size_t JSExportPool::get_slots_in_use() const HAL_NOEXCEPT {
+    HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD;
+    return slots_in_use__;
+  }
+
+  std::size_t JSExportPool::get_slab_count() const HAL_NOEXCEPT {
+    HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD;
+    return slab_count__;
+  }
+
+  std::size_t JSExportPool::get_slot_count() const HAL_NOEXCEPT {
+    HAL_DETAIL_JSEXPORTPOOL_LOCK_GUARD;
+    return slab_count__ * HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT;
+  }
+
+}} // namespace HAL { namespace detail {
@@ -0,0 +1,144 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSHandleRegistry.hpp"
+
+#include <cassert>
+#include <cstdint>
+
+namespace HAL { namespace detail {
+
+  namespace {
+
+    // The table never holds more than half as many handles as it has
+    // cells, which keeps linear probe sequences short.
+    const std::size_t kInitialCapacity = 64;
+
+  } // namespace {
+
+  JSHandleRegistry::JSHandleRegistry() HAL_NOEXCEPT {
+  }
+
+  JSHandleRegistry::~JSHandleRegistry() HAL_NOEXCEPT {
+    delete [] cells__;
+    cells__ = nullptr;
+    mask__  = 0;
+    size__  = 0;
+  }
+
+  std::size_t JSHandleRegistry::Hash(const void* handle) const HAL_NOEXCEPT {
+    // Handles to cells are aligned heap pointers, but handles to
+    // numbers, booleans, null and undefined are tagged immediates that
+    // may differ only in their high bits (doubles) or low bits
+    // (integers). Fold the high half into the low half so that every
+    // bit counts, then spread the result with a Fibonacci multiplier.
+    auto value = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(handle));
+    value ^= value >> 32;
+    return static_cast<std::size_t>((value * 0x9E3779B97F4A7C15ull) >> 32) & mask__;
+  }
+
+  std::size_t JSHandleRegistry::Find(const void* handle) const HAL_NOEXCEPT {
+    std::size_t index = Hash(handle);
+    while (cells__[index].handle && cells__[index].handle != handle) {
+      index = (index + 1) & mask__;
+    }
+    return index;
+  }
+
+  void JSHandleRegistry::Grow() {
+    Cell* const       old_cells    = cells__;
+    const std::size_t old_capacity = capacity();
+    const std::size_t new_capacity = old_capacity ? old_capacity * 2 : kInitialCapacity;
+
+    cells__ = new Cell[new_capacity]();
+    mask__  = new_capacity - 1;
+
+    for (std::size_t i = 0; i < old_capacity; ++i) {
+      if (old_cells[i].handle) {
+        cells__[Find(old_cells[i].handle)] = old_cells[i];
+      }
+    }
+
+    delete [] old_cells;
+  }
+
+  std::size_t JSHandleRegistry::Retain(const void* handle, const void* context) {
+    assert(handle);
+    if ((size__ + 1) * 2 > capacity()) {
+      Grow();
+    }
+
+    Cell& cell = cells__[Find(handle)];
+    if (!cell.handle) {
+      cell.handle  = handle;
+      cell.context = context;
+      ++size__;
+    }
+
+    return ++cell.count;
+  }
+
+  bool JSHandleRegistry::Release(const void* handle, std::size_t& count, const void*& context) HAL_NOEXCEPT {
+    if (size__ == 0) {
+      return false;
+    }
+
+    std::size_t index = Find(handle);
+    Cell& cell = cells__[index];
+    if (!cell.handle) {
+      return false;
+    }
+
+    count   = --cell.count;
+    context = cell.context;
+    if (count > 0) {
+      return true;
+    }
+
+    // Backward-shift deletion: pull later members of the probe
+    // sequence into the hole so that lookups never need tombstones.
+    --size__;
+    std::size_t next = index;
+    while (true) {
+      cells__[index] = Cell();
+      while (true) {
+        next = (next + 1) & mask__;
+        if (!cells__[next].handle) {
+          return true;
+        }
+
+        // Move the cell at next into the hole at index unless its
+        // home slot lies cyclically in (index, next].
+        const std::size_t home = Hash(cells__[next].handle);
+        if (index <= next ? (index < home && home <= next) : (index < home || home <= next)) {
+          continue;
+        }
+
+        break;
+      }
+
+      cells__[index] = cells__[next];
+      index = next;
+    }
+  }
+
+  const void* JSHandleRegistry::FindContext(const void* handle) const HAL_NOEXCEPT {
+    if (size__ == 0) {
+      return nullptr;
+    }
+    return cells__[Find(handle)].context;
+  }
+
+  std::size_t JSHandleRegistry::GetCount(const void* handle) const HAL_NOEXCEPT {
+    if (size__ == 0) {
+      return 0;
+    }
+    return cells__[Find(handle)].count;
+  }
+
+}} // namespace HAL { namespace detail {
@@ -0,0 +1,118 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSPropertyNameTable.hpp"
+#include "HAL/detail/JSTranscoder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace HAL { namespace detail {
+
+  const std::size_t JSPropertyNameTable::npos;
+
+  JSPropertyNameTable::JSPropertyNameTable() HAL_NOEXCEPT {
+  }
+
+  JSPropertyNameTable::JSPropertyNameTable(const std::vector<std::string>& names) {
+    if (names.empty()) {
+      return;
+    }
+
+    // Keep the table at most half full.
+    std::size_t bucket_count = 8;
+    while (bucket_count < 2 * names.size()) {
+      bucket_count *= 2;
+    }
+    buckets__.assign(bucket_count, 0);
+    mask__ = bucket_count - 1;
+    entries__.reserve(names.size());
+
+    for (const auto& name : names) {
+      // Make a JSStringRef of the name just like JSString does, and
+      // read it back with JSStringGetUTF8CString just like Find does,
+      // so that the bytes are exactly those Find gets for it.
+      JSStringRef name_ref = JSStringCreateWithUTF8(name.data(), name.size());
+      const std::size_t length = JSStringGetLength(name_ref);
+      std::vector<char> bytes(JSStringGetMaximumUTF8CStringSize(name_ref));
+      const std::size_t size = JSStringGetUTF8CString(name_ref, &bytes[0], bytes.size());
+      JSStringRelease(name_ref);
+
+      Entry entry;
+      entry.hash   = Hash(&bytes[0], size ? size - 1 : 0);
+      entry.offset = static_cast<std::uint32_t>(bytes__.size());
+      entry.size   = static_cast<std::uint32_t>(size ? size - 1 : 0);
+      entry.length = static_cast<std::uint32_t>(length);
+      bytes__.insert(bytes__.end(), bytes.begin(), bytes.begin() + entry.size);
+      max_length__ = std::max(max_length__, length);
+
+      std::size_t bucket = entry.hash & mask__;
+      while (buckets__[bucket] != 0) {
+        bucket = (bucket + 1) & mask__;
+      }
+
+      entries__.push_back(entry);
+      buckets__[bucket] = static_cast<std::uint32_t>(entries__.size());
+    }
+  }
+
+  std::size_t JSPropertyNameTable::Find(JSStringRef name_ref) const HAL_NOEXCEPT {
+    const std::size_t length = JSStringGetLength(name_ref);
+    if (entries__.empty() || length > max_length__) {
+      return npos;
+    }
+
+    // A UTF-16 code unit takes at most 3 bytes of UTF-8.
+    char stack_buffer[256];
+    std::vector<char> heap_buffer;
+    char* bytes = stack_buffer;
+    const std::size_t capacity = 3 * length + 1;
+    if (capacity > sizeof(stack_buffer)) {
+      heap_buffer.resize(capacity);
+      bytes = &heap_buffer[0];
+    }
+
+    // JavaScriptCore returns 0 if the name isn't valid UTF-16.
+    const std::size_t size = JSStringGetUTF8CString(name_ref, bytes, capacity);
+    if (size == 0) {
+      return npos;
+    }
+
+    const std::uint32_t hash = Hash(bytes, size - 1);
+    for (std::size_t bucket = hash & mask__; buckets__[bucket] != 0; bucket = (bucket + 1) & mask__) {
+      const std::size_t index = buckets__[bucket] - 1;
+      const Entry&      entry = entries__[index];
+      if (entry.hash == hash && entry.length == length && entry.size == size - 1 && std::memcmp(&bytes__[entry.offset], bytes, entry.size) == 0) {
+        return index;
+      }
+    }
+
+    return npos;
+  }
+
+  void JSPropertyNameTable::swap(JSPropertyNameTable& other) HAL_NOEXCEPT {
+    using std::swap;
+    swap(bytes__     , other.bytes__);
+    swap(entries__   , other.entries__);
+    swap(buckets__   , other.buckets__);
+    swap(mask__      , other.mask__);
+    swap(max_length__, other.max_length__);
+  }
+
+  // FNV-1a over the UTF-8 bytes.
+  std::uint32_t JSPropertyNameTable::Hash(const char* bytes, std::size_t size) HAL_NOEXCEPT {
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < size; ++i) {
+      hash ^= static_cast<unsigned char>(bytes[i]);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+}} // namespace HAL { namespace detail {
@@ -0,0 +1,395 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/detail/JSTranscoder.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAL_TRANSCODER_SSE2_ENABLE
+#include <emmintrin.h>
+#endif
+
+#if defined(HAL_TRANSCODER_SSE2_ENABLE) && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HAL_TRANSCODER_AVX2_ENABLE
+#include <immintrin.h>
+#endif
+
+namespace HAL { namespace detail {
+  
+  namespace {
+    
+    // Widen the longest prefix of ASCII bytes in source into
+    // destination and return its length.
+    typedef std::size_t (*WidenASCII_t)(const char* source, std::size_t length, char16_t* destination);
+    
+    // Narrow the longest prefix of ASCII code units in source into
+    // destination and return its length.
+    typedef std::size_t (*NarrowASCII_t)(const char16_t* source, std::size_t length, char* destination);
+    
+    // Copy the longest prefix of non-NUL ASCII bytes in source into
+    // destination and return its length.
+    typedef std::size_t (*CopyASCII_t)(const char* source, std::size_t length, char* destination);
+    
+    std::size_t WidenASCIIScalar(const char* source, std::size_t length, char16_t* destination) {
+      std::size_t i = 0;
+      while (i < length && static_cast<unsigned char>(source[i]) < 0x80) {
+        destination[i] = static_cast<char16_t>(source[i]);
+        ++i;
+      }
+      return i;
+    }
+    
+    std::size_t NarrowASCIIScalar(const char16_t* source, std::size_t length, char* destination) {
+      std::size_t i = 0;
+      while (i < length && source[i] < 0x80) {
+        destination[i] = static_cast<char>(source[i]);
+        ++i;
+      }
+      return i;
+    }
+    
+    std::size_t CopyASCIIScalar(const char* source, std::size_t length, char* destination) {
+      std::size_t i = 0;
+      while (i < length && source[i] != 0 && static_cast<unsigned char>(source[i]) < 0x80) {
+        destination[i] = source[i];
+        ++i;
+      }
+      return i;
+    }
+    
+#ifdef HAL_TRANSCODER_SSE2_ENABLE
+    std::size_t WidenASCIISSE2(const char* source, std::size_t length, char16_t* destination) {
+      const __m128i zero = _mm_setzero_si128();
+      std::size_t i = 0;
+      for (; i + 16 <= length; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+          break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i    ), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i + 8), _mm_unpackhi_epi8(bytes, zero));
+      }
+      return i + WidenASCIIScalar(source + i, length - i, destination + i);
+    }
+    
+    std::size_t NarrowASCIISSE2(const char16_t* source, std::size_t length, char* destination) {
+      const __m128i zero      = _mm_setzero_si128();
+      const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+      std::size_t i = 0;
+      for (; i + 16 <= length; i += 16) {
+        const __m128i low  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i    ));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i + 8));
+        const __m128i bits = _mm_and_si128(_mm_or_si128(low, high), non_ascii);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(bits, zero)) != 0xFFFF) {
+          break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), _mm_packus_epi16(low, high));
+      }
+      return i + NarrowASCIIScalar(source + i, length - i, destination + i);
+    }
+    
+    std::size_t CopyASCIISSE2(const char* source, std::size_t length, char* destination) {
+      const __m128i zero = _mm_setzero_si128();
+      std::size_t i = 0;
+      for (; i + 16 <= length; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if ((_mm_movemask_epi8(bytes) | _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero))) != 0) {
+          break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), bytes);
+      }
+      return i + CopyASCIIScalar(source + i, length - i, destination + i);
+    }
+#endif
+    
+#ifdef HAL_TRANSCODER_AVX2_ENABLE
+    __attribute__((target("avx2")))
+    std::size_t WidenASCIIAVX2(const char* source, std::size_t length, char16_t* destination) {
+      std::size_t i = 0;
+      for (; i + 32 <= length; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        if (_mm256_movemask_epi8(bytes) != 0) {
+          break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i     ), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+      }
+      return i + WidenASCIISSE2(source + i, length - i, destination + i);
+    }
+    
+    __attribute__((target("avx2")))
+    std::size_t NarrowASCIIAVX2(const char16_t* source, std::size_t length, char* destination) {
+      const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0xFF80));
+      std::size_t i = 0;
+      for (; i + 32 <= length; i += 32) {
+        const __m256i low  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i     ));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i + 16));
+        if (!_mm256_testz_si256(_mm256_or_si256(low, high), non_ascii)) {
+          break;
+        }
+        // _mm256_packus_epi16 packs within 128-bit lanes, so restore
+        // the order of the 64-bit quarters afterwards.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), packed);
+      }
+      return i + NarrowASCIISSE2(source + i, length - i, destination + i);
+    }
+    
+    __attribute__((target("avx2")))
+    std::size_t CopyASCIIAVX2(const char* source, std::size_t length, char* destination) {
+      const __m256i zero = _mm256_setzero_si256();
+      std::size_t i = 0;
+      for (; i + 32 <= length; i += 32) {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i));
+        if ((_mm256_movemask_epi8(bytes) | _mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero))) != 0) {
+          break;
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i), bytes);
+      }
+      return i + CopyASCIISSE2(source + i, length - i, destination + i);
+    }
+#endif
+    
+    struct Transcoder {
+      Transcoder() HAL_NOEXCEPT {
+#ifdef HAL_TRANSCODER_AVX2_ENABLE
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+          name         = "avx2";
+          widen_ascii  = WidenASCIIAVX2;
+          narrow_ascii = NarrowASCIIAVX2;
+          copy_ascii   = CopyASCIIAVX2;
+          return;
+        }
+#endif
+#ifdef HAL_TRANSCODER_SSE2_ENABLE
+        name         = "sse2";
+        widen_ascii  = WidenASCIISSE2;
+        narrow_ascii = NarrowASCIISSE2;
+        copy_ascii   = CopyASCIISSE2;
+#endif
+      }
+      
+      const char*   name         { "scalar" };
+      WidenASCII_t  widen_ascii  { WidenASCIIScalar };
+      NarrowASCII_t narrow_ascii { NarrowASCIIScalar };
+      CopyASCII_t   copy_ascii   { CopyASCIIScalar };
+    };
+    
+    const Transcoder& GetTranscoder() HAL_NOEXCEPT {
+      static const Transcoder transcoder;
+      return transcoder;
+    }
+    
+    inline bool IsContinuationByte(unsigned char byte) {
+      return (byte & 0xC0) == 0x80;
+    }
+    
+  } // namespace {
+  
+  const char* GetTranscoderName() HAL_NOEXCEPT {
+    return GetTranscoder().name;
+  }
+  
+  bool UTF8ToUTF16(const char* source, std::size_t length, char16_t* destination, std::size_t& destination_length) HAL_NOEXCEPT {
+    const auto widen_ascii = GetTranscoder().widen_ascii;
+    const auto bytes       = reinterpret_cast<const unsigned char*>(source);
+    
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < length) {
+      const auto ascii_length = widen_ascii(source + i, length - i, destination + j);
+      i += ascii_length;
+      j += ascii_length;
+      
+      // Decode multi-byte sequences until the next ASCII byte.
+      while (i < length && bytes[i] >= 0x80) {
+        const unsigned char lead = bytes[i];
+        std::uint32_t code_point = 0;
+        std::size_t   sequence_length = 0;
+        std::uint32_t minimum = 0;
+        if ((lead & 0xE0) == 0xC0) {
+          code_point = lead & 0x1F; sequence_length = 2; minimum = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+          code_point = lead & 0x0F; sequence_length = 3; minimum = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+          code_point = lead & 0x07; sequence_length = 4; minimum = 0x10000;
+        } else {
+          return false;
+        }
+        
+        if (length - i < sequence_length) {
+          return false;
+        }
+        
+        for (std::size_t k = 1; k < sequence_length; ++k) {
+          if (!IsContinuationByte(bytes[i + k])) {
+            return false;
+          }
+          code_point = (code_point << 6) | (bytes[i + k] & 0x3F);
+        }
+        
+        // Reject overlong encodings, surrogates and code points
+        // beyond U+10FFFF.
+        if (code_point < minimum || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+          return false;
+        }
+        
+        if (code_point >= 0x10000) {
+          code_point -= 0x10000;
+          destination[j++] = static_cast<char16_t>(0xD800 + (code_point >> 10));
+          destination[j++] = static_cast<char16_t>(0xDC00 + (code_point & 0x3FF));
+        } else {
+          destination[j++] = static_cast<char16_t>(code_point);
+        }
+        
+        i += sequence_length;
+      }
+    }
+    
+    destination_length = j;
+    return true;
+  }
+  
+  std::size_t UTF16ToUTF8(const char16_t* source, std::size_t length, char* destination) HAL_NOEXCEPT {
+    const auto narrow_ascii = GetTranscoder().narrow_ascii;
+    
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < length) {
+      const auto ascii_length = narrow_ascii(source + i, length - i, destination + j);
+      i += ascii_length;
+      j += ascii_length;
+      
+      // Encode code points until the next ASCII code unit.
+      while (i < length && source[i] >= 0x80) {
+        std::uint32_t code_point = source[i++];
+        if (code_point >= 0xD800 && code_point <= 0xDBFF && i < length && source[i] >= 0xDC00 && source[i] <= 0xDFFF) {
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) + (source[i++] - 0xDC00);
+        } else if (code_point >= 0xD800 && code_point <= 0xDFFF) {
+          code_point = 0xFFFD;
+        }
+        
+        if (code_point < 0x800) {
+          destination[j++] = static_cast<char>(0xC0 | (code_point >> 6));
+          destination[j++] = static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+          destination[j++] = static_cast<char>(0xE0 | (code_point >> 12));
+          destination[j++] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+          destination[j++] = static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+          destination[j++] = static_cast<char>(0xF0 | (code_point >> 18));
+          destination[j++] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+          destination[j++] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+          destination[j++] = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+      }
+    }
+    
+    return j;
+  }
+  
+  JSStringRef JSStringCreateWithUTF8(const char* source, std::size_t length) HAL_NOEXCEPT {
+    // Short strings, such as property names, are copied or transcoded
+    // on the stack.
+    static const std::size_t stack_buffer_length = 256;
+    
+    // ASCII and Latin-1 without embedded NULs, which almost every
+    // string is, go through JSStringCreateWithUTF8CString, so that
+    // JavaScriptCore can keep them as 8-bit strings. That takes a
+    // NUL-terminated copy, which is made while checking the input.
+    {
+      char stack_buffer[stack_buffer_length];
+      std::vector<char> heap_buffer;
+      
+      char* buffer = stack_buffer;
+      if (length >= stack_buffer_length) {
+        heap_buffer.resize(length + 1);
+        buffer = &heap_buffer[0];
+      }
+      
+      const auto copy_ascii = GetTranscoder().copy_ascii;
+      const auto bytes      = reinterpret_cast<const unsigned char*>(source);
+      std::size_t i = 0;
+      while (true) {
+        i += copy_ascii(source + i, length - i, buffer + i);
+        
+        // Latin-1 characters beyond ASCII are two bytes in UTF-8, with
+        // a lead byte of 0xC2 or 0xC3.
+        if (i + 1 < length && (bytes[i] == 0xC2 || bytes[i] == 0xC3) && IsContinuationByte(bytes[i + 1])) {
+          buffer[i]     = source[i];
+          buffer[i + 1] = source[i + 1];
+          i += 2;
+        } else {
+          break;
+        }
+      }
+      
+      if (i == length) {
+        buffer[length] = '\0';
+        return JSStringCreateWithUTF8CString(buffer);
+      }
+    }
+    
+    // Anything else is transcoded to UTF-16 here, which also keeps
+    // embedded NULs.
+    char16_t stack_buffer[stack_buffer_length];
+    std::vector<char16_t> heap_buffer;
+    
+    char16_t* buffer = stack_buffer;
+    if (length > stack_buffer_length) {
+      heap_buffer.resize(length);
+      buffer = &heap_buffer[0];
+    }
+    
+    std::size_t buffer_length = 0;
+    if (!UTF8ToUTF16(source, length, buffer, buffer_length)) {
+      buffer_length = 0;
+    }
+    
+    return JSStringCreateWithCharacters(reinterpret_cast<const JSChar*>(buffer), buffer_length);
+  }
+  
+  std::string JSStringToUTF8(JSStringRef js_string_ref) HAL_NOEXCEPT {
+    static_assert(sizeof(JSChar) == sizeof(char16_t), "JSChar must be a UTF-16 code unit");
+    const std::size_t length = JSStringGetLength(js_string_ref);
+    if (length == 0) {
+      return std::string();
+    }
+    
+    // JSStringGetUTF8CString reads 8-bit strings as they are, whereas
+    // JSStringGetCharactersPtr would upconvert them to UTF-16 and keep
+    // the copy for the lifetime of the string.
+    static const std::size_t stack_buffer_size = 1024;
+    char stack_buffer[stack_buffer_size];
+    std::vector<char> heap_buffer;
+    
+    const std::size_t maximum_size = JSStringGetMaximumUTF8CStringSize(js_string_ref);
+    char* buffer = stack_buffer;
+    if (maximum_size > stack_buffer_size) {
+      heap_buffer.resize(maximum_size);
+      buffer = &heap_buffer[0];
+    }
+    
+    const std::size_t size = JSStringGetUTF8CString(js_string_ref, buffer, maximum_size);
+    if (size > 0) {
+      return std::string(buffer, size - 1);
+    }
+    
+    // JavaScriptCore fails on unpaired surrogates, which only a 16-bit
+    // string can contain, so reading its characters copies nothing.
+    // Transcode it here instead, replacing them with U+FFFD.
+    const auto characters = reinterpret_cast<const char16_t*>(JSStringGetCharactersPtr(js_string_ref));
+    std::string string(3 * length, '\0');
+    string.resize(UTF16ToUTF8(characters, length, &string[0]));
+    return string;
+  }
+  
+}} // namespace HAL { namespace detail {
@@ -14,9 +14,11 @@
 #include "HAL/JSNumber.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <stdexcept>
 #include <iterator>
+#include <vector>
 
 #include <JavaScriptCore/JavaScript.h>
 
@@ -235,6 +237,64 @@ namespace HAL { namespace detail {
     return to_string(FromJSClassAttributes(attributes));
   }
   
+  bool ToArrayIndex(JSStringRef property_name_ref, std::uint32_t& index) HAL_NOEXCEPT {
+    // 4294967294 has 10 digits.
+    const std::size_t length = JSStringGetLength(property_name_ref);
+    if (length == 0 || length > 10) {
+      return false;
+    }
+    
+    // A digit is a single UTF-8 byte, so any other character makes
+    // the UTF-8 form longer than length or stops the conversion.
+    char characters[3 * 10 + 1];
+    const std::size_t size = JSStringGetUTF8CString(property_name_ref, characters, sizeof(characters));
+    if (size != length + 1) {
+      return false;
+    }
+    
+    if (characters[0] == '0') {
+      index = 0;
+      return length == 1;
+    }
+    
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+      const char character = characters[i];
+      if (character < '0' || character > '9') {
+        return false;
+      }
+      value = value * 10 + (character - '0');
+    }
+    
+    if (value >= 0xFFFFFFFFu) {
+      return false;
+    }
+    
+    index = static_cast<std::uint32_t>(value);
+    return true;
+  }
+  
+  bool IsPropertyName(JSStringRef property_name_ref, const char* ascii_name) HAL_NOEXCEPT {
+    const std::size_t length = std::strlen(ascii_name);
+    if (JSStringGetLength(property_name_ref) != length) {
+      return false;
+    }
+    
+    // Equal names have exactly length bytes of UTF-8. A name with any
+    // other character doesn't fit in length bytes, so the conversion
+    // stops short.
+    char stack_buffer[64];
+    std::vector<char> heap_buffer;
+    char* characters = stack_buffer;
+    if (length + 1 > sizeof(stack_buffer)) {
+      heap_buffer.resize(length + 1);
+      characters = &heap_buffer[0];
+    }
+    
+    const std::size_t size = JSStringGetUTF8CString(property_name_ref, characters, length + 1);
+    return size == length + 1 && std::memcmp(characters, ascii_name, length) == 0;
+  }
+  
   // The bitwise_cast and to_int32_t code was copied from
   // WebKit/Source/WTF/wtf/StdLibExtras.h and came with these terms and
   // conditions:
@@ -10,7 +10,10 @@
 #include "Widget.hpp"
 #include "ChildWidget.hpp"
 #include "OtherWidget.hpp"
+#include "ListWidget.hpp"
 #include <functional>
+#include <cmath>
+#include <algorithm>
 
 #include "gtest/gtest.h"
 
@@ -236,6 +239,57 @@ TEST_F(JSExportTests, JSExportGetPrivate) {
   XCTAssertEqual(nullptr, wrong_widget_ptr2);
 }
 
+TEST_F(JSExportTests, JSExportClassId) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+
+  JSObject widget       = js_context.CreateObject(JSExport<Widget>::Class());
+  JSObject child_widget = js_context.CreateObject(JSExport<ChildWidget>::Class());
+  JSObject other_widget = js_context.CreateObject(JSExport<OtherWidget>::Class());
+  global_object.SetProperty("widget"      , widget);
+  global_object.SetProperty("child_widget", child_widget);
+  global_object.SetProperty("other_widget", other_widget);
+  global_object.SetProperty("Widget"      , js_context.CreateObject(JSExport<Widget>::Class()));
+
+  const auto widget_id       = detail::JSExportClassId<Widget>::value;
+  const auto child_widget_id = detail::JSExportClassId<ChildWidget>::value;
+  const auto other_widget_id = detail::JSExportClassId<OtherWidget>::value;
+  XCTAssertNotEqual(0, widget_id);
+  XCTAssertNotEqual(0, child_widget_id);
+  XCTAssertNotEqual(widget_id, child_widget_id);
+  XCTAssertNotEqual(widget_id, other_widget_id);
+
+  // ChildWidget's parent chain set by SetParent includes Widget.
+  const auto& child_class_info = detail::JSExportPool::GetClassInfo(JSObjectGetPrivate(static_cast<JSObjectRef>(child_widget)));
+  XCTAssertEqual(child_widget_id, child_class_info.get_id());
+  XCTAssertTrue(child_class_info.IsA(child_widget_id));
+  XCTAssertTrue(child_class_info.IsA(widget_id));
+  XCTAssertFalse(child_class_info.IsA(other_widget_id));
+
+  // GetPrivatePointer doesn't share ownership, but finds the same
+  // native object as GetPrivate.
+  XCTAssertEqual(widget.GetPrivate<Widget>().get(), widget.GetPrivatePointer<Widget>());
+  XCTAssertEqual(child_widget.GetPrivate<ChildWidget>().get(), child_widget.GetPrivatePointer<ChildWidget>());
+  XCTAssertEqual(static_cast<Widget*>(child_widget.GetPrivatePointer<ChildWidget>()), child_widget.GetPrivatePointer<Widget>());
+  XCTAssertEqual(nullptr, child_widget.GetPrivatePointer<OtherWidget>());
+  XCTAssertEqual(nullptr, other_widget.GetPrivatePointer<Widget>());
+  XCTAssertEqual(nullptr, js_context.CreateObject().GetPrivatePointer<Widget>());
+  XCTAssertNotEqual(nullptr, other_widget.GetPrivatePointer<JSExportObject>());
+
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("widget instanceof Widget;")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("child_widget instanceof Widget;")));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("other_widget instanceof Widget;")));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("({}) instanceof Widget;")));
+
+  // A function created from a native callback has private data that
+  // isn't a native object of an exported class.
+  JSFunction native_function = js_context.CreateFunction([](int32_t value) { return value; });
+  js_context.get_global_object().SetProperty("native_function", native_function);
+  XCTAssertEqual(nullptr, native_function.GetPrivatePointer<Widget>());
+  XCTAssertEqual(nullptr, native_function.GetPrivatePointer<JSExportObject>());
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("native_function instanceof Widget;")));
+}
+
 TEST_F(JSExportTests, JSExportConstructorCount) {
   JSContext js_context = js_context_group.CreateContext();
   JSObject global_object = js_context.get_global_object();
@@ -299,6 +353,51 @@ TEST_F(JSExportTests, CallAsFunction) {
   XCTAssertEqual("Hello, bar. Your number is 42.", static_cast<std::string>(hello));
 }
 
+/*
+ * Call a named function whose callback takes a JSArguments view
+ */
+TEST_F(JSExportTests, CallNamedFunctionWithJSArguments) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object   = js_context.get_global_object();
+  
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  global_object.SetProperty("Widget", widget);
+  
+  XCTAssertTrue(widget.HasProperty("addNumbers"));
+  XCTAssertEqual(0, static_cast<double>(js_context.JSEvaluateScript("Widget.addNumbers();")));
+  XCTAssertEqual(6, static_cast<double>(js_context.JSEvaluateScript("Widget.addNumbers(1, 2, 3);")));
+  XCTAssertEqual(3.5, static_cast<double>(js_context.JSEvaluateScript("Widget.addNumbers('1.5', true, 1);")));
+  XCTAssertTrue(std::isnan(static_cast<double>(js_context.JSEvaluateScript("Widget.addNumbers(1, undefined);"))));
+}
+
+/*
+ * Call named functions bound to member functions at compile-time
+ */
+TEST_F(JSExportTests, CallBoundFunction) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object   = js_context.get_global_object();
+  
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  global_object.SetProperty("Widget", widget);
+  
+  XCTAssertTrue(widget.HasProperty("add"));
+  XCTAssertEqual(3.5, static_cast<double>(js_context.JSEvaluateScript("Widget.add(1, 2.5);")));
+  
+  // The first argument is converted with ToInt32, and missing
+  // arguments are undefined.
+  XCTAssertEqual(3.5, static_cast<double>(js_context.JSEvaluateScript("Widget.add(1.9, '2.5');")));
+  XCTAssertEqual(-1, static_cast<double>(js_context.JSEvaluateScript("Widget.add(4294967295, 0);")));
+  XCTAssertTrue(std::isnan(static_cast<double>(js_context.JSEvaluateScript("Widget.add(1);"))));
+  
+  auto widget_ptr = widget.GetPrivate<Widget>();
+  XCTAssertNotEqual(nullptr, widget_ptr.get());
+  widget_ptr -> set_name("bar");
+  XCTAssertEqual("Hello, bar.", static_cast<std::string>(js_context.JSEvaluateScript("Widget.greet('Hello');")));
+  
+  // Calling a bound function on an object that isn't a Widget throws.
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("try { Widget.add.call({}, 1, 2); false; } catch (e) { true; }")));
+}
+
 /*
  * Call new Widget('baz', 999).sayHello() through operator()
  */
@@ -878,6 +977,89 @@ TEST_F(JSExportTests, EvaluateMultipleNewWidget) {
   XCTAssertEqual("Hello, foo. Your number is 456.", static_cast<std::string>(test3));
   XCTAssertEqual("Hello, bar. Your number is 234.", static_cast<std::string>(test4));
 }
+
+/*
+ * Named functions dispatch by slot, so a function keeps working when
+ * it is called through a different name.
+ */
+TEST_F(JSExportTests, NamedFunctionDispatch) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+  
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  global_object.SetProperty("Widget", widget);
+  
+  JSValue result = js_context.JSEvaluateScript("var greet = Widget.sayHello; greet.call(Widget);");
+  XCTAssertTrue(result.IsString());
+  XCTAssertEqual("Hello, world. Your number is 42.", static_cast<std::string>(result));
+  
+  result = js_context.JSEvaluateScript("Widget.testMemberNumberProperty();");
+  XCTAssertTrue(result.IsNumber());
+  XCTAssertEqual(123, static_cast<std::int32_t>(result));
+}
+
+/*
+ * Callbacks find their native object from the JSObjectRef they are
+ * called with, and calling a named function on an object that isn't
+ * a Widget throws instead of using a null native object.
+ */
+TEST_F(JSExportTests, CallbackNativeObject) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  global_object.SetProperty("Widget", widget);
+
+  XCTAssertEqual(42, static_cast<std::int32_t>(js_context.JSEvaluateScript("Widget.number = 7; Widget.number * 6;")));
+  XCTAssertEqual(7, widget.GetPrivate<Widget>()->get_number());
+  XCTAssertEqual("bar", static_cast<std::string>(js_context.JSEvaluateScript("Widget.name = 'bar'; Widget.name;")));
+  XCTAssertEqual("Hello, bar. Your number is 7.", static_cast<std::string>(js_context.JSEvaluateScript("Widget.sayHello();")));
+
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("try { Widget.sayHello.call({}); false; } catch (e) { e instanceof Error; }")));
+}
+
+/*
+ * Value properties are found by their JavaScriptCore name, without
+ * creating a JSString or a std::string.
+ */
+TEST_F(JSExportTests, JSPropertyNameTable) {
+  detail::JSPropertyNameTable empty_table;
+  XCTAssertTrue(empty_table.empty());
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, empty_table.Find(static_cast<JSStringRef>(JSString("name"))));
+  
+  detail::JSPropertyNameTable table({"name", "number", "pi", "caf\xC3\xA9"});
+  XCTAssertEqual(4, table.size());
+  XCTAssertEqual(0, table.Find(static_cast<JSStringRef>(JSString("name"))));
+  XCTAssertEqual(1, table.Find(static_cast<JSStringRef>(JSString("number"))));
+  XCTAssertEqual(2, table.Find(static_cast<JSStringRef>(JSString("pi"))));
+  XCTAssertEqual(3, table.Find(static_cast<JSStringRef>(JSString("caf\xC3\xA9"))));
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, table.Find(static_cast<JSStringRef>(JSString("nam"))));
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, table.Find(static_cast<JSStringRef>(JSString("names"))));
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, table.Find(static_cast<JSStringRef>(JSString(""))));
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, table.Find(static_cast<JSStringRef>(JSString("a much longer name"))));
+  
+  // JavaScriptCore stores ASCII and Latin-1 names as 8-bit strings,
+  // unlike the UTF-16 strings created by JSString.
+  const auto find_8bit = [&table](const char* name) {
+    JSStringRef name_ref = JSStringCreateWithUTF8CString(name);
+    const std::size_t index = table.Find(name_ref);
+    JSStringRelease(name_ref);
+    return index;
+  };
+  XCTAssertEqual(1, find_8bit("number"));
+  XCTAssertEqual(3, find_8bit("caf\xC3\xA9"));
+  XCTAssertEqual(detail::JSPropertyNameTable::npos, find_8bit("caf\xC3\xA8"));
+  
+  // Copies of the class definition rebuild the table, and the
+  // properties still reach their own callbacks.
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  js_context.get_global_object().SetProperty("Widget", widget);
+  XCTAssertEqual("world", static_cast<std::string>(js_context.JSEvaluateScript("Widget.name;")));
+  XCTAssertEqual(42, static_cast<std::int32_t>(js_context.JSEvaluateScript("Widget.number;")));
+  XCTAssertEqual(43, static_cast<std::int32_t>(js_context.JSEvaluateScript("Widget.number = 43; Widget.number;")));
+}
+
 /*
  * Call function with callback on Widget
  */
@@ -1242,6 +1424,119 @@ TEST_F(JSExportTests, JSExportFindObjectFromPrivateDataGetObject) {
 
 }
 
+TEST_F(JSExportTests, JSExportObjectGetObject) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+
+  JSObject widget = js_context.CreateObject(JSExport<Widget>::Class());
+  global_object.SetProperty("Widget", widget);
+  JSObject js_widget = static_cast<JSObject>(js_context.JSEvaluateScript("new Widget('foo', 123);"));
+  global_object.SetProperty("widget", js_widget);
+
+  // Each native object points back to its own JavaScript object.
+  global_object.SetProperty("jsobject", widget.GetPrivatePointer<Widget>()->get_object());
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("Widget === jsobject;")));
+  global_object.SetProperty("jsobject", js_widget.GetPrivatePointer<Widget>()->get_object());
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("widget === jsobject;")));
+
+  // A copy of a native object isn't the private data of any
+  // JavaScript object.
+  Widget widget_copy(*widget.GetPrivatePointer<Widget>());
+  XCTAssertTrue(widget_copy.get_object().IsError());
+  XCTAssertTrue(JSObject::FindJSObjectFromPrivateData(js_context, nullptr).IsError());
+  XCTAssertTrue(JSObject::FindJSObjectFromPrivateData(js_context, &widget_copy).IsError());
+
+  // Nor is the private data of a function created from a native
+  // callback.
+  JSFunction native_function = js_context.CreateFunction([](int32_t value) { return value; });
+  void* function_private_data = JSObjectGetPrivate(static_cast<JSObjectRef>(native_function));
+  XCTAssertTrue(function_private_data != nullptr);
+  XCTAssertTrue(JSObject::FindJSObjectFromPrivateData(js_context, function_private_data).IsError());
+}
+
+TEST_F(JSExportTests, WrapExisting) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+
+  int model = 0;
+  int other_model = 0;
+  int initialize_count = 0;
+  const auto initialize = [&initialize_count](Widget& widget) {
+    ++initialize_count;
+    widget.set_number(13);
+  };
+
+  // The same native key gives back the same JavaScript object, which
+  // is only initialized once.
+  global_object.SetProperty("first", JSExport<Widget>::WrapExisting(js_context, &model, initialize));
+  global_object.SetProperty("second", JSExport<Widget>::WrapExisting(js_context, &model, initialize));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("first === second;")));
+  XCTAssertEqual(1, initialize_count);
+  XCTAssertEqual(13, static_cast<int32_t>(js_context.JSEvaluateScript("first.number;")));
+
+  // A different key gives a different JavaScript object.
+  global_object.SetProperty("other", JSExport<Widget>::WrapExisting(js_context, &other_model, initialize));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("first === other;")));
+  XCTAssertEqual(2, initialize_count);
+
+  // Each JSContext has its own JavaScript object for a key.
+  JSContext other_context = js_context_group.CreateContext();
+  JSObject wrapper = JSExport<Widget>::WrapExisting(other_context, &model, initialize);
+  XCTAssertEqual(3, initialize_count);
+  JSObject first = static_cast<JSObject>(global_object.GetProperty("first"));
+  XCTAssertNotEqual(first.GetPrivatePointer<Widget>(), wrapper.GetPrivatePointer<Widget>());
+
+  // After ForgetWrapper the key gives a new JavaScript object, while
+  // the other keys and contexts keep theirs.
+  JSExport<Widget>::ForgetWrapper(js_context, &model);
+  global_object.SetProperty("third", JSExport<Widget>::WrapExisting(js_context, &model, initialize));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("first === third;")));
+  XCTAssertEqual(4, initialize_count);
+  global_object.SetProperty("other_again", JSExport<Widget>::WrapExisting(js_context, &other_model, initialize));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("other === other_again;")));
+  XCTAssertEqual(static_cast<JSObjectRef>(wrapper), static_cast<JSObjectRef>(JSExport<Widget>::WrapExisting(other_context, &model, initialize)));
+  XCTAssertEqual(4, initialize_count);
+
+  // Forgetting a key that has no JavaScript object does nothing.
+  JSExport<Widget>::ForgetWrapper(js_context, &initialize_count);
+}
+
+TEST_F(JSExportTests, IndexedProperty) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject global_object = js_context.get_global_object();
+
+  JSObject list = js_context.CreateObject(JSExport<ListWidget>::Class());
+  list.GetPrivatePointer<ListWidget>()->get_rows() = { 10, 20, 30 };
+  global_object.SetProperty("list", list);
+
+  XCTAssertEqual(3, static_cast<int32_t>(js_context.JSEvaluateScript("list.length;")));
+  XCTAssertEqual(10, static_cast<int32_t>(js_context.JSEvaluateScript("list[0];")));
+  XCTAssertEqual(30, static_cast<int32_t>(js_context.JSEvaluateScript("list[2];")));
+  XCTAssertEqual(20, static_cast<int32_t>(js_context.JSEvaluateScript("list['1'];")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("1 in list;")));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("3 in list;")));
+
+  // Names that aren't canonical array indexes are ordinary properties.
+  XCTAssertTrue(js_context.JSEvaluateScript("list[3];").IsUndefined());
+  XCTAssertTrue(js_context.JSEvaluateScript("list['01'];").IsUndefined());
+  XCTAssertTrue(js_context.JSEvaluateScript("list[-1];").IsUndefined());
+  XCTAssertTrue(js_context.JSEvaluateScript("list['4294967295'];").IsUndefined());
+
+  // Set replaces and appends rows.
+  js_context.JSEvaluateScript("list[1] = 21; list[3] = 40;");
+  const std::vector<std::int32_t> expected { 10, 21, 30, 40 };
+  XCTAssertEqual(expected, list.GetPrivatePointer<ListWidget>()->get_rows());
+  XCTAssertEqual(4, static_cast<int32_t>(js_context.JSEvaluateScript("list.length;")));
+
+  // The length can't be set.
+  js_context.JSEvaluateScript("list.length = 0;");
+  XCTAssertEqual(4, static_cast<int32_t>(js_context.JSEvaluateScript("list.length;")));
+
+  // A for...in loop visits the rows.
+  XCTAssertEqual(std::string("0,1,2,3"), static_cast<std::string>(js_context.JSEvaluateScript("var names = []; for (var name in list) { names.push(name); } names.join();")));
+  XCTAssertEqual(101, static_cast<int32_t>(js_context.JSEvaluateScript("var sum = 0; for (var i = 0; i < list.length; ++i) { sum += list[i]; } sum;")));
+}
+
 TEST_F(JSExportTests, JSExportPostConstruct) {
   JSContext js_context = js_context_group.CreateContext();
   JSObject global_object = js_context.get_global_object();
@@ -1423,3 +1718,156 @@ TEST_F(JSExportTests, LRUCache) {
   XCTAssertTrue(keys.empty());
 }
 
+
+namespace {
+  
+  // Installs its constants on its prototype, and counts how often
+  // they are evaluated.
+  class PrototypeConstantWidget : public JSExportObject, public JSExport<PrototypeConstantWidget> {
+    
+  public:
+    
+    static std::uint32_t evaluation_count;
+    
+    PrototypeConstantWidget(const JSContext& js_context) HAL_NOEXCEPT
+    : JSExportObject(js_context) {
+    }
+    
+    static void JSExportInitialize() {
+      JSExport<PrototypeConstantWidget>::SetClassVersion(1);
+      JSExport<PrototypeConstantWidget>::SetParent(JSExport<JSExportObject>::Class());
+      JSExport<PrototypeConstantWidget>::SetConstantsOnPrototype(true);
+      JSExport<PrototypeConstantWidget>::AddConstantProperty("ANSWER", [](PrototypeConstantWidget& widget) { ++evaluation_count; return widget.get_context().CreateNumber(42); });
+      JSExport<PrototypeConstantWidget>::AddConstantProperty("HIDDEN", [](PrototypeConstantWidget& widget) { ++evaluation_count; return widget.get_context().CreateString("hidden"); }, false);
+    }
+  };
+  
+  std::uint32_t PrototypeConstantWidget::evaluation_count = 0;
+  
+} // namespace {
+
+TEST_F(JSExportTests, ConstantsOnPrototype) {
+  auto js_context    = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  PrototypeConstantWidget::evaluation_count = 0;
+  global_object.SetProperty("a", js_context.CreateObject(JSExport<PrototypeConstantWidget>::Class()));
+  global_object.SetProperty("b", js_context.CreateObject(JSExport<PrototypeConstantWidget>::Class()));
+  XCTAssertEqual(2, PrototypeConstantWidget::evaluation_count);
+  
+  auto result = js_context.JSEvaluateScript("var sum = 0; for (var i = 0; i < 100; ++i) { sum += a.ANSWER + b.ANSWER; } sum;");
+  XCTAssertEqual(8400, static_cast<std::int32_t>(result));
+  XCTAssertEqual(2, PrototypeConstantWidget::evaluation_count);
+  
+  // The constants are shared data properties of the prototype.
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("a.hasOwnProperty('ANSWER');")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("Object.getPrototypeOf(a).hasOwnProperty('ANSWER');")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("var d = Object.getOwnPropertyDescriptor(Object.getPrototypeOf(a), 'ANSWER'); !d.writable && !d.configurable && d.enumerable;")));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("Object.getOwnPropertyDescriptor(Object.getPrototypeOf(a), 'HIDDEN').enumerable;")));
+  XCTAssertEqual("hidden", static_cast<std::string>(js_context.JSEvaluateScript("b.HIDDEN;")));
+  
+  // They are read-only and can't be deleted.
+  result = js_context.JSEvaluateScript("a.ANSWER = 0; delete Object.getPrototypeOf(a).ANSWER; a.ANSWER;");
+  XCTAssertEqual(42, static_cast<std::int32_t>(result));
+  
+  // They are not cached, since they are no longer read through a
+  // callback.
+  XCTAssertTrue(detail::JSExportClass<PrototypeConstantWidget>::GetCachedKeys().empty());
+  
+  // Each context gets its own.
+  auto other_js_context = js_context_group.CreateContext();
+  other_js_context.get_global_object().SetProperty("c", other_js_context.CreateObject(JSExport<PrototypeConstantWidget>::Class()));
+  XCTAssertEqual(3, PrototypeConstantWidget::evaluation_count);
+  XCTAssertEqual(42, static_cast<std::int32_t>(other_js_context.JSEvaluateScript("c.ANSWER;")));
+}
+
+TEST_F(JSExportTests, JSExportPool) {
+  static std::uint32_t destroyed_count;
+  destroyed_count = 0;
+  detail::JSExportClassInfo class_info([](void*) { ++destroyed_count; });
+  detail::JSExportPool pool(sizeof(double), std::alignment_of<double>::value);
+  XCTAssertEqual(0, pool.get_slab_count());
+  
+  std::vector<void*> objects;
+  for (std::size_t i = 0; i < 2 * HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT + 1; ++i) {
+    objects.push_back(new (pool.Allocate(class_info)) double(static_cast<double>(i)));
+  }
+  XCTAssertEqual(objects.size(), pool.get_slots_in_use());
+  XCTAssertEqual(&class_info, &detail::JSExportPool::GetClassInfo(objects.back()));
+  XCTAssertEqual(3, pool.get_slab_count());
+  XCTAssertEqual(3 * HAL_JSEXPORT_POOL_SLAB_SLOT_COUNT, pool.get_slot_count());
+  
+  // The slots don't overlap.
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    XCTAssertEqual(static_cast<double>(i), *static_cast<double*>(objects.at(i)));
+  }
+  
+  // Empty slabs are released, except for one.
+  for (const auto object : objects) {
+    detail::JSExportPool::Destroy(object);
+  }
+  XCTAssertEqual(objects.size(), destroyed_count);
+  XCTAssertEqual(0, pool.get_slots_in_use());
+  XCTAssertEqual(1, pool.get_slab_count());
+  
+  // Freed slots are reused.
+  void* object = pool.Allocate(class_info);
+  XCTAssertEqual(1, pool.get_slab_count());
+  detail::JSExportPool::Deallocate(object);
+  XCTAssertEqual(objects.size(), destroyed_count);
+  
+  // Unpooled objects can be destroyed the same way.
+  object = detail::JSExportPool::AllocateUnpooled(sizeof(double), class_info);
+  detail::JSExportPool::Destroy(object);
+  XCTAssertEqual(objects.size() + 1, destroyed_count);
+}
+
+namespace {
+  
+  class PooledWidget : public JSExportObject, public JSExport<PooledWidget> {
+    
+  public:
+    
+    PooledWidget(const JSContext& js_context) HAL_NOEXCEPT
+    : JSExportObject(js_context) {
+    }
+    
+    static void JSExportInitialize() {
+      JSExport<PooledWidget>::SetClassVersion(1);
+      JSExport<PooledWidget>::SetParent(JSExport<JSExportObject>::Class());
+      JSExport<PooledWidget>::SetPooledAllocation(true);
+      JSExport<PooledWidget>::AddValueProperty("value", [](PooledWidget& widget) { return widget.get_context().CreateNumber(widget.value__); }, [](PooledWidget& widget, const JSValue& value) { widget.value__ = static_cast<double>(value); return true; });
+    }
+    
+  private:
+    
+    double value__ { 0 };
+  };
+  
+} // namespace {
+
+TEST_F(JSExportTests, PooledAllocation) {
+  const auto& pool = detail::JSExportClass<PooledWidget>::GetPool();
+  const auto  slots_in_use = pool.get_slots_in_use();
+  const auto  slab_count   = pool.get_slab_count();
+  
+  {
+    JSContextGroup js_context_group;
+    auto js_context = js_context_group.CreateContext();
+    auto js_array   = js_context.CreateArray();
+    for (std::uint32_t i = 0; i < 100; ++i) {
+      auto widget = js_context.CreateObject(JSExport<PooledWidget>::Class());
+      widget.SetProperty("value", js_context.CreateNumber(i));
+      js_array.SetProperty(i, widget);
+    }
+    js_context.get_global_object().SetProperty("widgets", js_array);
+    
+    XCTAssertEqual(slots_in_use + 100, pool.get_slots_in_use());
+    XCTAssertEqual(4950, static_cast<std::int32_t>(js_context.JSEvaluateScript("widgets.reduce(function(sum, widget) { return sum + widget.value; }, 0);")));
+  }
+  
+  // Tearing down the context group finalizes its objects, which
+  // returns their slots and the slabs holding them.
+  XCTAssertEqual(slots_in_use, pool.get_slots_in_use());
+  XCTAssertTrue(pool.get_slab_count() <= std::max<std::size_t>(slab_count, 1));
+}
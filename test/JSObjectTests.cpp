@@ -7,6 +7,11 @@
  */
 
 #include "HAL/HAL.hpp"
+#include "HAL/detail/JSBuiltins.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
 
 #include "gtest/gtest.h"
 
@@ -185,6 +190,57 @@ TEST_F(JSObjectTests, API) {
   XCTAssertFalse(js_object.IsError());
 }
 
+TEST_F(JSObjectTests, Builtins) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  // The builtins are cached per global context and shared by its
+  // copies.
+  const auto& builtins = detail::JSBuiltins::Get(js_context);
+  {
+    JSContext js_context_copy = js_context;
+    XCTAssertEqual(&builtins, &detail::JSBuiltins::Get(js_context_copy));
+  }
+  XCTAssertEqual(static_cast<JSObjectRef>(js_context.get_global_object()), builtins.get_global_object());
+
+  // They live as long as the global context, even when no JSContext
+  // refers to it for a while.
+  const detail::JSBuiltins* other_builtins { nullptr };
+  JSGlobalContextRef other_js_global_context_ref { nullptr };
+  {
+    JSContext other_js_context = js_context_group.CreateContext();
+    other_builtins = &detail::JSBuiltins::Get(other_js_context);
+    other_js_global_context_ref = JSGlobalContextRetain(JSContextGetGlobalContext(static_cast<JSContextRef>(other_js_context)));
+  }
+  XCTAssertEqual(other_builtins, &detail::JSBuiltins::Get(JSContext(other_js_global_context_ref)));
+  JSGlobalContextRelease(other_js_global_context_ref);
+
+  // The hidden object that keeps them alive isn't enumerable.
+  XCTAssertEqual(0, static_cast<int32_t>(js_context.JSEvaluateScript("Object.keys(this).length;")));
+  XCTAssertTrue(builtins.get_array_constructor()  != nullptr);
+  XCTAssertTrue(builtins.get_error_constructor()  != nullptr);
+  XCTAssertTrue(builtins.get_object_constructor() != nullptr);
+  XCTAssertTrue(builtins.get_json_object()        != nullptr);
+
+  auto js_array = static_cast<JSObject>(js_context.JSEvaluateScript("[1, 2, 3]"));
+  auto js_error = static_cast<JSObject>(js_context.JSEvaluateScript("new TypeError('oops')"));
+
+  // Type checks use the original builtins even after the script
+  // replaces them.
+  js_context.JSEvaluateScript("Array = null; Error = null;");
+  XCTAssertTrue(js_array.IsArray());
+  XCTAssertFalse(js_array.IsError());
+  XCTAssertFalse(js_error.IsArray());
+  XCTAssertTrue(js_error.IsError());
+
+  // An error from another context is not an instance of this
+  // context's Error, but is still an error.
+  JSContext other_js_context = js_context_group.CreateContext();
+  auto other_js_error = static_cast<JSObject>(other_js_context.JSEvaluateScript("new Error('elsewhere')"));
+  js_context.get_global_object().SetProperty("other_error", other_js_error);
+  auto js_other_error = static_cast<JSObject>(js_context.JSEvaluateScript("other_error"));
+  XCTAssertTrue(js_other_error.IsError());
+}
+
 TEST_F(JSObjectTests, Property) {
   JSContext js_context = js_context_group.CreateContext();
   auto js_value  = js_context.JSEvaluateScript("[1, 3, 5, 7]");
@@ -292,6 +348,29 @@ TEST_F(JSObjectTests, JSArray) {
   XCTAssertFalse(js_array.IsError());
 }
 
+TEST_F(JSObjectTests, JSPropertyKey) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject js_object = js_context.CreateObject();
+  
+  // Property keys with the same name are interned to the same atom.
+  const JSPropertyKey foo_key("foo");
+  XCTAssertEqual(foo_key, JSPropertyKey(std::string("foo")));
+  XCTAssertEqual(JSPropertyKey::Length(), JSPropertyKey("length"));
+  XCTAssertNotEqual(foo_key, JSPropertyKey::Length());
+  XCTAssertEqual("foo", static_cast<std::string>(foo_key));
+  
+  XCTAssertFalse(js_object.HasProperty(foo_key));
+  js_object.SetProperty(foo_key, js_context.CreateNumber(42));
+  XCTAssertTrue(js_object.HasProperty(foo_key));
+  XCTAssertTrue(js_object.HasProperty("foo"));
+  XCTAssertEqual(42, static_cast<std::int32_t>(js_object.GetProperty(foo_key)));
+  XCTAssertTrue(js_object.DeleteProperty(foo_key));
+  XCTAssertFalse(js_object.HasProperty(foo_key));
+  
+  JSArray js_array = js_context.CreateArray({ js_context.CreateNumber(1), js_context.CreateNumber(2) });
+  XCTAssertEqual(2, static_cast<std::uint32_t>(js_array.GetProperty(JSPropertyKey::Length())));
+}
+
 TEST_F(JSObjectTests, GetProperties) {
   JSContext js_context = js_context_group.CreateContext();
 
@@ -372,6 +451,25 @@ TEST_F(JSObjectTests, StringVectorFromJSArray) {
   XCTAssertEqual("Hello 3", items.at(2));
 }
 
+TEST_F(JSObjectTests, ArrayConversionsUseBuiltins) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSArray js_array = js_context.CreateArray({ js_context.CreateString("Hello"), js_context.CreateNumber(42) });
+  XCTAssertTrue(js_array.IsArray());
+
+  // The conversions use the original String and Array even after the
+  // script replaces them.
+  js_context.JSEvaluateScript("String = function() { return 'replaced'; }; Array = function() { return {}; };");
+  auto items = static_cast<std::vector<std::string>>(js_array);
+  XCTAssertEqual(2, items.size());
+  XCTAssertEqual("Hello", items.at(0));
+  XCTAssertEqual("42", items.at(1));
+
+  JSArray js_number_array = js_context.CreateArray(std::vector<double> { 1.5, 2.5 });
+  XCTAssertTrue(js_number_array.IsArray());
+  XCTAssertEqual(2, js_number_array.GetLength());
+  XCTAssertEqual(2.5, static_cast<double>(js_number_array.GetProperty(1)));
+}
+
 TEST_F(JSObjectTests, BoolVectorFromJSArray) {
   JSContext js_context = js_context_group.CreateContext();
 
@@ -462,6 +560,210 @@ TEST_F(JSObjectTests, UIntVectorFromJSArray) {
   XCTAssertEqual(123, items.at(1));
 }
 
+TEST_F(JSObjectTests, BulkVectorFromJSArray) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  JSArray js_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("[1.5, '2', true, null, undefined, -1, 4294967297, , 'h\\u00e9llo \\ud83d\\ude00', '']")));
+  XCTAssertEqual(10, js_array.GetLength());
+
+  const auto doubles = static_cast<std::vector<double>>(js_array);
+  XCTAssertEqual(10, doubles.size());
+  XCTAssertEqual(1.5, doubles.at(0));
+  XCTAssertEqual(2, doubles.at(1));
+  XCTAssertEqual(1, doubles.at(2));
+  XCTAssertEqual(0, doubles.at(3));
+  XCTAssertTrue(std::isnan(doubles.at(4)));
+  XCTAssertTrue(std::isnan(doubles.at(7)));
+  XCTAssertEqual(0, doubles.at(9));
+
+  const auto ints = static_cast<std::vector<std::int32_t>>(js_array);
+  XCTAssertEqual(10, ints.size());
+  XCTAssertEqual(1, ints.at(0));
+  XCTAssertEqual(-1, ints.at(5));
+  XCTAssertEqual(1, ints.at(6));
+
+  const auto uints = static_cast<std::vector<std::uint32_t>>(js_array);
+  XCTAssertEqual(10, uints.size());
+  XCTAssertEqual(4294967295u, uints.at(5));
+
+  const auto bools = static_cast<std::vector<bool>>(js_array);
+  XCTAssertEqual(10, bools.size());
+  XCTAssertTrue(bools.at(0));
+  XCTAssertFalse(bools.at(3));
+  XCTAssertFalse(bools.at(7));
+  XCTAssertTrue(bools.at(8));
+  XCTAssertFalse(bools.at(9));
+
+  const auto strings = static_cast<std::vector<std::string>>(js_array);
+  XCTAssertEqual(10, strings.size());
+  XCTAssertEqual("1.5", strings.at(0));
+  XCTAssertEqual("true", strings.at(2));
+  XCTAssertEqual("null", strings.at(3));
+  XCTAssertEqual("undefined", strings.at(4));
+  XCTAssertEqual("undefined", strings.at(7));
+  XCTAssertEqual("h\xc3\xa9llo \xf0\x9f\x98\x80", strings.at(8));
+  XCTAssertEqual("", strings.at(9));
+
+  // Conversions that throw in JavaScript still throw.
+  JSArray throwing_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("[{ valueOf: function() { throw new Error('valueOf'); } }]")));
+  ASSERT_THROW(static_cast<std::vector<double>>(throwing_array), std::runtime_error);
+}
+
+TEST_F(JSObjectTests, CreateArrayFromDoubles) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  std::vector<double> values(1000);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i * 0.5;
+  }
+
+  JSArray js_array = js_context.CreateArray(values);
+  XCTAssertTrue(js_array.IsArray());
+  XCTAssertEqual(1000, js_array.GetLength());
+  XCTAssertEqual(2.5, static_cast<double>(js_array.GetProperty(5)));
+  XCTAssertTrue(values == static_cast<std::vector<double>>(js_array));
+
+  js_context.get_global_object().SetProperty("values", js_array);
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("Array.isArray(values) && !ArrayBuffer.isView(values) && values[999] === 499.5")));
+
+  JSArray empty_array = js_context.CreateArray(values.data(), 0);
+  XCTAssertTrue(empty_array.IsArray());
+  XCTAssertEqual(0, empty_array.GetLength());
+}
+
+TEST_F(JSObjectTests, JSArrayBuffer) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  JSArrayBuffer js_array_buffer = js_context.CreateArrayBuffer(16);
+  XCTAssertTrue(JSArrayBuffer::IsArrayBuffer(js_array_buffer));
+  XCTAssertEqual(16, js_array_buffer.GetByteLength());
+
+  auto bytes = js_array_buffer.GetBytes();
+  XCTAssertEqual(16, bytes.size());
+  for (const auto byte : bytes) {
+    XCTAssertEqual(0, byte);
+  }
+
+  bytes[3] = 42;
+  js_context.get_global_object().SetProperty("buffer", js_array_buffer);
+  XCTAssertEqual(42, static_cast<int32_t>(js_context.JSEvaluateScript("new Uint8Array(buffer)[3]")));
+  js_context.JSEvaluateScript("new Uint8Array(buffer)[4] = 7;");
+  XCTAssertEqual(7, bytes[4]);
+
+  JSArrayBuffer js_array_buffer_from_object = JSArrayBuffer(static_cast<JSObject>(js_context.JSEvaluateScript("new ArrayBuffer(8)")));
+  XCTAssertEqual(8, js_array_buffer_from_object.GetByteLength());
+  XCTAssertFalse(JSArrayBuffer::IsArrayBuffer(js_context.CreateObject()));
+  XCTAssertFalse(JSArrayBuffer::IsArrayBuffer(static_cast<JSObject>(js_context.JSEvaluateScript("new Uint8Array(8)"))));
+  ASSERT_THROW(JSArrayBuffer(js_context.CreateObject()), std::invalid_argument);
+
+  // An ArrayBuffer of native memory frees it with its deallocator when
+  // its context group goes away.
+  std::vector<std::uint8_t> native_bytes { 1, 2, 3, 4 };
+  void* deallocated_bytes = nullptr;
+  {
+    JSContextGroup native_context_group;
+    JSContext native_context = native_context_group.CreateContext();
+    JSArrayBuffer native_array_buffer = native_context.CreateArrayBuffer(native_bytes.data(), native_bytes.size(), [&deallocated_bytes](void* bytes) {
+      deallocated_bytes = bytes;
+    });
+    XCTAssertEqual(native_bytes.data(), native_array_buffer.GetBytes().data());
+    XCTAssertEqual(4, native_array_buffer.GetByteLength());
+
+    native_context.get_global_object().SetProperty("buffer", native_array_buffer);
+    native_context.JSEvaluateScript("new Uint8Array(buffer)[0] = 9;");
+    XCTAssertEqual(9, native_bytes[0]);
+  }
+  XCTAssertEqual(native_bytes.data(), deallocated_bytes);
+}
+
+TEST_F(JSObjectTests, JSTypedArray) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  JSTypedArray<float> js_floats = js_context.CreateTypedArray<float>(4);
+  XCTAssertEqual(4, js_floats.GetLength());
+  XCTAssertEqual(0, js_floats.GetByteOffset());
+  XCTAssertEqual(16, js_floats.GetBuffer().GetByteLength());
+
+  auto floats = js_floats.GetElements();
+  XCTAssertEqual(4, floats.size());
+  XCTAssertEqual(16, floats.size_bytes());
+  floats[1] = 1.5f;
+  js_context.get_global_object().SetProperty("floats", js_floats);
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("floats instanceof Float32Array && floats[1] === 1.5")));
+  js_context.JSEvaluateScript("floats[2] = 0.25;");
+  XCTAssertEqual(0.25f, floats[2]);
+
+  // A typed array that views part of an ArrayBuffer.
+  JSArrayBuffer js_array_buffer = js_context.CreateArrayBuffer(16);
+  JSTypedArray<int32_t> js_ints = js_context.CreateTypedArray<int32_t>(js_array_buffer, 8, 2);
+  XCTAssertEqual(2, js_ints.GetLength());
+  XCTAssertEqual(8, js_ints.GetByteOffset());
+  js_ints.GetElements()[0] = -1;
+  XCTAssertEqual(0, js_array_buffer.GetBytes()[7]);
+  XCTAssertEqual(0xff, js_array_buffer.GetBytes()[8]);
+  XCTAssertEqual(js_array_buffer.GetBytes().data() + 8, reinterpret_cast<std::uint8_t*>(js_ints.GetElements().data()));
+  ASSERT_THROW(js_context.CreateTypedArray<int32_t>(js_array_buffer, 8, 3), std::runtime_error);
+
+  // A typed array of native memory.
+  std::vector<double> native_doubles { 1, 2, 3 };
+  JSTypedArray<double> js_doubles = js_context.CreateTypedArray(native_doubles.data(), native_doubles.size(), nullptr);
+  XCTAssertEqual(native_doubles.data(), js_doubles.GetElements().data());
+  js_context.get_global_object().SetProperty("doubles", js_doubles);
+  XCTAssertEqual(6, static_cast<double>(js_context.JSEvaluateScript("doubles[0] + doubles[1] + doubles[2]")));
+
+  JSTypedArray<std::uint16_t> js_uint16s(static_cast<JSObject>(js_context.JSEvaluateScript("new Uint16Array([1, 65535])")));
+  XCTAssertEqual(65535, js_uint16s.GetElements()[1]);
+  ASSERT_THROW(JSTypedArray<std::int16_t>(static_cast<JSObject>(js_context.JSEvaluateScript("new Uint16Array(2)"))), std::invalid_argument);
+  ASSERT_THROW(JSTypedArray<double>(js_context.CreateArray()), std::invalid_argument);
+}
+
+TEST_F(JSObjectTests, CreateArrayBufferFromFile) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  const std::string path = "JSObjectTests_CreateArrayBufferFromFile.bin";
+  std::vector<char> contents(10000);
+  for (std::size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<char>(i % 251);
+  }
+  {
+    std::ofstream file(path, std::ios::binary);
+    file.write(contents.data(), contents.size());
+  }
+
+  JSArrayBuffer js_array_buffer = js_context.CreateArrayBufferFromFile(path);
+  XCTAssertEqual(10000, js_array_buffer.GetByteLength());
+  XCTAssertTrue(std::equal(contents.begin(), contents.end(), reinterpret_cast<const char*>(js_array_buffer.GetBytes().data())));
+
+  js_context.get_global_object().SetProperty("buffer", js_array_buffer);
+  XCTAssertEqual(9999 % 251, static_cast<int32_t>(js_context.JSEvaluateScript("new Uint8Array(buffer)[9999]")));
+
+  // A range that doesn't start on a page boundary.
+  JSArrayBuffer js_array_buffer_range = js_context.CreateArrayBufferFromFile(path, 4097, 100);
+  XCTAssertEqual(100, js_array_buffer_range.GetByteLength());
+  XCTAssertEqual(4097 % 251, js_array_buffer_range.GetBytes()[0]);
+  XCTAssertEqual(4196 % 251, js_array_buffer_range.GetBytes()[99]);
+
+  // Writes from JavaScript don't change the file.
+  js_context.get_global_object().SetProperty("range", js_array_buffer_range);
+  js_context.JSEvaluateScript("new Uint8Array(range)[0] = 0xff;");
+  XCTAssertEqual(0xff, js_array_buffer_range.GetBytes()[0]);
+  {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(4097);
+    XCTAssertEqual(4097 % 251, file.get());
+  }
+
+  XCTAssertEqual(0, js_context.CreateArrayBufferFromFile(path, 10000).GetByteLength());
+  ASSERT_THROW(js_context.CreateArrayBufferFromFile(path, 10001), std::invalid_argument);
+  ASSERT_THROW(js_context.CreateArrayBufferFromFile(path, 9000, 1001), std::invalid_argument);
+  ASSERT_THROW(js_context.CreateArrayBufferFromFile(path + ".missing"), std::runtime_error);
+
+  // Where the file can be removed while it is mapped, the mapping
+  // still reads its contents.
+  std::remove(path.c_str());
+  XCTAssertEqual(4096 % 251, js_array_buffer.GetBytes()[4096]);
+}
+
 TEST_F(JSObjectTests, JSDate) {
   JSContext js_context = js_context_group.CreateContext();
   JSDate js_date = js_context.CreateDate();
@@ -560,11 +862,89 @@ TEST_F(JSObjectTests, JSFunctionCallback) {
     global_object.DeleteProperty("testJSFunctionCallback");
   }
 
+  // copies refer to the same JavaScript function
+  {
+    JSFunction js_function = js_context.CreateFunction("greet", callback);
+    std::vector<JSFunction> js_functions(3, js_function);
+
+    global_object.SetProperty("original", js_function);
+    global_object.SetProperty("copy", js_functions.back());
+    XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("original === copy;")));
+    XCTAssertEqual("greet", static_cast<std::string>(js_context.JSEvaluateScript("copy.name;")));
+    XCTAssertEqual("function", static_cast<std::string>(js_context.JSEvaluateScript("typeof copy;")));
+    XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("copy instanceof Function;")));
+    XCTAssertEqual("Hello, call", static_cast<std::string>(js_context.JSEvaluateScript("copy.call(null, 'call');")));
+    global_object.DeleteProperty("original");
+    global_object.DeleteProperty("copy");
+  }
+
   // testing NOOP function
   JSFunction noop_function = js_context.CreateFunction();
   XCTAssertTrue(noop_function(noop_function).IsUndefined());
 }
 
+TEST_F(JSObjectTests, JSFunctionArgumentsCallback) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  std::size_t   size { 0 };
+  JSValue::Type type { JSValue::Type::Undefined };
+  std::string   string;
+  int32_t       int32 { 0 };
+  bool          boolean { false };
+  int32_t       object_x { 0 };
+  bool          past_end_is_undefined { false };
+  bool          past_end_is_nan { false };
+  bool          at_past_end_threw { false };
+  std::size_t   vector_size { 0 };
+
+  JSFunctionArgumentsCallback callback = [&](const JSArguments& arguments, JSObject& this_object) {
+    size                  = arguments.size();
+    type                  = arguments.GetType(1);
+    string                = arguments.GetString(0);
+    int32                 = arguments.GetInt32(1);
+    boolean               = arguments.IsBoolean(2) && arguments.GetBoolean(2);
+    object_x              = static_cast<int32_t>(arguments.GetObject(3).GetProperty("x"));
+    past_end_is_undefined = arguments.IsUndefined(4) && arguments[4].IsUndefined();
+    past_end_is_nan       = std::isnan(arguments.GetNumber(4));
+    try {
+      arguments.at(4);
+    } catch (const std::out_of_range&) {
+      at_past_end_threw = true;
+    }
+    vector_size = arguments.to_vector().size();
+    return arguments.get_context().CreateString(arguments.GetString(0) + ", " + std::to_string(arguments.GetInt32(1)));
+  };
+
+  auto global_object = js_context.get_global_object();
+  JSFunction js_function = js_context.CreateFunction(callback);
+  global_object.SetProperty("testJSFunctionArgumentsCallback", js_function);
+  XCTAssertEqual("Hello, -42", static_cast<std::string>(js_context.JSEvaluateScript("testJSFunctionArgumentsCallback('Hello', -42.5, true, {x: 7});")));
+  global_object.DeleteProperty("testJSFunctionArgumentsCallback");
+
+  XCTAssertEqual(4, size);
+  XCTAssertEqual(JSValue::Type::Number, type);
+  XCTAssertEqual("Hello", string);
+  XCTAssertEqual(-42, int32);
+  XCTAssertTrue(boolean);
+  XCTAssertEqual(7, object_x);
+
+  // Past the end of the arguments is undefined, as in JavaScript.
+  XCTAssertTrue(past_end_is_undefined);
+  XCTAssertTrue(past_end_is_nan);
+  XCTAssertTrue(at_past_end_threw);
+  XCTAssertEqual(4, vector_size);
+
+  // A copy keeps the callback after the source is destroyed.
+  JSFunction js_function_copy = js_context.CreateFunction();
+  {
+    JSFunction js_src_function = js_context.CreateFunction(callback);
+    js_function_copy = js_src_function;
+  }
+  global_object.SetProperty("testJSFunctionArgumentsCallback", js_function_copy);
+  XCTAssertEqual("Hello, -42", static_cast<std::string>(js_context.JSEvaluateScript("testJSFunctionArgumentsCallback('Hello', -42.5, true, {x: 7});")));
+  global_object.DeleteProperty("testJSFunctionArgumentsCallback");
+}
+
 TEST_F(JSObjectTests, JSON_stringify) {
   auto js_context = js_context_group.CreateContext();
   auto global_object = js_context.get_global_object();
@@ -594,3 +974,111 @@ TEST_F(JSObjectTests, JSON_stringify) {
   XCTAssertEqual("[\"Hello\",123,3.141592653589793,true,{}]", static_cast<std::string>(js_result));
 }
 
+
+namespace {
+  std::string JoinStrings(const std::string& lhs, JSString rhs) {
+    return lhs + static_cast<std::string>(rhs);
+  }
+}
+
+TEST_F(JSObjectTests, JSFunctionTypedCallback) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+
+  // The lambda's signature is deduced, and the arguments converted
+  // directly into its parameter types.
+  int32_t call_count { 0 };
+  JSFunction add = js_context.CreateFunction("add", [&call_count](int32_t lhs, double rhs) {
+    ++call_count;
+    return lhs + rhs;
+  });
+  global_object.SetProperty("add", add);
+  XCTAssertEqual(3.5, static_cast<double>(js_context.JSEvaluateScript("add(1.9, '2.5');")));
+  XCTAssertTrue(std::isnan(static_cast<double>(js_context.JSEvaluateScript("add(1);"))));
+  XCTAssertEqual(2, call_count);
+  XCTAssertEqual("add", static_cast<std::string>(js_context.JSEvaluateScript("add.name;")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("add instanceof Function;")));
+  global_object.DeleteProperty("add");
+
+  // A function returning void returns undefined.
+  bool flag { false };
+  JSFunction set_flag = js_context.CreateFunction([&flag](bool value) { flag = value; });
+  global_object.SetProperty("setFlag", set_flag);
+  XCTAssertTrue(js_context.JSEvaluateScript("setFlag(1);").IsUndefined());
+  XCTAssertTrue(flag);
+  global_object.DeleteProperty("setFlag");
+
+  // Function pointers and JSValue/JSObject parameters are supported too.
+  JSFunction join = js_context.CreateFunction(&JoinStrings);
+  global_object.SetProperty("join", join);
+  XCTAssertEqual("foo42", static_cast<std::string>(js_context.JSEvaluateScript("join('foo', 42);")));
+  global_object.DeleteProperty("join");
+
+  JSFunction get_x = js_context.CreateFunction([](JSObject object) { return object.GetProperty("x"); });
+  global_object.SetProperty("getX", get_x);
+  XCTAssertEqual(7, static_cast<int32_t>(js_context.JSEvaluateScript("getX({x: 7});")));
+  
+  // An argument that can't be converted throws a JavaScript exception
+  // instead of escaping the callback as a C++ exception.
+  XCTAssertEqual("caught", static_cast<std::string>(js_context.JSEvaluateScript("try { getX(null); 'not caught'; } catch (e) { e instanceof Error ? 'caught' : 'not an Error'; }")));
+  global_object.DeleteProperty("getX");
+}
+
+TEST_F(JSObjectTests, JSPreparedCall) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  JSObject describe = static_cast<JSObject>(js_context.JSEvaluateScript("(function(a, b, c) { return this.prefix + [typeof a, a, typeof b, b, typeof c, c].join(' '); })"));
+  JSObject this_object = js_context.CreateObject();
+  this_object.SetProperty("prefix", js_context.CreateString("> "));
+
+  JSPreparedCall call(describe, this_object, 3);
+  XCTAssertEqual("> number 1 string foo boolean true", static_cast<std::string>(call.Invoke(1, "foo", true)));
+  XCTAssertEqual("> number 2.5 string bar object ", static_cast<std::string>(call.Invoke(2.5, std::string("bar"), js_context.CreateNull())));
+  XCTAssertEqual("> undefined  undefined  undefined ", static_cast<std::string>(call.Invoke()));
+  XCTAssertEqual("> number 3 string baz undefined ", static_cast<std::string>(call.Apply({ js_context.CreateNumber(3), js_context.CreateString("baz") })));
+
+  // Without a this object the function is called with the global
+  // object.
+  JSObject count = static_cast<JSObject>(js_context.JSEvaluateScript("var counter = 0; (function(step) { this.counter += step; })"));
+  JSPreparedCall increment(count);
+  for (int32_t i = 0; i < 10; ++i) {
+    increment.InvokeDiscardingResult(i);
+  }
+  XCTAssertEqual(45, static_cast<int32_t>(js_context.JSEvaluateScript("counter;")));
+
+  // A JavaScript exception becomes a C++ exception.
+  JSPreparedCall thrower(static_cast<JSObject>(js_context.JSEvaluateScript("(function() { throw new Error('oops'); })")));
+  ASSERT_THROW(thrower.InvokeDiscardingResult(), std::runtime_error);
+
+  ASSERT_THROW(JSPreparedCall(js_context.CreateObject()), std::invalid_argument);
+}
+
+TEST_F(JSObjectTests, CallAndConstruct) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+
+  JSObject add = static_cast<JSObject>(js_context.JSEvaluateScript("(function(a, b) { return a + b; })"));
+  XCTAssertEqual(3, add.Call<int32_t>(global_object, 1, 2));
+  XCTAssertEqual(3.75, add.Call<double>(global_object, 1.25, 2.5));
+  XCTAssertEqual("foo42", add.Call<std::string>(global_object, "foo", 42));
+  XCTAssertEqual("foobar", add.Call<std::string>(global_object, std::string("foo"), JSString("bar")));
+  XCTAssertEqual("foobar", static_cast<std::string>(add.Call(global_object, js_context.CreateString("foo"), "bar")));
+  XCTAssertTrue(add.Call(global_object).IsNumber());
+
+  JSObject this_object = js_context.CreateObject();
+  this_object.SetProperty("x", js_context.CreateNumber(7));
+  JSObject get_x = static_cast<JSObject>(js_context.JSEvaluateScript("(function() { return this.x; })"));
+  XCTAssertEqual(7, get_x.Call<int32_t>(this_object));
+  JSObject make_object = static_cast<JSObject>(js_context.JSEvaluateScript("(function(a) { return { a: a }; })"));
+  XCTAssertTrue(make_object.Call<JSObject>(global_object, true).GetProperty("a").IsBoolean());
+
+  JSObject point = static_cast<JSObject>(js_context.JSEvaluateScript("(function Point(x, y) { this.x = x; this.y = y; })"));
+  JSObject p = point.Construct(3, 4.5);
+  XCTAssertEqual(3, static_cast<int32_t>(p.GetProperty("x")));
+  XCTAssertEqual(4.5, static_cast<double>(p.GetProperty("y")));
+
+  JSObject thrower = static_cast<JSObject>(js_context.JSEvaluateScript("(function() { throw new Error('oops'); })"));
+  ASSERT_THROW(thrower.Call<void>(global_object), std::runtime_error);
+  ASSERT_THROW(this_object.Call(global_object, 1), std::runtime_error);
+  ASSERT_THROW(this_object.Construct(), std::runtime_error);
+}
@@ -74,6 +74,11 @@ TEST(JSStringTests, StdString) {
   std::string string2 { "hello, std::string" };
   XCTAssertEqual("hello, std::string", static_cast<std::string>(JSString(string2)));
 
+  // The whole std::string is used, including embedded NULs.
+  const std::string string3 { "hello\0world", 11 };
+  XCTAssertEqual(11, JSString(string3).length());
+  XCTAssertEqual(string3, static_cast<std::string>(JSString(string3)));
+
   // No implicit conversions.
   //XCTAssertEqual(std::string("hello, std::string"), JSString(string2));
 }
@@ -101,3 +106,98 @@ TEST(JSStringTests, UTF8) {
   XCTAssertEqual("spät", static_cast<std::string>(string2));
 }
 
+
+TEST(JSStringTests, Hash) {
+  JSString string1 { "spät" };
+  JSString string2 = JSString(static_cast<JSStringRef>(string1));
+  JSString string3 { "spat" };
+  XCTAssertEqual(string1.hash_value(), string2.hash_value());
+  XCTAssertEqual(std::hash<JSString>()(string1), std::hash<JSString>()(string2));
+  XCTAssertNotEqual(string1.hash_value(), string3.hash_value());
+  
+  // The UTF-8 copy is made on demand and is shared by copies.
+  JSString string4 = string1;
+  XCTAssertEqual("spät", static_cast<std::string>(string4));
+  XCTAssertEqual("spät", static_cast<std::string>(string1));
+  
+  XCTAssertEqual(sizeof(JSStringRef) + sizeof(std::shared_ptr<void>), sizeof(JSString));
+}
+
+TEST(JSStringTests, UTF16) {
+  const std::u16string u16 { u"spät 日本" };
+  JSString string1 { u16 };
+  XCTAssertEqual(u16.size(), string1.length());
+  XCTAssertEqual(u16, static_cast<std::u16string>(string1));
+  XCTAssertEqual("sp\xc3\xa4t \xe6\x97\xa5\xe6\x9c\xac", string1.utf8());
+  XCTAssertEqual(0, u16.compare(0, u16.size(), string1.u16data(), string1.length()));
+  
+  JSString string2 { u"spät 日本" };
+  XCTAssertEqual(string1, string2);
+  
+  JSString string3 { u16.data(), 4 };
+  XCTAssertEqual(JSString("spät"), string3);
+  
+  // The UTF-8 view is shared by copies.
+  JSString string4 = string1;
+  XCTAssertEqual(&string1.utf8(), &string4.utf8());
+}
+
+TEST(JSStringTests, Transcoder) {
+  // Long enough to cross the vectorized ASCII blocks, with non-ASCII
+  // characters landing at different offsets within a block.
+  std::string ascii;
+  for (int i = 0; i < 100; ++i) {
+    ascii += static_cast<char>('a' + i % 26);
+  }
+  JSString string1 { ascii };
+  XCTAssertEqual(ascii.size(), string1.length());
+  XCTAssertEqual(ascii, static_cast<std::string>(string1));
+  
+  for (std::size_t offset : { 0, 15, 16, 31, 32, 63, 99 }) {
+    std::string mixed = ascii;
+    mixed.replace(offset, 1, "\xc3\xa4");
+    JSString string2 { mixed };
+    XCTAssertEqual(ascii.size(), string2.length());
+    XCTAssertEqual(u'ä', string2.u16data()[offset]);
+    XCTAssertEqual(mixed, static_cast<std::string>(string2));
+  }
+  
+  // Characters outside the BMP become surrogate pairs.
+  const std::string emoji { "x\xf0\x9f\x98\x80y" };
+  JSString string3 { emoji };
+  XCTAssertEqual(4, string3.length());
+  XCTAssertEqual(emoji, static_cast<std::string>(string3));
+  
+  // An unpaired surrogate becomes U+FFFD.
+  const char16_t unpaired[] { u'a', 0xd800, u'b' };
+  JSString string4 { unpaired, 3 };
+  XCTAssertEqual("a\xef\xbf\xbd" "b", static_cast<std::string>(string4));
+
+  // Embedded NULs are kept, in ASCII and Latin-1 alike.
+  const std::string nul { "a\0b\xc3\xa4", 5 };
+  JSString string5 { nul };
+  XCTAssertEqual(4, string5.length());
+  XCTAssertEqual(nul, static_cast<std::string>(string5));
+
+  // Strings longer than the stack buffers.
+  std::string latin1;
+  for (int i = 0; i < 1000; ++i) {
+    latin1 += i % 7 ? "x" : "\xc3\xa9";
+  }
+  JSString string6 { latin1 };
+  XCTAssertEqual(1000, string6.length());
+  XCTAssertEqual(latin1, static_cast<std::string>(string6));
+  JSString string7 { latin1 + "\xe6\x97\xa5" };
+  XCTAssertEqual(1001, string7.length());
+  XCTAssertEqual(latin1 + "\xe6\x97\xa5", static_cast<std::string>(string7));
+
+  // Invalid UTF-8 produces an empty string.
+  XCTAssertEqual(0, JSString("abc\xff").length());
+  XCTAssertEqual(0, JSString("\xc0\x80").length());
+  
+  JSContextGroup js_context_group;
+  JSContext js_context = js_context_group.CreateContext();
+  const std::string cjk { "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e " + ascii };
+  JSValue js_value = js_context.CreateString(cjk);
+  XCTAssertEqual(cjk, static_cast<std::string>(js_value));
+}
@@ -7,6 +7,11 @@
  */
 
 #include "HAL/HAL.hpp"
+#include "HAL/detail/JSHandleRegistry.hpp"
+
+#include <cstdint>
+#include <map>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -300,3 +305,216 @@ TEST_F(JSValueTests, JSON_Stringify) {
   js_result = js_context.JSEvaluateScript("JSON.stringify(js_string);");
   XCTAssertEqual("\"Hello, World\"", static_cast<std::string>(js_result));
 }
+
+TEST_F(JSValueTests, Move) {
+  JSContext js_context = js_context_group.CreateContext();
+  
+  std::vector<JSValue>  js_value_sources;
+  std::vector<JSObject> js_object_sources;
+  std::vector<JSString> js_string_sources;
+  for (int i = 0; i < 100; ++i) {
+    js_value_sources.push_back(js_context.CreateNumber(i));
+    js_object_sources.push_back(js_context.CreateObject());
+    js_string_sources.push_back(JSString(std::to_string(i)));
+  }
+  
+  // Grow the vectors one element at a time so that they reallocate.
+  std::vector<JSValue>  js_values;
+  std::vector<JSObject> js_objects;
+  std::vector<JSString> js_strings;
+  for (int i = 0; i < 100; ++i) {
+    js_values.push_back(std::move(js_value_sources[i]));
+    js_objects.push_back(std::move(js_object_sources[i]));
+    js_strings.push_back(std::move(js_string_sources[i]));
+  }
+  
+  std::vector<JSValue> js_values_2 = std::move(js_values);
+  std::swap(js_values_2[0], js_values_2[1]);
+  JSContext js_context_2 = std::move(js_context);
+  
+  // Moving transfers the references, so the moved-from wrappers are
+  // empty and each handle is still held exactly once.
+  for (int i = 0; i < 100; ++i) {
+    XCTAssertTrue(static_cast<JSValueRef>(js_value_sources[i]) == nullptr);
+    XCTAssertTrue(static_cast<JSObjectRef>(js_object_sources[i]) == nullptr);
+    XCTAssertTrue(static_cast<JSStringRef>(js_string_sources[i]) == nullptr);
+    XCTAssertEqual(1u, JSValue::GetReferenceCount(static_cast<JSValueRef>(js_values_2[i])));
+    XCTAssertEqual(1u, JSObject::GetReferenceCount(static_cast<JSObjectRef>(js_objects[i])));
+  }
+  
+  XCTAssertEqual(1, static_cast<int32_t>(js_values_2[0]));
+  XCTAssertEqual(0, static_cast<int32_t>(js_values_2[1]));
+  XCTAssertEqual("99", static_cast<std::string>(js_strings[99]));
+  
+  // Moved-from wrappers can be assigned to and destroyed.
+  JSValue js_value = js_context_2.CreateString("foo");
+  JSValue js_value_3 = std::move(js_value);
+  js_value = js_context_2.CreateString("bar");
+  XCTAssertEqual("foo", static_cast<std::string>(js_value_3));
+  XCTAssertEqual("bar", static_cast<std::string>(js_value));
+  
+  js_context = js_context_2;
+  XCTAssertEqual(js_context, js_context_2);
+}
+
+TEST_F(JSValueTests, HandleScope) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSValue escaped = js_context.CreateUndefined();
+  
+  {
+    HandleScope handle_scope(js_context);
+    
+    Local<JSObject> array = handle_scope.CreateArray();
+    for (uint32_t i = 0; i < 1000; ++i) {
+      array.SetProperty(i, handle_scope.CreateNumber(i));
+    }
+    
+    double sum = 0;
+    const auto length = static_cast<uint32_t>(array.GetProperty(JSPropertyKey::Length()));
+    for (uint32_t i = 0; i < length; ++i) {
+      Local<JSValue> element = array.GetProperty(i);
+      XCTAssertTrue(element.IsNumber());
+      sum += static_cast<double>(element);
+    }
+    XCTAssertEqual(1000u, length);
+    XCTAssertEqual(499500, sum);
+    
+    Local<JSObject> object = handle_scope.CreateObject();
+    object.SetProperty(JSString("name"), handle_scope.CreateString("foo"));
+    XCTAssertTrue(object.HasProperty(JSString("name")));
+    XCTAssertEqual("foo", static_cast<std::string>(object.GetProperty(JSString("name"))));
+    
+    // Locals are not protected from garbage collection.
+    XCTAssertEqual(0u, JSObject::GetReferenceCount(static_cast<JSObjectRef>(array)));
+    XCTAssertEqual(0u, JSObject::GetReferenceCount(static_cast<JSObjectRef>(object)));
+    
+    // Only escaping the value protects it.
+    escaped = static_cast<Local<JSValue>>(object);
+  }
+  
+  XCTAssertTrue(escaped.IsObject());
+  XCTAssertEqual(1u, JSValue::GetReferenceCount(static_cast<JSValueRef>(escaped)));
+  XCTAssertEqual("foo", static_cast<std::string>(static_cast<JSObject>(escaped).GetProperty("name")));
+}
+
+namespace {
+  
+  const void* MakeHandle(std::uintptr_t value) {
+    return reinterpret_cast<const void*>(value);
+  }
+  
+} // namespace {
+
+TEST(JSHandleRegistryTests, Collisions) {
+  detail::JSHandleRegistry registry;
+  XCTAssertEqual(0u, registry.GetCount(MakeHandle(0x1000)));
+  
+  // The first handle allocates the table, which fixes the home cell
+  // of every other handle as long as the table doesn't grow.
+  const void* first = MakeHandle(0x1000);
+  XCTAssertEqual(1u, registry.Retain(first));
+  const std::size_t last = registry.capacity() - 1;
+  
+  // Handles whose home is the last cell, so that their probe sequence
+  // wraps around the end of the table, and one whose home is cell 0,
+  // which the wrapped handles displace.
+  std::vector<const void*> colliding;
+  const void* home_zero = nullptr;
+  for (std::uintptr_t value = 0x2000; colliding.size() < 3 || !home_zero; value += 8) {
+    const void* handle = MakeHandle(value);
+    const std::size_t home = registry.Hash(handle);
+    if (home == last && colliding.size() < 3) {
+      colliding.push_back(handle);
+    } else if (home == 0 && !home_zero) {
+      home_zero = handle;
+    }
+  }
+  
+  int contexts[3];
+  for (std::size_t i = 0; i < colliding.size(); ++i) {
+    XCTAssertEqual(1u, registry.Retain(colliding[i], &contexts[i]));
+  }
+  XCTAssertEqual(1u, registry.Retain(home_zero));
+  XCTAssertEqual(2u, registry.Retain(colliding[1]));
+  XCTAssertEqual(5u, registry.size());
+  XCTAssertEqual(last + 1, registry.capacity());
+  
+  // Releasing the head of the wrapped probe sequence must shift the
+  // rest of it back across the end of the table.
+  std::size_t count { 0 };
+  const void* context { nullptr };
+  XCTAssertTrue(registry.Release(colliding[0], count, context));
+  XCTAssertEqual(0u, count);
+  XCTAssertEqual(&contexts[0], context);
+  XCTAssertEqual(4u, registry.size());
+  XCTAssertEqual(0u, registry.GetCount(colliding[0]));
+  XCTAssertEqual(2u, registry.GetCount(colliding[1]));
+  XCTAssertEqual(1u, registry.GetCount(colliding[2]));
+  XCTAssertEqual(1u, registry.GetCount(home_zero));
+  XCTAssertEqual(&contexts[2], registry.FindContext(colliding[2]));
+  
+  XCTAssertTrue(registry.Release(colliding[1], count, context));
+  XCTAssertEqual(1u, count);
+  XCTAssertEqual(4u, registry.size());
+  
+  XCTAssertTrue(registry.Release(home_zero, count, context));
+  XCTAssertEqual(0u, count);
+  XCTAssertEqual(3u, registry.size());
+  XCTAssertEqual(1u, registry.GetCount(colliding[1]));
+  XCTAssertEqual(1u, registry.GetCount(colliding[2]));
+  
+  XCTAssertTrue(registry.Release(colliding[2], count, context));
+  XCTAssertTrue(registry.Release(colliding[1], count, context));
+  XCTAssertEqual(0u, count);
+  XCTAssertEqual(&contexts[1], context);
+  XCTAssertEqual(1u, registry.size());
+  
+  // Releasing a handle that isn't registered leaves count and context
+  // unchanged.
+  count   = 42;
+  context = first;
+  XCTAssertFalse(registry.Release(colliding[1], count, context));
+  XCTAssertEqual(42u, count);
+  XCTAssertEqual(first, context);
+  XCTAssertEqual(1u, registry.GetCount(first));
+}
+
+TEST(JSHandleRegistryTests, GrowAndRelease) {
+  detail::JSHandleRegistry registry;
+  std::map<const void*, std::size_t> expected;
+  
+  // Handles that differ only in their high bits, like the tagged
+  // immediates of doubles, and handles that differ only in their low
+  // bits, like integers and heap pointers.
+  std::vector<const void*> handles;
+  for (std::uintptr_t i = 1; i <= 500; ++i) {
+    handles.push_back(MakeHandle(i));
+    handles.push_back(MakeHandle(static_cast<std::uintptr_t>(static_cast<std::uint64_t>(i) << 40)));
+  }
+  
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    for (std::size_t j = 0; j <= i % 3; ++j) {
+      XCTAssertEqual(++expected[handles[i]], registry.Retain(handles[i]));
+    }
+  }
+  XCTAssertEqual(expected.size(), registry.size());
+  XCTAssertTrue(registry.size() * 2 <= registry.capacity());
+  
+  // Release every handle once, visiting them in a scattered order.
+  for (std::size_t i = 0; i < handles.size(); ++i) {
+    const void* handle = handles[i * 7 % handles.size()];
+    std::size_t count { 0 };
+    const void* context { nullptr };
+    XCTAssertTrue(registry.Release(handle, count, context));
+    XCTAssertEqual(--expected[handle], count);
+    if (count == 0) {
+      expected.erase(handle);
+    }
+  }
+  
+  XCTAssertEqual(expected.size(), registry.size());
+  for (const auto handle : handles) {
+    const auto position = expected.find(handle);
+    XCTAssertEqual(position == expected.end() ? 0 : position->second, registry.GetCount(handle));
+  }
+}